@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "action.h"
+#include "arena.h"
 #include "plugin-api/action.h"
 #include "actions/internal.h"
 
@@ -34,12 +35,15 @@ zathura_error_t zathura_action_new(zathura_action_t** action, zathura_action_typ
       return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  *action = calloc(1, sizeof(**action));
+  zathura_arena_t* arena = zathura_arena_get_current();
+
+  *action = zathura_arena_calloc(arena, sizeof(**action));
   if (*action == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
   (*action)->type = type;
+  (*action)->arena = arena;
 
   /* Initialize sub types */
   zathura_error_t error = ZATHURA_ERROR_OK;
@@ -96,7 +100,7 @@ zathura_error_t zathura_action_new(zathura_action_t** action, zathura_action_typ
   }
 
   if (error != ZATHURA_ERROR_OK) {
-    free(*action);
+    zathura_arena_release(arena, *action);
     return error;
   }
 
@@ -164,7 +168,7 @@ zathura_action_free(zathura_action_t* action)
       break;
   }
 
-  free(action);
+  zathura_arena_release(action->arena, action);
 
   if (error != ZATHURA_ERROR_OK) {
       return error;
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-goto-3d-view.h"
@@ -28,10 +29,10 @@ zathura_action_goto_3d_view_init(zathura_action_t* action)
   ACTION_GOTO_3D_VIEW_CHECK_TYPE()
 
   if (action->data.goto_3d_view_dest != NULL) {
-    free(action->data.goto_3d_view_dest);
+    zathura_arena_release(action->arena, action->data.goto_3d_view_dest);
   }
 
-  action->data.goto_3d_view_dest = calloc(1, sizeof(zathura_action_goto_3d_view_t));
+  action->data.goto_3d_view_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_goto_3d_view_t));
   if (action->data.goto_3d_view_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -48,7 +49,7 @@ zathura_action_goto_3d_view_clear(zathura_action_t* action)
 
   ACTION_GOTO_3D_VIEW_CHECK_TYPE()
 
-  free(action->data.goto_3d_view_dest);
+  zathura_arena_release(action->arena, action->data.goto_3d_view_dest);
   action->data.goto_3d_view_dest = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-goto.h"
@@ -27,10 +28,10 @@ zathura_action_goto_init(zathura_action_t* action)
   ACTION_GOTO_CHECK_TYPE()
 
   if (action->data.goto_dest != NULL) {
-    free(action->data.goto_dest);
+    zathura_arena_release(action->arena, action->data.goto_dest);
   }
 
-  action->data.goto_dest = calloc(1, sizeof(zathura_action_goto_t));
+  action->data.goto_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_goto_t));
   if (action->data.goto_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_goto_clear(zathura_action_t* action)
 
   ACTION_GOTO_CHECK_TYPE()
 
-  free(action->data.goto_dest);
+  zathura_arena_release(action->arena, action->data.goto_dest);
   action->data.goto_dest = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-hide-annotations.h"
@@ -27,10 +28,10 @@ zathura_action_hide_annotations_init(zathura_action_t* action)
   ACTION_HIDE_ANNOTATIONS_CHECK_TYPE()
 
   if (action->data.hide_annotations_dest != NULL) {
-    free(action->data.hide_annotations_dest);
+    zathura_arena_release(action->arena, action->data.hide_annotations_dest);
   }
 
-  action->data.hide_annotations_dest = calloc(1, sizeof(zathura_action_hide_annotations_t));
+  action->data.hide_annotations_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_hide_annotations_t));
   if (action->data.hide_annotations_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_hide_annotations_clear(zathura_action_t* action)
 
   ACTION_HIDE_ANNOTATIONS_CHECK_TYPE()
 
-  free(action->data.hide_annotations_dest);
+  zathura_arena_release(action->arena, action->data.hide_annotations_dest);
   action->data.hide_annotations_dest = NULL;
 
   return ZATHURA_ERROR_OK;
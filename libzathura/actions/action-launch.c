@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-launch.h"
@@ -27,10 +28,10 @@ zathura_action_launch_init(zathura_action_t* action)
   ACTION_LAUNCH_CHECK_TYPE()
 
   if (action->data.launch_dest != NULL) {
-    free(action->data.launch_dest);
+    zathura_arena_release(action->arena, action->data.launch_dest);
   }
 
-  action->data.launch_dest = calloc(1, sizeof(zathura_action_launch_t));
+  action->data.launch_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_launch_t));
   if (action->data.launch_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_launch_clear(zathura_action_t* action)
 
   ACTION_LAUNCH_CHECK_TYPE()
 
-  free(action->data.launch_dest);
+  zathura_arena_release(action->arena, action->data.launch_dest);
   action->data.launch_dest = NULL;
 
   return ZATHURA_ERROR_OK;
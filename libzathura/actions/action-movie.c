@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-movie.h"
@@ -27,10 +28,10 @@ zathura_action_movie_init(zathura_action_t* action)
   ACTION_MOVIE_CHECK_TYPE()
 
   if (action->data.movie_dest != NULL) {
-    free(action->data.movie_dest);
+    zathura_arena_release(action->arena, action->data.movie_dest);
   }
 
-  action->data.movie_dest = calloc(1, sizeof(zathura_action_movie_t));
+  action->data.movie_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_movie_t));
   if (action->data.movie_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_movie_clear(zathura_action_t* action)
 
   ACTION_MOVIE_CHECK_TYPE()
 
-  free(action->data.movie_dest);
+  zathura_arena_release(action->arena, action->data.movie_dest);
   action->data.movie_dest = NULL;
 
   return ZATHURA_ERROR_OK;
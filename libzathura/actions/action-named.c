@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-named.h"
@@ -27,10 +28,10 @@ zathura_action_named_init(zathura_action_t* action)
   ACTION_NAMED_CHECK_TYPE()
 
   if (action->data.named_dest != NULL) {
-    free(action->data.named_dest);
+    zathura_arena_release(action->arena, action->data.named_dest);
   }
 
-  action->data.named_dest = calloc(1, sizeof(zathura_action_named_t));
+  action->data.named_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_named_t));
   if (action->data.named_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_named_clear(zathura_action_t* action)
 
   ACTION_NAMED_CHECK_TYPE()
 
-  free(action->data.named_dest);
+  zathura_arena_release(action->arena, action->data.named_dest);
   action->data.named_dest = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-rendition.h"
@@ -27,10 +28,10 @@ zathura_action_rendition_init(zathura_action_t* action)
   ACTION_RENDITION_CHECK_TYPE()
 
   if (action->data.rendition_dest != NULL) {
-    free(action->data.rendition_dest);
+    zathura_arena_release(action->arena, action->data.rendition_dest);
   }
 
-  action->data.rendition_dest = calloc(1, sizeof(zathura_action_rendition_t));
+  action->data.rendition_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_rendition_t));
   if (action->data.rendition_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_rendition_clear(zathura_action_t* action)
 
   ACTION_RENDITION_CHECK_TYPE()
 
-  free(action->data.rendition_dest);
+  zathura_arena_release(action->arena, action->data.rendition_dest);
   action->data.rendition_dest = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-set-ocg-state.h"
@@ -27,10 +28,10 @@ zathura_action_set_ocg_state_init(zathura_action_t* action)
   ACTION_SET_OCG_STATE_CHECK_TYPE()
 
   if (action->data.set_ocg_state_dest != NULL) {
-    free(action->data.set_ocg_state_dest);
+    zathura_arena_release(action->arena, action->data.set_ocg_state_dest);
   }
 
-  action->data.set_ocg_state_dest = calloc(1, sizeof(zathura_action_set_ocg_state_t));
+  action->data.set_ocg_state_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_set_ocg_state_t));
   if (action->data.set_ocg_state_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_set_ocg_state_clear(zathura_action_t* action)
 
   ACTION_SET_OCG_STATE_CHECK_TYPE()
 
-  free(action->data.set_ocg_state_dest);
+  zathura_arena_release(action->arena, action->data.set_ocg_state_dest);
   action->data.set_ocg_state_dest = NULL;
 
   return ZATHURA_ERROR_OK;
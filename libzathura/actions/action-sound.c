@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-sound.h"
@@ -27,10 +28,10 @@ zathura_action_sound_init(zathura_action_t* action)
   ACTION_SOUND_CHECK_TYPE()
 
   if (action->data.sound_dest != NULL) {
-    free(action->data.sound_dest);
+    zathura_arena_release(action->arena, action->data.sound_dest);
   }
 
-  action->data.sound_dest = calloc(1, sizeof(zathura_action_sound_t));
+  action->data.sound_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_sound_t));
   if (action->data.sound_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_sound_clear(zathura_action_t* action)
 
   ACTION_SOUND_CHECK_TYPE()
 
-  free(action->data.sound_dest);
+  zathura_arena_release(action->arena, action->data.sound_dest);
   action->data.sound_dest = NULL;
 
   return ZATHURA_ERROR_OK;
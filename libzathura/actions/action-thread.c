@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-thread.h"
@@ -27,10 +28,10 @@ zathura_action_thread_init(zathura_action_t* action)
   ACTION_THREAD_CHECK_TYPE()
 
   if (action->data.thread_dest != NULL) {
-    free(action->data.thread_dest);
+    zathura_arena_release(action->arena, action->data.thread_dest);
   }
 
-  action->data.thread_dest = calloc(1, sizeof(zathura_action_thread_t));
+  action->data.thread_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_thread_t));
   if (action->data.thread_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_thread_clear(zathura_action_t* action)
 
   ACTION_THREAD_CHECK_TYPE()
 
-  free(action->data.thread_dest);
+  zathura_arena_release(action->arena, action->data.thread_dest);
   action->data.thread_dest = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-transition.h"
@@ -27,10 +28,10 @@ zathura_action_transition_init(zathura_action_t* action)
   ACTION_TRANSITION_CHECK_TYPE()
 
   if (action->data.transition_dest != NULL) {
-    free(action->data.transition_dest);
+    zathura_arena_release(action->arena, action->data.transition_dest);
   }
 
-  action->data.transition_dest = calloc(1, sizeof(zathura_action_transition_t));
+  action->data.transition_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_transition_t));
   if (action->data.transition_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_transition_clear(zathura_action_t* action)
 
   ACTION_TRANSITION_CHECK_TYPE()
 
-  free(action->data.transition_dest);
+  zathura_arena_release(action->arena, action->data.transition_dest);
   action->data.transition_dest = NULL;
 
   return ZATHURA_ERROR_OK;
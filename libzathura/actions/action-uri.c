@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../action.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "action-uri.h"
@@ -27,10 +28,10 @@ zathura_action_uri_init(zathura_action_t* action)
   ACTION_URI_CHECK_TYPE()
 
   if (action->data.uri_dest != NULL) {
-    free(action->data.uri_dest);
+    zathura_arena_release(action->arena, action->data.uri_dest);
   }
 
-  action->data.uri_dest = calloc(1, sizeof(zathura_action_uri_t));
+  action->data.uri_dest = zathura_arena_calloc(action->arena, sizeof(zathura_action_uri_t));
   if (action->data.uri_dest == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -47,7 +48,7 @@ zathura_action_uri_clear(zathura_action_t* action)
 
   ACTION_URI_CHECK_TYPE()
 
-  free(action->data.uri_dest);
+  zathura_arena_release(action->arena, action->data.uri_dest);
   action->data.uri_dest = NULL;
 
   return ZATHURA_ERROR_OK;
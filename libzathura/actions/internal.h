@@ -26,6 +26,7 @@ extern "C" {
 
 struct zathura_action_s {
   zathura_action_type_t type;
+  struct zathura_arena_s* arena;
 
   union {
     struct zathura_action_goto_s* goto_dest;
@@ -5,6 +5,7 @@
 #include <stdio.h>
 
 #include "annotations.h"
+#include "arena.h"
 #include "annotations/internal.h"
 #include "internal.h"
 
@@ -24,13 +25,16 @@ zathura_annotation_new(zathura_page_t* page, zathura_annotation_t** annotation,
   }
 
   /* Create annotation */
-  *annotation = calloc(1, sizeof(**annotation));
+  zathura_arena_t* arena = zathura_arena_get_current();
+
+  *annotation = zathura_arena_calloc(arena, sizeof(**annotation));
   if (*annotation == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
   /* Save page */
   (*annotation)->page = page;
+  (*annotation)->arena = arena;
 
   /* Initialize defaults */
   (*annotation)->has_appearance_stream = false;
@@ -67,7 +71,7 @@ zathura_annotation_new(zathura_page_t* page, zathura_annotation_t** annotation,
       case ZATHURA_ANNOTATION_3D:
       break;
     default:
-      free(*annotation);
+      zathura_arena_release(arena, *annotation);
       return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
@@ -153,7 +157,7 @@ zathura_annotation_new(zathura_page_t* page, zathura_annotation_t** annotation,
   }
 
   if (error != ZATHURA_ERROR_OK) {
-    free(*annotation);
+    zathura_arena_release(arena, *annotation);
     return error;
   }
 
@@ -257,7 +261,7 @@ zathura_annotation_free(zathura_annotation_t* annotation)
     free(annotation->content);
   }
 
-  free(annotation);
+  zathura_arena_release(annotation->arena, annotation);
 
   if (error != ZATHURA_ERROR_OK) {
     return error;
@@ -288,6 +292,8 @@ zathura_annotation_set_position(zathura_annotation_t* annotation,
 
   annotation->position = position;
 
+  zathura_page_content_changed(annotation->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -318,6 +324,8 @@ zathura_annotation_set_content(zathura_annotation_t* annotation,
 
   annotation->content = g_strdup(content);
 
+  zathura_page_content_changed(annotation->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -400,6 +408,8 @@ zathura_annotation_set_flags(zathura_annotation_t* annotation,
 
   annotation->flags = flags;
 
+  zathura_page_content_changed(annotation->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -426,6 +436,8 @@ zathura_annotation_set_color(zathura_annotation_t* annotation,
 
   annotation->color = color;
 
+  zathura_page_content_changed(annotation->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -452,6 +464,8 @@ zathura_annotation_set_blend_mode(zathura_annotation_t* annotation,
 
   annotation->blend_mode = blend_mode;
 
+  zathura_page_content_changed(annotation->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -478,6 +492,8 @@ zathura_annotation_set_opacity(zathura_annotation_t* annotation,
 
   annotation->opacity = opacity;
 
+  zathura_page_content_changed(annotation->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -572,7 +588,46 @@ zathura_annotation_render(zathura_annotation_t* annotation,
 
   CHECK_IF_IMPLEMENTED(annotation, annotation_render)
 
-  return annotation->page->document->plugin->functions.annotation_render(annotation, buffer, scale);
+  zathura_document_t* document = annotation->page->document;
+
+  const bool serialize = zathura_page_should_serialize_render(annotation->page);
+  if (serialize == true) {
+    zathura_document_lock(document);
+  }
+
+  zathura_error_t error = document->plugin->functions.annotation_render(annotation, buffer, scale);
+
+  if (serialize == true) {
+    zathura_document_unlock(document);
+  }
+
+  return error;
+}
+
+zathura_error_t
+zathura_annotation_render_into(zathura_annotation_t* annotation,
+    zathura_image_buffer_t* buffer, double scale, int x, int y)
+{
+  if (annotation == NULL || buffer == NULL || scale <= 0.0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  CHECK_IF_IMPLEMENTED(annotation, annotation_render_into)
+
+  zathura_document_t* document = annotation->page->document;
+
+  const bool serialize = zathura_page_should_serialize_render(annotation->page);
+  if (serialize == true) {
+    zathura_document_lock(document);
+  }
+
+  zathura_error_t error = document->plugin->functions.annotation_render_into(annotation, buffer, scale, x, y);
+
+  if (serialize == true) {
+    zathura_document_unlock(document);
+  }
+
+  return error;
 }
 
 zathura_error_t
@@ -585,5 +640,18 @@ zathura_annotation_render_cairo(zathura_annotation_t* annotation, cairo_t*
 
   CHECK_IF_IMPLEMENTED(annotation, annotation_render_cairo)
 
-  return annotation->page->document->plugin->functions.annotation_render_cairo(annotation, cairo, scale);
+  zathura_document_t* document = annotation->page->document;
+
+  const bool serialize = zathura_page_should_serialize_render(annotation->page);
+  if (serialize == true) {
+    zathura_document_lock(document);
+  }
+
+  zathura_error_t error = document->plugin->functions.annotation_render_cairo(annotation, cairo, scale);
+
+  if (serialize == true) {
+    zathura_document_unlock(document);
+  }
+
+  return error;
 }
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 
 #include "annotation-3d.h"
+#include "../arena.h"
 #include "internal.h"
 #include "internal/annotation-3d.h"
 
@@ -31,11 +32,11 @@ zathura_annotation_3d_init(zathura_annotation_t* annotation)
   ANNOTATION_3D_CHECK_TYPE()
 
   if (annotation->data.d3d != NULL) {
-    free(annotation->data.d3d);
+    zathura_arena_release(annotation->arena, annotation->data.d3d);
     annotation->data.d3d = NULL;
   }
 
-  annotation->data.d3d = calloc(1, sizeof(zathura_annotation_3d_t));
+  annotation->data.d3d = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_3d_t));
   if (annotation->data.d3d == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -53,7 +54,7 @@ zathura_annotation_3d_clear(zathura_annotation_t* annotation)
   ANNOTATION_3D_CHECK_TYPE()
 
   if (annotation->data.d3d != NULL) {
-    free(annotation->data.d3d);
+    zathura_arena_release(annotation->arena, annotation->data.d3d);
     annotation->data.d3d = NULL;
   }
 
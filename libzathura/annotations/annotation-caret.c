@@ -5,6 +5,7 @@
 
 #include "annotation-caret.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_CARET_CHECK_TYPE() \
@@ -31,10 +32,10 @@ zathura_annotation_caret_init(zathura_annotation_t* annotation)
   ANNOTATION_CARET_CHECK_TYPE()
 
   if (annotation->data.caret != NULL) {
-    free(annotation->data.caret);
+    zathura_arena_release(annotation->arena, annotation->data.caret);
   }
 
-  annotation->data.caret = calloc(1, sizeof(zathura_annotation_caret_t));
+  annotation->data.caret = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_caret_t));
   if (annotation->data.caret == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -58,7 +59,7 @@ zathura_annotation_caret_clear(zathura_annotation_t* annotation)
 
   ANNOTATION_CARET_CHECK_TYPE()
 
-  free(annotation->data.caret);
+  zathura_arena_release(annotation->arena, annotation->data.caret);
   annotation->data.caret = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -5,6 +5,7 @@
 #include "annotation-file-attachment.h"
 #include "../attachment.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "internal.h"
@@ -33,11 +34,11 @@ zathura_annotation_file_init(zathura_annotation_t* annotation)
   ANNOTATION_FILE_CHECK_TYPE()
 
   if (annotation->data.file != NULL) {
-    free(annotation->data.file);
+    zathura_arena_release(annotation->arena, annotation->data.file);
     annotation->data.file = NULL;
   }
 
-  annotation->data.file = calloc(1, sizeof(zathura_annotation_file_t));
+  annotation->data.file = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_file_t));
   if (annotation->data.file == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -62,7 +63,7 @@ zathura_annotation_file_clear(zathura_annotation_t* annotation)
     g_free(annotation->data.file->icon_name);
   }
 
-  free(annotation->data.file);
+  zathura_arena_release(annotation->arena, annotation->data.file);
   annotation->data.file = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "../annotations.h"
+#include "../arena.h"
 #include "../macros.h"
 #include "annotation-free-text.h"
 #include "annotation-markup.h"
@@ -36,11 +37,11 @@ zathura_annotation_free_text_init(zathura_annotation_t* annotation)
   ANNOTATION_FREE_TEXT_CHECK_TYPE()
 
   if (annotation->data.free_text != NULL) {
-    free(annotation->data.free_text);
+    zathura_arena_release(annotation->arena, annotation->data.free_text);
     annotation->data.free_text = NULL;
   }
 
-  annotation->data.free_text = calloc(1, sizeof(zathura_annotation_free_text_t));
+  annotation->data.free_text = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_free_text_t));
   if (annotation->data.free_text == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -67,7 +68,7 @@ zathura_annotation_free_text_clear(zathura_annotation_t* annotation)
     free(annotation->data.free_text->style_string);
     annotation->data.free_text->style_string = NULL;
 
-    free(annotation->data.free_text);
+    zathura_arena_release(annotation->arena, annotation->data.free_text);
     annotation->data.free_text = NULL;
   }
 
@@ -1,9 +1,11 @@
 /* See LICENSE file for license and copyright information */
 
 #include <string.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "annotation-ink.h"
+#include "../arena.h"
 #include "internal.h"
 #include "internal/annotation-ink.h"
 
@@ -31,11 +33,13 @@ zathura_annotation_ink_init(zathura_annotation_t* annotation)
   ANNOTATION_INK_CHECK_TYPE()
 
   if (annotation->data.ink != NULL) {
-    free(annotation->data.ink);
+    free(annotation->data.ink->paths);
+    free(annotation->data.ink->points);
+    zathura_arena_release(annotation->arena, annotation->data.ink);
     annotation->data.ink = NULL;
   }
 
-  annotation->data.ink = calloc(1, sizeof(zathura_annotation_ink_t));
+  annotation->data.ink = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_ink_t));
   if (annotation->data.ink == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -53,8 +57,9 @@ zathura_annotation_ink_clear(zathura_annotation_t* annotation)
   ANNOTATION_INK_CHECK_TYPE()
 
   if (annotation->data.ink != NULL) {
-    zathura_list_free(annotation->data.ink->paths);
-    free(annotation->data.ink);
+    free(annotation->data.ink->paths);
+    free(annotation->data.ink->points);
+    zathura_arena_release(annotation->arena, annotation->data.ink);
     annotation->data.ink = NULL;
   }
 
@@ -63,34 +68,81 @@ zathura_annotation_ink_clear(zathura_annotation_t* annotation)
 
 zathura_error_t
 zathura_annotation_ink_set_paths(zathura_annotation_t* annotation,
-    zathura_list_t* paths)
+    const zathura_path_t* paths, size_t number_of_paths)
 {
-  if (annotation == NULL) {
+  if (annotation == NULL || (paths == NULL && number_of_paths != 0)) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  ANNOTATION_INK_CHECK_TYPE()
+  ANNOTATION_INK_CHECK_TYPE_AND_DATA()
+
+  size_t number_of_points = 0;
+  for (size_t i = 0; i < number_of_paths; i++) {
+    if (paths[i].points == NULL && paths[i].number_of_points != 0) {
+      return ZATHURA_ERROR_INVALID_ARGUMENTS;
+    }
 
-  if (annotation->data.ink->paths != NULL) {
-    zathura_list_free(annotation->data.ink->paths);
+    if (paths[i].number_of_points > SIZE_MAX - number_of_points) {
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+
+    number_of_points += paths[i].number_of_points;
   }
 
-  annotation->data.ink->paths = paths;
+  zathura_path_t* new_paths   = NULL;
+  zathura_point_t* new_points = NULL;
+
+  if (number_of_paths != 0) {
+    new_paths = calloc(number_of_paths, sizeof(zathura_path_t));
+    if (new_paths == NULL) {
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+  }
+
+  if (number_of_points != 0) {
+    new_points = calloc(number_of_points, sizeof(zathura_point_t));
+    if (new_points == NULL) {
+      free(new_paths);
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+  }
+
+  /* Pack the points of all paths into one array */
+  zathura_point_t* points = new_points;
+  for (size_t i = 0; i < number_of_paths; i++) {
+    const size_t n = paths[i].number_of_points;
+    if (n == 0) {
+      continue;
+    }
+
+    memcpy(points, paths[i].points, n * sizeof(zathura_point_t));
+    new_paths[i].points           = points;
+    new_paths[i].number_of_points = n;
+    points += n;
+  }
+
+  free(annotation->data.ink->paths);
+  free(annotation->data.ink->points);
+
+  annotation->data.ink->paths           = new_paths;
+  annotation->data.ink->number_of_paths = number_of_paths;
+  annotation->data.ink->points          = new_points;
 
   return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
 zathura_annotation_ink_get_paths(zathura_annotation_t* annotation,
-    zathura_list_t** paths)
+    const zathura_path_t** paths, size_t* number_of_paths)
 {
-  if (annotation == NULL || paths == NULL) {
+  if (annotation == NULL || paths == NULL || number_of_paths == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
   ANNOTATION_INK_CHECK_TYPE_AND_DATA()
 
-  *paths = annotation->data.ink->paths;
+  *paths           = annotation->data.ink->paths;
+  *number_of_paths = annotation->data.ink->number_of_paths;
 
   return ZATHURA_ERROR_OK;
 }
@@ -12,38 +12,47 @@ extern "C" {
 #include "border.h"
 
 /**
- * Sets a list of n zathura_path_t paths, each representing a stroked path.
- * Each array is a series of alternating horizontal and vertical
- * coordinates in default user space, specifying points along the path.
- * When drawn, the points are connected by straight lines or curves in an
+ * Sets n zathura_path_t paths, each representing a stroked path. Each path
+ * is a series of points in default user space along the path. When drawn,
+ * the points are connected by straight lines or curves in an
  * implementation-dependent way.
  *
+ * The paths and their points are copied into a single array of points, so
+ * the caller keeps ownership of the passed paths.
+ *
  * @param[in] annotation The annotation
- * @param[in] paths The list of paths
+ * @param[in] paths The array of paths or NULL to remove all paths
+ * @param[in] number_of_paths The number of paths
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
  * @return ZATHURA_ERROR_ANNOTATION_INVALID_TYPE Mismatching type of annotation passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_annotation_ink_set_paths(zathura_annotation_t* annotation, zathura_list_t* paths);
+zathura_error_t zathura_annotation_ink_set_paths(zathura_annotation_t*
+    annotation, const zathura_path_t* paths, size_t number_of_paths);
 
 /**
- * Returns a list of n zathura_path_t paths, each representing a stroked path.
- * Each array is a series of alternating horizontal and vertical
- * coordinates in default user space, specifying points along the path.
- * When drawn, the points are connected by straight lines or curves in an
+ * Returns the n zathura_path_t paths, each representing a stroked path. Each
+ * path is a series of points in default user space along the path. When
+ * drawn, the points are connected by straight lines or curves in an
  * implementation-dependent way.
  *
+ * The points of all paths are stored one after another, so the points of
+ * the first path can be used to walk over the points of all paths.
+ *
  * @param[in] annotation The annotation
- * @param[out] paths The list of paths
+ * @param[out] paths The array of paths, owned by the annotation
+ * @param[out] number_of_paths The number of paths
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
  * @return ZATHURA_ERROR_ANNOTATION_INVALID_TYPE Mismatching type of annotation passed
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_annotation_ink_get_paths(zathura_annotation_t* annotation, zathura_list_t** paths);
+zathura_error_t zathura_annotation_ink_get_paths(zathura_annotation_t*
+    annotation, const zathura_path_t** paths, size_t* number_of_paths);
 
 /**
  * Sets the border of this free text annotation
@@ -10,6 +10,7 @@
 #include "border.h"
 #include "annotation-line.h"
 #include "annotation-markup.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_LINE_CHECK_TYPE() \
@@ -36,11 +37,11 @@ zathura_annotation_line_init(zathura_annotation_t* annotation)
   ANNOTATION_LINE_CHECK_TYPE()
 
   if (annotation->data.line != NULL) {
-    free(annotation->data.line);
+    zathura_arena_release(annotation->arena, annotation->data.line);
     annotation->data.line = NULL;
   }
 
-  annotation->data.line = calloc(1, sizeof(zathura_annotation_line_t));
+  annotation->data.line = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_line_t));
   if (annotation->data.line == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -57,7 +58,7 @@ zathura_annotation_line_clear(zathura_annotation_t* annotation)
 
   ANNOTATION_LINE_CHECK_TYPE()
 
-  free(annotation->data.line);
+  zathura_arena_release(annotation->arena, annotation->data.line);
   annotation->data.line = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -4,6 +4,7 @@
 
 #include "annotation-link.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "../list.h"
 #include "internal.h"
 
@@ -31,10 +32,10 @@ zathura_annotation_link_init(zathura_annotation_t* annotation)
   ANNOTATION_LINK_CHECK_TYPE()
 
   if (annotation->data.link != NULL) {
-    free(annotation->data.link);
+    zathura_arena_release(annotation->arena, annotation->data.link);
   }
 
-  annotation->data.link = calloc(1, sizeof(zathura_annotation_link_t));
+  annotation->data.link = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_link_t));
   if (annotation->data.link == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -54,7 +55,7 @@ zathura_annotation_link_clear(zathura_annotation_t* annotation)
   ANNOTATION_LINK_CHECK_TYPE()
 
   if (annotation->data.link != NULL) {
-    free(annotation->data.link);
+    zathura_arena_release(annotation->arena, annotation->data.link);
     annotation->data.link = NULL;
   }
 
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 #include "internal/annotation-markup.h"
 
@@ -87,11 +88,11 @@ zathura_annotation_markup_init(zathura_annotation_t* annotation)
   ANNOTATION_MARKUP_CHECK_TYPE()
 
   if (annotation->markup != NULL) {
-    free(annotation->markup);
+    zathura_arena_release(annotation->arena, annotation->markup);
     annotation->markup = NULL;
   }
 
-  annotation->markup = calloc(1, sizeof(zathura_annotation_markup_t));
+  annotation->markup = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_markup_t));
   if (annotation->markup == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -114,7 +115,7 @@ zathura_annotation_markup_clear(zathura_annotation_t* annotation)
     g_free(annotation->markup->label);
     g_free(annotation->markup->text);
 
-    free(annotation->markup);
+    zathura_arena_release(annotation->arena, annotation->markup);
     annotation->markup = NULL;
   }
 
@@ -6,6 +6,7 @@
 #include "annotation-movie.h"
 #include "../movie.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_MOVIE_CHECK_TYPE() \
@@ -32,10 +33,10 @@ zathura_annotation_movie_init(zathura_annotation_t* annotation)
   ANNOTATION_MOVIE_CHECK_TYPE()
 
   if (annotation->data.movie != NULL) {
-    free(annotation->data.movie);
+    zathura_arena_release(annotation->arena, annotation->data.movie);
   }
 
-  annotation->data.movie = calloc(1, sizeof(zathura_annotation_movie_t));
+  annotation->data.movie = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_movie_t));
   if (annotation->data.movie == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -60,7 +61,7 @@ zathura_annotation_movie_clear(zathura_annotation_t* annotation)
     free(annotation->data.movie->title);
     annotation->data.movie->title = NULL;
 
-    free(annotation->data.movie);
+    zathura_arena_release(annotation->arena, annotation->data.movie);
     annotation->data.movie = NULL;
   }
 
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 
 #include "annotation-polyline.h"
+#include "../arena.h"
 #include "internal.h"
 #include "internal/annotation-polyline.h"
 
@@ -31,11 +32,12 @@ zathura_annotation_poly_line_init(zathura_annotation_t* annotation)
   ANNOTATION_POLY_LINE_CHECK_TYPE()
 
   if (annotation->data.poly_line != NULL) {
-    free(annotation->data.poly_line);
+    free(annotation->data.poly_line->vertices.points);
+    zathura_arena_release(annotation->arena, annotation->data.poly_line);
     annotation->data.poly_line = NULL;
   }
 
-  annotation->data.poly_line = calloc(1, sizeof(zathura_annotation_poly_line_t));
+  annotation->data.poly_line = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_poly_line_t));
   if (annotation->data.poly_line == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -53,7 +55,8 @@ zathura_annotation_poly_line_clear(zathura_annotation_t* annotation)
   ANNOTATION_POLY_LINE_CHECK_TYPE()
 
   if (annotation->data.poly_line != NULL) {
-    free(annotation->data.poly_line);
+    free(annotation->data.poly_line->vertices.points);
+    zathura_arena_release(annotation->arena, annotation->data.poly_line);
     annotation->data.poly_line = NULL;
   }
 
@@ -62,30 +65,43 @@ zathura_annotation_poly_line_clear(zathura_annotation_t* annotation)
 
 zathura_error_t
 zathura_annotation_poly_line_set_vertices(zathura_annotation_t* annotation,
-    zathura_list_t* vertices)
+    const zathura_point_t* vertices, size_t number_of_vertices)
 {
-  if (annotation == NULL || vertices == NULL) {
+  if (annotation == NULL || (vertices == NULL && number_of_vertices != 0)) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
   ANNOTATION_POLY_LINE_CHECK_TYPE_AND_DATA()
 
-  annotation->data.poly_line->vertices = vertices;
+  zathura_point_t* points = NULL;
+  if (number_of_vertices != 0) {
+    points = calloc(number_of_vertices, sizeof(zathura_point_t));
+    if (points == NULL) {
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+
+    memcpy(points, vertices, number_of_vertices * sizeof(zathura_point_t));
+  }
+
+  free(annotation->data.poly_line->vertices.points);
+  annotation->data.poly_line->vertices.points           = points;
+  annotation->data.poly_line->vertices.number_of_points = number_of_vertices;
 
   return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
 zathura_annotation_poly_line_get_vertices(zathura_annotation_t* annotation,
-    zathura_list_t** vertices)
+    const zathura_point_t** vertices, size_t* number_of_vertices)
 {
-  if (annotation == NULL || vertices == NULL) {
+  if (annotation == NULL || vertices == NULL || number_of_vertices == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
   ANNOTATION_POLY_LINE_CHECK_TYPE_AND_DATA()
 
-  *vertices = annotation->data.poly_line->vertices;
+  *vertices           = annotation->data.poly_line->vertices.points;
+  *number_of_vertices = annotation->data.poly_line->vertices.number_of_points;
 
   return ZATHURA_ERROR_OK;
 }
@@ -12,32 +12,36 @@ extern "C" {
 #include "color.h"
 
 /**
- * Sets a list of zathura_point_t representing the alternating horizontal and
- * vertical coordinates, respectively, of each vertex, in default user space.
+ * Sets the vertices in default user space. The vertices are copied, so the
+ * caller keeps ownership of the passed array.
  *
  * @param[in] annotation The annotation
- * @param[in] vertices The list of vertices
+ * @param[in] vertices The array of vertices or NULL to remove all vertices
+ * @param[in] number_of_vertices The number of vertices
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
  * @return ZATHURA_ERROR_ANNOTATION_INVALID_TYPE Mismatching type of annotation passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_annotation_poly_line_set_vertices(zathura_annotation_t* annotation, zathura_list_t* vertices);
+zathura_error_t zathura_annotation_poly_line_set_vertices(zathura_annotation_t*
+    annotation, const zathura_point_t* vertices, size_t number_of_vertices);
 
 /**
- * Returns a list of zathura_point_t representing the alternating horizontal and
- * vertical coordinates, respectively, of each vertex, in default user space.
+ * Returns the vertices in default user space.
  *
  * @param[in] annotation The annotation
- * @param[out] vertices The list of vertices
+ * @param[out] vertices The array of vertices, owned by the annotation
+ * @param[out] number_of_vertices The number of vertices
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
  * @return ZATHURA_ERROR_ANNOTATION_INVALID_TYPE Mismatching type of annotation passed
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_annotation_poly_line_get_vertices(zathura_annotation_t* annotation, zathura_list_t** vertices);
+zathura_error_t zathura_annotation_poly_line_get_vertices(zathura_annotation_t*
+    annotation, const zathura_point_t** vertices, size_t* number_of_vertices);
 
 /**
  * Sets the line ending of this poly-line annotation
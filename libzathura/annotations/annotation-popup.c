@@ -3,6 +3,7 @@
 #include <stdlib.h>
 
 #include "annotation-popup.h"
+#include "../arena.h"
 #include "internal.h"
 #include "internal/annotation-popup.h"
 
@@ -30,11 +31,11 @@ zathura_annotation_popup_init(zathura_annotation_t* annotation)
   ANNOTATION_POPUP_CHECK_TYPE()
 
   if (annotation->data.popup != NULL) {
-    free(annotation->data.popup);
+    zathura_arena_release(annotation->arena, annotation->data.popup);
     annotation->data.popup = NULL;
   }
 
-  annotation->data.popup = calloc(1, sizeof(zathura_annotation_popup_t));
+  annotation->data.popup = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_popup_t));
   if (annotation->data.popup == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -54,7 +55,7 @@ zathura_annotation_popup_clear(zathura_annotation_t* annotation)
   ANNOTATION_POPUP_CHECK_TYPE()
 
   if (annotation->data.popup != NULL) {
-    free(annotation->data.popup);
+    zathura_arena_release(annotation->arena, annotation->data.popup);
     annotation->data.popup = NULL;
   }
 
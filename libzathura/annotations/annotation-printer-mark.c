@@ -5,6 +5,7 @@
 
 #include "annotation-printer-mark.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_PRINTER_MARK_CHECK_TYPE() \
@@ -31,10 +32,10 @@ zathura_annotation_printer_mark_init(zathura_annotation_t* annotation)
   ANNOTATION_PRINTER_MARK_CHECK_TYPE()
 
   if (annotation->data.printer_mark != NULL) {
-    free(annotation->data.printer_mark);
+    zathura_arena_release(annotation->arena, annotation->data.printer_mark);
   }
 
-  annotation->data.printer_mark = calloc(1, sizeof(zathura_annotation_printer_mark_t));
+  annotation->data.printer_mark = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_printer_mark_t));
   if (annotation->data.printer_mark == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -55,7 +56,7 @@ zathura_annotation_printer_mark_clear(zathura_annotation_t* annotation)
     g_free(annotation->data.printer_mark->name);
     g_free(annotation->data.printer_mark->mark_style);
 
-    free(annotation->data.printer_mark);
+    zathura_arena_release(annotation->arena, annotation->data.printer_mark);
     annotation->data.printer_mark = NULL;
   }
 
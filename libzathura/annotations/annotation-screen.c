@@ -5,6 +5,7 @@
 #include "annotation-screen.h"
 #include "../action.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_SCREEN_CHECK_TYPE() \
@@ -31,10 +32,10 @@ zathura_annotation_screen_init(zathura_annotation_t* annotation)
   ANNOTATION_SCREEN_CHECK_TYPE()
 
   if (annotation->data.screen != NULL) {
-    free(annotation->data.screen);
+    zathura_arena_release(annotation->arena, annotation->data.screen);
   }
 
-  annotation->data.screen = calloc(1, sizeof(zathura_annotation_screen_t));
+  annotation->data.screen = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_screen_t));
   if (annotation->data.screen == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -55,7 +56,7 @@ zathura_annotation_screen_clear(zathura_annotation_t* annotation)
     free(annotation->data.screen->title);
     annotation->data.screen->title = NULL;
 
-    free(annotation->data.screen);
+    zathura_arena_release(annotation->arena, annotation->data.screen);
     annotation->data.screen = NULL;
   }
 
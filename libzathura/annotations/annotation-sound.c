@@ -5,6 +5,7 @@
 #include "annotation-sound.h"
 #include "../sound.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_SOUND_CHECK_TYPE() \
@@ -31,10 +32,10 @@ zathura_annotation_sound_init(zathura_annotation_t* annotation)
   ANNOTATION_SOUND_CHECK_TYPE()
 
   if (annotation->data.sound != NULL) {
-    free(annotation->data.sound);
+    zathura_arena_release(annotation->arena, annotation->data.sound);
   }
 
-  annotation->data.sound = calloc(1, sizeof(zathura_annotation_sound_t));
+  annotation->data.sound = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_sound_t));
   if (annotation->data.sound == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -56,7 +57,7 @@ zathura_annotation_sound_clear(zathura_annotation_t* annotation)
   if (annotation->data.sound != NULL) {
     g_free(annotation->data.sound->icon_name);
 
-    free(annotation->data.sound);
+    zathura_arena_release(annotation->arena, annotation->data.sound);
     annotation->data.sound = NULL;
   }
 
@@ -5,6 +5,7 @@
 #include <stdio.h>
 
 #include "../annotations.h"
+#include "../arena.h"
 #include "annotation-caret.h"
 #include "annotation-square.h"
 #include "annotation-circle.h"
@@ -36,10 +37,10 @@ zathura_annotation_square_and_circle_init(zathura_annotation_t* annotation)
   ANNOTATION_SQUARE_AND_CIRCLE_CHECK_TYPE()
 
   if (annotation->data.square_and_circle != NULL) {
-    free(annotation->data.square_and_circle);
+    zathura_arena_release(annotation->arena, annotation->data.square_and_circle);
   }
 
-  annotation->data.square_and_circle = calloc(1, sizeof(zathura_annotation_square_and_circle_t));
+  annotation->data.square_and_circle = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_square_and_circle_t));
   if (annotation->data.square_and_circle == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -56,7 +57,7 @@ zathura_annotation_square_and_circle_clear(zathura_annotation_t* annotation)
 
   ANNOTATION_SQUARE_AND_CIRCLE_CHECK_TYPE()
 
-  free(annotation->data.square_and_circle);
+  zathura_arena_release(annotation->arena, annotation->data.square_and_circle);
   annotation->data.square_and_circle = NULL;
 
   return ZATHURA_ERROR_OK;
@@ -4,6 +4,7 @@
 
 #include "annotation-stamp.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "../error.h"
 
 #include "internal.h"
@@ -32,11 +33,11 @@ zathura_annotation_stamp_init(zathura_annotation_t* annotation)
   ANNOTATION_STAMP_CHECK_TYPE()
 
   if (annotation->data.stamp != NULL) {
-    free(annotation->data.stamp);
+    zathura_arena_release(annotation->arena, annotation->data.stamp);
     annotation->data.stamp = NULL;
   }
 
-  annotation->data.stamp = calloc(1, sizeof(zathura_annotation_stamp_t));
+  annotation->data.stamp = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_stamp_t));
   if (annotation->data.stamp == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -59,7 +60,7 @@ zathura_annotation_stamp_clear(zathura_annotation_t* annotation)
     g_free(annotation->data.stamp->icon_name);
   }
 
-  free(annotation->data.stamp);
+  zathura_arena_release(annotation->arena, annotation->data.stamp);
   annotation->data.stamp = NULL;
 
   return ZATHURA_ERROR_OK;
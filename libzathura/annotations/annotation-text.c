@@ -5,6 +5,7 @@
 
 #include "annotation-text.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 #include "internal/annotation-text.h"
 
@@ -32,11 +33,11 @@ zathura_annotation_text_init(zathura_annotation_t* annotation)
   ANNOTATION_TEXT_CHECK_TYPE()
 
   if (annotation->data.text != NULL) {
-    free(annotation->data.text);
+    zathura_arena_release(annotation->arena, annotation->data.text);
     annotation->data.text = NULL;
   }
 
-  annotation->data.text = calloc(1, sizeof(zathura_annotation_text_t));
+  annotation->data.text = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_text_t));
   if (annotation->data.text == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -55,7 +56,7 @@ zathura_annotation_text_clear(zathura_annotation_t* annotation)
 
   if (annotation->data.text != NULL) {
     g_free(annotation->data.text->icon_name);
-    free(annotation->data.text);
+    zathura_arena_release(annotation->arena, annotation->data.text);
     annotation->data.text = NULL;
   }
 
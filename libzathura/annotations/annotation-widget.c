@@ -5,6 +5,7 @@
 
 #include "annotation-widget.h"
 #include "../annotations.h"
+#include "../arena.h"
 #include "internal.h"
 
 #define ANNOTATION_WIDGET_CHECK_TYPE() \
@@ -31,10 +32,10 @@ zathura_annotation_widget_init(zathura_annotation_t* annotation)
   ANNOTATION_WIDGET_CHECK_TYPE()
 
   if (annotation->data.widget != NULL) {
-    free(annotation->data.widget);
+    zathura_arena_release(annotation->arena, annotation->data.widget);
   }
 
-  annotation->data.widget = calloc(1, sizeof(zathura_annotation_widget_t));
+  annotation->data.widget = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_widget_t));
   if (annotation->data.widget == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -56,7 +57,7 @@ zathura_annotation_widget_clear(zathura_annotation_t* annotation)
     g_free(annotation->data.widget->rollover_caption);
     g_free(annotation->data.widget->alternate_caption);
 
-    free(annotation->data.widget);
+    zathura_arena_release(annotation->arena, annotation->data.widget);
     annotation->data.widget = NULL;
   }
 
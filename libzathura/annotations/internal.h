@@ -28,6 +28,11 @@ struct zathura_annotation_s {
    */
   zathura_page_t* page;
 
+  /**
+   * The arena the annotation is allocated from or NULL
+   */
+  struct zathura_arena_s* arena;
+
   /**
    * Text to be displayed for the annotation or, if this type of annotation does
    * not display text, an alternate description of the annotation’s contents in
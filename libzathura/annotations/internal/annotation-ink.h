@@ -17,13 +17,22 @@ extern "C" {
  */
 typedef struct zathura_annotation_ink_s {
   /**
-   * An list of n zathura_path_t paths, each representing a stroked path.
-   * Each array is a series of alternating horizontal and vertical
-   * coordinates in default user space, specifying points along the path.
+   * An array of n zathura_path_t paths, each representing a stroked path.
+   * Each path is a series of points in default user space along the path.
    * When drawn, the points are connected by straight lines or curves in an
    * implementation-dependent way.
    */
-  zathura_list_t* paths;
+  zathura_path_t* paths;
+
+  /**
+   * The number of paths
+   */
+  size_t number_of_paths;
+
+  /**
+   * The points of all paths, one after another
+   */
+  zathura_point_t* points;
 
   /**
    * A border style dictionary specifying the line width and dash pattern to
@@ -13,10 +13,9 @@ extern "C" {
  */
 typedef struct zathura_annotation_polygon_s {
   /**
-   * An array of numbers representing the alternating horizontal and vertical
-   * coordinates, respectively, of each vertex, in default user space.
+   * The vertices in default user space
    */
-  zathura_list_t* vertices;
+  zathura_path_t vertices;
 
   /**
    * A border style dictionary specifying the width and dash pattern to be used
@@ -16,10 +16,9 @@ extern "C" {
  */
 typedef struct zathura_annotation_poly_line_s {
   /**
-   * An array of numbers representing the alternating horizontal and vertical
-   * coordinates, respectively, of each vertex, in default user space.
+   * The vertices in default user space
    */
-  zathura_list_t* vertices;
+  zathura_path_t vertices;
 
   /**
    * An array of two names specifying the line ending styles to be used in
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "../../arena.h"
 #include "../internal.h"
 #include "annotation-text-markup.h"
 
@@ -34,11 +35,11 @@ zathura_annotation_text_markup_init(zathura_annotation_t* annotation)
   ANNOTATION_TEXT_MARKUP_CHECK_TYPE()
 
   if (annotation->data.text_markup != NULL) {
-    free(annotation->data.text_markup);
+    zathura_arena_release(annotation->arena, annotation->data.text_markup);
     annotation->data.text_markup = NULL;
   }
 
-  annotation->data.text_markup = calloc(1, sizeof(zathura_annotation_text_markup_t));
+  annotation->data.text_markup = zathura_arena_calloc(annotation->arena, sizeof(zathura_annotation_text_markup_t));
   if (annotation->data.text_markup == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
@@ -60,7 +61,7 @@ zathura_annotation_text_markup_clear(zathura_annotation_t* annotation)
   ANNOTATION_TEXT_MARKUP_CHECK_TYPE()
 
   if (annotation->data.text_markup != NULL) {
-    free(annotation->data.text_markup);
+    zathura_arena_release(annotation->arena, annotation->data.text_markup);
     annotation->data.text_markup = NULL;
   }
 
@@ -0,0 +1,145 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <glib.h>
+
+#include "arena.h"
+
+/* Size of the first chunk, later chunks grow up to the maximal size */
+#define ARENA_MIN_CHUNK_SIZE (1 << 12)
+#define ARENA_MAX_CHUNK_SIZE (1 << 16)
+
+#define ARENA_ALIGNMENT alignof(max_align_t)
+
+typedef struct arena_chunk_s {
+  struct arena_chunk_s* next; /**< The previously filled chunk */
+  size_t size; /**< Usable size of the chunk */
+  size_t used; /**< Used bytes of the chunk */
+  alignas(max_align_t) unsigned char data[]; /**< The memory of the chunk */
+} arena_chunk_t;
+
+struct zathura_arena_s {
+  arena_chunk_t* chunks; /**< The chunk in use, followed by the filled ones */
+  size_t next_chunk_size; /**< Size of the next chunk */
+};
+
+static GPrivate current_arena = G_PRIVATE_INIT(NULL);
+
+zathura_error_t
+zathura_arena_new(zathura_arena_t** arena)
+{
+  if (arena == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *arena = calloc(1, sizeof(**arena));
+  if (*arena == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*arena)->next_chunk_size = ARENA_MIN_CHUNK_SIZE;
+
+  return ZATHURA_ERROR_OK;
+}
+
+void
+zathura_arena_free(zathura_arena_t* arena)
+{
+  if (arena == NULL) {
+    return;
+  }
+
+  arena_chunk_t* chunk = arena->chunks;
+  while (chunk != NULL) {
+    arena_chunk_t* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  free(arena);
+}
+
+/* Adds a chunk that has room for at least size bytes */
+static arena_chunk_t*
+arena_add_chunk(zathura_arena_t* arena, size_t size)
+{
+  const size_t chunk_size = MAX(size, arena->next_chunk_size);
+  if (chunk_size > SIZE_MAX - sizeof(arena_chunk_t)) {
+    return NULL;
+  }
+
+  /* Chunks are zeroed once, allocations never reuse memory */
+  arena_chunk_t* chunk = calloc(1, sizeof(arena_chunk_t) + chunk_size);
+  if (chunk == NULL) {
+    return NULL;
+  }
+
+  chunk->size = chunk_size;
+
+  /* Oversized allocations get a chunk of their own behind the current one,
+   * so that the remaining space of the current chunk is not wasted */
+  if (size > arena->next_chunk_size && arena->chunks != NULL) {
+    chunk->next = arena->chunks->next;
+    arena->chunks->next = chunk;
+  } else {
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->next_chunk_size = MIN(arena->next_chunk_size * 2, ARENA_MAX_CHUNK_SIZE);
+  }
+
+  return chunk;
+}
+
+void*
+zathura_arena_calloc(zathura_arena_t* arena, size_t size)
+{
+  if (arena == NULL) {
+    return calloc(1, size);
+  }
+
+  if (size == 0) {
+    size = 1;
+  } else if (size > SIZE_MAX - ARENA_ALIGNMENT) {
+    return NULL;
+  }
+
+  size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+
+  arena_chunk_t* chunk = arena->chunks;
+  if (chunk == NULL || chunk->size - chunk->used < size) {
+    chunk = arena_add_chunk(arena, size);
+    if (chunk == NULL) {
+      return NULL;
+    }
+  }
+
+  void* data = chunk->data + chunk->used;
+  chunk->used += size;
+
+  return data;
+}
+
+void
+zathura_arena_release(zathura_arena_t* arena, void* data)
+{
+  if (arena == NULL) {
+    free(data);
+  }
+}
+
+zathura_arena_t*
+zathura_arena_get_current(void)
+{
+  return g_private_get(&current_arena);
+}
+
+zathura_arena_t*
+zathura_arena_set_current(zathura_arena_t* arena)
+{
+  zathura_arena_t* previous = g_private_get(&current_arena);
+  g_private_set(&current_arena, arena);
+
+  return previous;
+}
@@ -0,0 +1,81 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_ARENA_H
+#define LIBZATHURA_ARENA_H
+
+#include <stddef.h>
+
+#include "error.h"
+#include "macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct zathura_arena_s zathura_arena_t;
+
+/**
+ * Creates a new arena. Memory is handed out from large chunks and only
+ * returned all at once when the arena is freed, which makes it suitable for
+ * the many small objects that a plugin creates for the annotations, form
+ * fields and links of a page.
+ *
+ * @param[out] arena The arena
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_arena_new(zathura_arena_t** arena);
+
+/**
+ * Frees the arena and all memory allocated from it.
+ *
+ * @param[in] arena The arena
+ */
+HIDDEN void zathura_arena_free(zathura_arena_t* arena);
+
+/**
+ * Allocates zero-initialized memory that is suitably aligned for any type.
+ * Without an arena the memory is allocated with calloc.
+ *
+ * @param[in] arena The arena or NULL
+ * @param[in] size The size in bytes
+ *
+ * @return The memory or NULL if out of memory
+ */
+HIDDEN void* zathura_arena_calloc(zathura_arena_t* arena, size_t size);
+
+/**
+ * Releases memory returned by zathura_arena_calloc. Memory of an arena is
+ * kept until the arena is freed, memory allocated without an arena is freed
+ * immediately.
+ *
+ * @param[in] arena The arena the memory was allocated from or NULL
+ * @param[in] data The memory
+ */
+HIDDEN void zathura_arena_release(zathura_arena_t* arena, void* data);
+
+/**
+ * Returns the arena that objects created by the calling thread are allocated
+ * from.
+ *
+ * @return The arena or NULL if objects are allocated individually
+ */
+HIDDEN zathura_arena_t* zathura_arena_get_current(void);
+
+/**
+ * Sets the arena that objects created by the calling thread are allocated
+ * from.
+ *
+ * @param[in] arena The arena or NULL to allocate objects individually
+ *
+ * @return The previous arena of the thread
+ */
+HIDDEN zathura_arena_t* zathura_arena_set_current(zathura_arena_t* arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_ARENA_H */
@@ -1,13 +1,39 @@
 /* See LICENSE file for license and copyright information */
 
-#define _XOPEN_SOURCE 500
-
+#ifdef HAVE_COPY_FILE_RANGE
+#define _GNU_SOURCE
+#else
+#define _XOPEN_SOURCE 700
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <glib.h>
 
 #include "attachment.h"
 #include "plugin-api/attachment.h"
 
+/* Size of the chunks in which attachments are copied */
+#define ATTACHMENT_CHUNK_SIZE (1 << 16)
+
+typedef enum attachment_source_e {
+  ATTACHMENT_SOURCE_NONE, /**< The attachment has no data */
+  ATTACHMENT_SOURCE_COPY, /**< A copy of the data is kept in memory */
+  ATTACHMENT_SOURCE_BORROWED, /**< The data is kept in memory by the plugin */
+  ATTACHMENT_SOURCE_FILE, /**< The data is a range of a file */
+  ATTACHMENT_SOURCE_CALLBACK /**< The data is read by a function of the plugin */
+} attachment_source_t;
+
+struct zathura_attachment_reader_s {
+  zathura_attachment_t* attachment; /**< The read attachment */
+  uint64_t offset; /**< Offset of the next read */
+  int fd; /**< The opened file of a file range, -1 otherwise */
+};
+
 struct zathura_attachment_s {
   /**
    * The name of the attachment.
@@ -22,7 +48,7 @@ struct zathura_attachment_s {
   /**
    * The size of the attachment in bytes.
    */
-  unsigned int size;
+  uint64_t size;
 
   /**
    * The date and time when the attachment was created.
@@ -43,9 +69,35 @@ struct zathura_attachment_s {
   char* checksum;
 
   /**
-   * Custom data of the plugin
+   * Where the data of the attachment comes from
    */
-  char* data;
+  attachment_source_t source;
+
+  /**
+   * The data of copied and borrowed attachments
+   */
+  const char* data;
+
+  /**
+   * Releases borrowed data
+   */
+  zathura_free_function_t data_free_function;
+
+  /**
+   * The file and the offset of the data in the file of file ranges
+   */
+  char* path;
+  uint64_t offset;
+
+  /**
+   * The mapped file of file ranges, created on demand
+   */
+  GMappedFile* mapped_file;
+
+  /**
+   * The read function of attachments read by the plugin
+   */
+  zathura_attachment_read_function_t read_function;
 
   /**
    * Custom data of the plugin
@@ -63,6 +115,39 @@ struct zathura_attachment_s {
   zathura_attachment_save_function_t save_function;
 };
 
+/* Releases the data of the attachment, whatever its source */
+static void
+attachment_clear_data(zathura_attachment_t* attachment)
+{
+  switch (attachment->source) {
+    case ATTACHMENT_SOURCE_COPY:
+      free((char*) attachment->data);
+      break;
+    case ATTACHMENT_SOURCE_BORROWED:
+      if (attachment->data_free_function != NULL) {
+        attachment->data_free_function((char*) attachment->data);
+      }
+      break;
+    case ATTACHMENT_SOURCE_FILE:
+      if (attachment->mapped_file != NULL) {
+        g_mapped_file_unref(attachment->mapped_file);
+      }
+      free(attachment->path);
+      break;
+    default:
+      break;
+  }
+
+  attachment->source             = ATTACHMENT_SOURCE_NONE;
+  attachment->size               = 0;
+  attachment->data               = NULL;
+  attachment->data_free_function = NULL;
+  attachment->path               = NULL;
+  attachment->offset             = 0;
+  attachment->mapped_file        = NULL;
+  attachment->read_function      = NULL;
+}
+
 zathura_error_t
 zathura_attachment_new(zathura_attachment_t** attachment)
 {
@@ -85,6 +170,8 @@ zathura_attachment_free(zathura_attachment_t* attachment)
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  attachment_clear_data(attachment);
+
   if (attachment->user_data != NULL && attachment->user_data_free_function) {
     attachment->user_data_free_function(attachment->user_data);
   }
@@ -97,10 +184,6 @@ zathura_attachment_free(zathura_attachment_t* attachment)
     free(attachment->description);
   }
 
-  if (attachment->data != NULL) {
-    free(attachment->data);
-  }
-
   if (attachment->checksum != NULL) {
     free(attachment->checksum);
   }
@@ -110,6 +193,130 @@ zathura_attachment_free(zathura_attachment_t* attachment)
   return ZATHURA_ERROR_OK;
 }
 
+/* Reads from the data of the attachment at the given offset */
+static zathura_error_t
+attachment_read(zathura_attachment_t* attachment, int fd, uint64_t offset,
+    void* buffer, size_t length, size_t* bytes_read)
+{
+  *bytes_read = 0;
+
+  switch (attachment->source) {
+    case ATTACHMENT_SOURCE_COPY:
+    case ATTACHMENT_SOURCE_BORROWED:
+      memcpy(buffer, attachment->data + offset, length);
+      *bytes_read = length;
+      return ZATHURA_ERROR_OK;
+    case ATTACHMENT_SOURCE_FILE: {
+      ssize_t result;
+      do {
+        result = pread(fd, buffer, length, (off_t) (attachment->offset + offset));
+      } while (result < 0 && errno == EINTR);
+
+      if (result < 0) {
+        return ZATHURA_ERROR_UNKNOWN;
+      }
+
+      *bytes_read = result;
+      return ZATHURA_ERROR_OK;
+    }
+    case ATTACHMENT_SOURCE_CALLBACK:
+      return attachment->read_function(attachment, offset, buffer, length,
+          bytes_read, attachment->user_data);
+    default:
+      return ZATHURA_ERROR_OK;
+  }
+}
+
+static zathura_error_t
+write_all(int fd, const char* data, uint64_t length)
+{
+  while (length > 0) {
+    const ssize_t written = write(fd, data, MIN(length, (uint64_t) G_MAXSSIZE));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return ZATHURA_ERROR_UNKNOWN;
+    }
+
+    data   += written;
+    length -= written;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Copies a file range with copy_file_range, returns the number of copied
+ * bytes so that a failed copy can be finished by reading and writing */
+static uint64_t
+attachment_copy_file_range(zathura_attachment_t* attachment, int fd)
+{
+  uint64_t copied = 0;
+
+#ifdef HAVE_COPY_FILE_RANGE
+  const int input = open(attachment->path, O_RDONLY | O_CLOEXEC);
+  if (input == -1) {
+    return 0;
+  }
+
+  loff_t input_offset = attachment->offset;
+  while (copied < attachment->size) {
+    const ssize_t result = copy_file_range(input, &input_offset, fd, NULL,
+        MIN(attachment->size - copied, (uint64_t) G_MAXSSIZE), 0);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    } else if (result <= 0) {
+      /* e.g. copies across file systems on older kernels */
+      break;
+    }
+
+    copied += result;
+  }
+
+  close(input);
+#endif
+
+  return copied;
+}
+
+static zathura_error_t
+attachment_write(zathura_attachment_t* attachment, int fd)
+{
+  if (attachment->source == ATTACHMENT_SOURCE_COPY ||
+      attachment->source == ATTACHMENT_SOURCE_BORROWED) {
+    return write_all(fd, attachment->data, attachment->size);
+  }
+
+  zathura_attachment_reader_t* reader = NULL;
+  zathura_error_t error = zathura_attachment_reader_new(&reader, attachment);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (attachment->source == ATTACHMENT_SOURCE_FILE) {
+    reader->offset = attachment_copy_file_range(attachment, fd);
+  }
+
+  char* buffer = malloc(ATTACHMENT_CHUNK_SIZE);
+  if (buffer == NULL) {
+    zathura_attachment_reader_free(reader);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  size_t bytes_read = 0;
+  while ((error = zathura_attachment_reader_read(reader, buffer,
+          ATTACHMENT_CHUNK_SIZE, &bytes_read)) == ZATHURA_ERROR_OK && bytes_read > 0) {
+    if ((error = write_all(fd, buffer, bytes_read)) != ZATHURA_ERROR_OK) {
+      break;
+    }
+  }
+
+  free(buffer);
+  zathura_attachment_reader_free(reader);
+
+  return error;
+}
+
 zathura_error_t
 zathura_attachment_save(zathura_attachment_t* attachment, const char* path)
 {
@@ -121,36 +328,116 @@ zathura_attachment_save(zathura_attachment_t* attachment, const char* path)
     return attachment->save_function(attachment, path, attachment->user_data);
   }
 
-	return ZATHURA_ERROR_OK;
+  const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (fd == -1) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  zathura_error_t error = attachment_write(attachment, fd);
+  if (close(fd) != 0 && error == ZATHURA_ERROR_OK) {
+    error = ZATHURA_ERROR_UNKNOWN;
+  }
+
+  /* Do not leave truncated files behind */
+  if (error != ZATHURA_ERROR_OK) {
+    unlink(path);
+  }
+
+  return error;
 }
 
 zathura_error_t
-zathura_attachment_set_data(zathura_attachment_t* attachment, const char* data, unsigned int size)
+zathura_attachment_set_data(zathura_attachment_t* attachment, const char* data, size_t size)
 {
-  if (attachment == NULL) {
+  if (attachment == NULL || (data == NULL && size != 0)) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  if (attachment->data != NULL) {
-    free(attachment->data);
+  attachment_clear_data(attachment);
+
+  if (size == 0) {
+    return ZATHURA_ERROR_OK;
   }
 
-  attachment->size = size;
+  char* copy = calloc(size, sizeof(char));
+  if (copy == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
 
-  if (size == 0) {
-    attachment->data = NULL;
-  } else {
-    attachment->data = calloc(size, sizeof(*(attachment->data)));
-    if (attachment->data == NULL) {
-      return ZATHURA_ERROR_OUT_OF_MEMORY;
-    }
+  memcpy(copy, data, size);
 
-    if (memcpy(attachment->data, data, size) != attachment->data) {
-      free(attachment->data);
-      return ZATHURA_ERROR_UNKNOWN;
-    }
+  attachment->source = ATTACHMENT_SOURCE_COPY;
+  attachment->data   = copy;
+  attachment->size   = size;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_attachment_set_data_borrowed(zathura_attachment_t* attachment, const
+    char* data, uint64_t size, zathura_free_function_t free_function)
+{
+  if (attachment == NULL || data == NULL || size > SIZE_MAX) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  attachment_clear_data(attachment);
+
+  attachment->source             = ATTACHMENT_SOURCE_BORROWED;
+  attachment->data               = data;
+  attachment->data_free_function = free_function;
+  attachment->size               = size;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_attachment_set_data_file(zathura_attachment_t* attachment, const char*
+    path, uint64_t offset, uint64_t size)
+{
+  if (attachment == NULL || path == NULL || strlen(path) == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  struct stat file_stat;
+  if (stat(path, &file_stat) != 0) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  if (S_ISREG(file_stat.st_mode) == 0 || offset > (uint64_t) file_stat.st_size ||
+      size > (uint64_t) file_stat.st_size - offset) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  char* copy = strdup(path);
+  if (copy == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  attachment_clear_data(attachment);
+
+  attachment->source = ATTACHMENT_SOURCE_FILE;
+  attachment->path   = copy;
+  attachment->offset = offset;
+  attachment->size   = size;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_attachment_set_read_function(zathura_attachment_t* attachment,
+    zathura_attachment_read_function_t read_function, uint64_t size)
+{
+  if (attachment == NULL || read_function == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  attachment_clear_data(attachment);
+
+  attachment->source        = ATTACHMENT_SOURCE_CALLBACK;
+  attachment->read_function = read_function;
+  attachment->size          = size;
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -161,7 +448,105 @@ zathura_attachment_get_data(zathura_attachment_t* attachment, char** data)
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  *data = attachment->data;
+  switch (attachment->source) {
+    case ATTACHMENT_SOURCE_FILE:
+      if (attachment->size > SIZE_MAX) {
+        return ZATHURA_ERROR_UNKNOWN;
+      }
+
+      /* Mapped pages are backed by the file and not copied */
+      if (attachment->mapped_file == NULL) {
+        attachment->mapped_file = g_mapped_file_new(attachment->path, FALSE, NULL);
+        if (attachment->mapped_file == NULL) {
+          return ZATHURA_ERROR_UNKNOWN;
+        }
+      }
+
+      if (attachment->offset + attachment->size > g_mapped_file_get_length(attachment->mapped_file)) {
+        return ZATHURA_ERROR_UNKNOWN;
+      }
+
+      *data = g_mapped_file_get_contents(attachment->mapped_file) + attachment->offset;
+      return ZATHURA_ERROR_OK;
+    case ATTACHMENT_SOURCE_CALLBACK:
+      return ZATHURA_ERROR_UNKNOWN;
+    default:
+      *data = (char*) attachment->data;
+      return ZATHURA_ERROR_OK;
+  }
+}
+
+zathura_error_t
+zathura_attachment_reader_new(zathura_attachment_reader_t** reader,
+    zathura_attachment_t* attachment)
+{
+  if (reader == NULL || attachment == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *reader = calloc(1, sizeof(**reader));
+  if (*reader == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*reader)->attachment = attachment;
+  (*reader)->fd         = -1;
+
+  if (attachment->source == ATTACHMENT_SOURCE_FILE &&
+      ((*reader)->fd = open(attachment->path, O_RDONLY | O_CLOEXEC)) == -1) {
+    free(*reader);
+    *reader = NULL;
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_attachment_reader_free(zathura_attachment_reader_t* reader)
+{
+  if (reader == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (reader->fd != -1) {
+    close(reader->fd);
+  }
+
+  free(reader);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_attachment_reader_read(zathura_attachment_reader_t* reader, void*
+    buffer, size_t length, size_t* bytes_read)
+{
+  if (reader == NULL || buffer == NULL || bytes_read == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_attachment_t* attachment = reader->attachment;
+
+  length = MIN(length, attachment->size - reader->offset);
+  if (length == 0) {
+    *bytes_read = 0;
+    return ZATHURA_ERROR_OK;
+  }
+
+  zathura_error_t error = attachment_read(attachment, reader->fd,
+      reader->offset, buffer, length, bytes_read);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  /* The data ended before the announced size */
+  if (*bytes_read == 0 || *bytes_read > length) {
+    *bytes_read = 0;
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  reader->offset += *bytes_read;
 
   return ZATHURA_ERROR_OK;
 }
@@ -236,8 +621,7 @@ zathura_attachment_get_description(zathura_attachment_t* attachment, const
 }
 
 zathura_error_t
-zathura_attachment_get_size(zathura_attachment_t* attachment, unsigned int*
-    size)
+zathura_attachment_get_size(zathura_attachment_t* attachment, uint64_t* size)
 {
   if (attachment == NULL || size == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
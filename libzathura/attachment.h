@@ -7,11 +7,14 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
 #include <time.h>
 
 #include "error.h"
 
 typedef struct zathura_attachment_s zathura_attachment_t;
+typedef struct zathura_attachment_reader_s zathura_attachment_reader_t;
 
 /**
  * Create a new attachment object
@@ -36,7 +39,9 @@ zathura_error_t zathura_attachment_new(zathura_attachment_t** attachment);
 zathura_error_t zathura_attachment_free(zathura_attachment_t* attachment);
 
 /**
- * Sets the data of an attachment object
+ * Sets the data of an attachment object. The data is copied, plugins should
+ * prefer zathura_attachment_set_data_borrowed, zathura_attachment_set_data_file
+ * or zathura_attachment_set_read_function for large attachments.
  *
  * @param[in] attachment The attachment object
  * @param[in] data The data
@@ -44,22 +49,67 @@ zathura_error_t zathura_attachment_free(zathura_attachment_t* attachment);
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_attachment_set_data(zathura_attachment_t* attachment, const char* data, unsigned int size);
+zathura_error_t zathura_attachment_set_data(zathura_attachment_t* attachment, const char* data, size_t size);
 
 /**
- * Returns the data of an attachment object
+ * Returns the data of an attachment object. The data of file ranges is mapped
+ * into memory instead of being read. Attachments that are read by a function
+ * of the plugin have to be read with zathura_attachment_reader_read instead.
  *
  * @param[in] attachment The attachment object
- * @param[out] data The data
+ * @param[out] data The data, owned by the attachment
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
- * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ * @return ZATHURA_ERROR_UNKNOWN The data is not available in memory
  */
 zathura_error_t zathura_attachment_get_data(zathura_attachment_t* attachment, char** data);
 
+/**
+ * Creates a reader that reads the data of the attachment sequentially,
+ * whatever the data of the attachment comes from. The attachment must not be
+ * freed or changed while the reader is used.
+ *
+ * @param[out] reader The reader
+ * @param[in] attachment The attachment object
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The data could not be opened
+ */
+zathura_error_t zathura_attachment_reader_new(zathura_attachment_reader_t**
+    reader, zathura_attachment_t* attachment);
+
+/**
+ * Frees the reader.
+ *
+ * @param[in] reader The reader
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_attachment_reader_free(zathura_attachment_reader_t* reader);
+
+/**
+ * Reads the next bytes of the attachment. Fewer bytes than requested may be
+ * read, no bytes are read once the end of the attachment has been reached.
+ *
+ * @param[in] reader The reader
+ * @param[out] buffer The buffer
+ * @param[in] length The size of the buffer in bytes
+ * @param[out] bytes_read The number of read bytes, 0 at the end
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The data could not be read or ended early
+ */
+zathura_error_t zathura_attachment_reader_read(zathura_attachment_reader_t*
+    reader, void* buffer, size_t length, size_t* bytes_read);
+
 /**
  * Sets the name of the attachment. The name can be NULL but must not be an
  * empty string.
@@ -127,7 +177,9 @@ zathura_error_t zathura_attachment_set_modification_time(zathura_attachment_t* a
 zathura_error_t zathura_attachment_set_checksum(zathura_attachment_t* attachment, const char* checksum);
 
 /**
- * Saves the attachment to the given path
+ * Saves the attachment to the given path. Unless the plugin provides a custom
+ * save function, the data is written in chunks, or copied within the kernel
+ * for file ranges, so that the attachment is never held in memory as a whole.
  *
  * @param[in] attachment The attachment object
  * @param[in] path The path where the attachment should be saved to
@@ -173,7 +225,7 @@ zathura_error_t zathura_attachment_get_description(zathura_attachment_t*
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_attachment_get_size(zathura_attachment_t* attachment, unsigned int* size);
+zathura_error_t zathura_attachment_get_size(zathura_attachment_t* attachment, uint64_t* size);
 
 /**
  * Returns the creation time of the attachment
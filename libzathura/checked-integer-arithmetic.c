@@ -13,4 +13,13 @@ checked_umul(unsigned int lhs, unsigned int rhs, unsigned int* res)
 
   return r > UINT_MAX;
 }
+
+bool
+checked_uadd(unsigned int lhs, unsigned int rhs, unsigned int* res)
+{
+  const uint64_t r = (uint64_t) lhs + (uint64_t) rhs;
+  *res = (unsigned int) r;
+
+  return r > UINT_MAX;
+}
 #endif
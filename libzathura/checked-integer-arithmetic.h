@@ -19,6 +19,7 @@ extern "C" {
 
 #ifdef HAVE_BUILTIN
 #define checked_umul(lhs, rhs, res) __builtin_umul_overflow((lhs), (rhs), (res))
+#define checked_uadd(lhs, rhs, res) __builtin_uadd_overflow((lhs), (rhs), (res))
 #else
 /**
  * Helper function for multiplication with overflow detection. This function has
@@ -30,6 +31,17 @@ extern "C" {
  * @return true if an overflow occurred, false otherwise
  */
 HIDDEN bool checked_umul(unsigned int lhs, unsigned int rhs, unsigned int* res);
+
+/**
+ * Helper function for addition with overflow detection. This function has
+ * the same semantics as the __builtin_*add_overflow functions.
+ *
+ * @param[in] lhs first operand
+ * @param[in] rhs second operand
+ * @param[out] res result
+ * @return true if an overflow occurred, false otherwise
+ */
+HIDDEN bool checked_uadd(unsigned int lhs, unsigned int rhs, unsigned int* res);
 #endif
 
 #ifdef __cplusplus
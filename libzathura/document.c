@@ -1,5 +1,6 @@
 /* See LICENSE file for license and copyright information */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -7,6 +8,8 @@
 #include "internal.h"
 #include "document.h"
 #include "macros.h"
+#include "render-cache.h"
+#include "text-index.h"
 
 #define CHECK_IF_IMPLEMENTED(document, function) \
   if ((document)->plugin == NULL || \
@@ -14,6 +17,40 @@
     return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED; \
   }
 
+static void
+cb_render_cache_size_changed(zathura_options_t* UNUSED(options), const char*
+    name, const zathura_options_value_t* value, void* data)
+{
+  /* the callback is notified about all options of the document */
+  if (strcmp(name, "render-cache-size") != 0) {
+    return;
+  }
+
+  zathura_document_t* document = data;
+
+  zathura_render_cache_set_max_size(document->render_cache, value->u_int);
+}
+
+static zathura_error_t
+document_init_options(zathura_document_t* document)
+{
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  if ((error = zathura_options_new(&(document->options))) != ZATHURA_ERROR_OK ||
+      (error = zathura_options_add(document->options, "render-cache-size",
+        ZATHURA_OPTION_UINT)) != ZATHURA_ERROR_OK ||
+      (error = zathura_options_set_description(document->options,
+        "render-cache-size", "Memory budget of the render cache in bytes")) != ZATHURA_ERROR_OK ||
+      (error = zathura_options_set_value_uint(document->options,
+        "render-cache-size", ZATHURA_RENDER_CACHE_DEFAULT_SIZE)) != ZATHURA_ERROR_OK ||
+      (error = zathura_options_register_callback(document->options,
+        cb_render_cache_size_changed, document, NULL)) != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
 zathura_error_t
 zathura_document_new(zathura_document_t** document)
 {
@@ -26,6 +63,20 @@ zathura_document_new(zathura_document_t** document)
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
+  g_rec_mutex_init(&((*document)->lock));
+
+  (*document)->page_labels = g_hash_table_new_full(g_str_hash, g_str_equal,
+      g_free, NULL);
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  if ((error = zathura_render_cache_new(&((*document)->render_cache),
+          ZATHURA_RENDER_CACHE_DEFAULT_SIZE)) != ZATHURA_ERROR_OK ||
+      (error = document_init_options(*document)) != ZATHURA_ERROR_OK) {
+    zathura_document_free(*document);
+    *document = NULL;
+    return error;
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -39,7 +90,9 @@ zathura_document_free(zathura_document_t* document)
   /* free pages */
   if (document->pages != NULL) {
     for (unsigned int pid = 0; pid < document->number_of_pages; pid++) {
-      zathura_page_free(document->pages[pid]);
+      if (document->pages[pid] != NULL) {
+        zathura_page_free(document->pages[pid]);
+      }
     }
 
     free(document->pages);
@@ -52,11 +105,37 @@ zathura_document_free(zathura_document_t* document)
     document->plugin->functions.document_free(document);
   }
 
+  if (document->options != NULL) {
+    zathura_options_free(document->options);
+  }
+
+  zathura_render_cache_free(document->render_cache);
+
+  if (document->page_labels != NULL) {
+    g_hash_table_destroy(document->page_labels);
+  }
+
+  free(document->page_geometry);
+  zathura_text_index_free(document->text_index);
+  g_rec_mutex_clear(&(document->lock));
+
   free(document);
 
   return ZATHURA_ERROR_OK;
 }
 
+void
+zathura_document_lock(zathura_document_t* document)
+{
+  g_rec_mutex_lock(&(document->lock));
+}
+
+void
+zathura_document_unlock(zathura_document_t* document)
+{
+  g_rec_mutex_unlock(&(document->lock));
+}
+
 zathura_error_t
 zathura_document_set_user_data(zathura_document_t* document,
     void* user_data)
@@ -146,29 +225,78 @@ zathura_document_get_page(zathura_document_t* document, unsigned int index,
     return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX;
   }
 
+  /* Fast path: the page has already been created and published */
+  zathura_page_t* existing_page = g_atomic_pointer_get(&(document->pages[index]));
+  if (existing_page != NULL) {
+    *page = existing_page;
+    return ZATHURA_ERROR_OK;
+  }
+
+  /* Pages are created lazily on first access */
+  zathura_document_lock(document);
+
   if (document->pages[index] == NULL) {
-    zathura_error_t error = ZATHURA_ERROR_OK;
-    error = zathura_page_new(&(document->pages[index]));
+    zathura_page_t* new_page = NULL;
+    zathura_error_t error = zathura_page_new(&new_page);
     if (error != ZATHURA_ERROR_OK) {
+      zathura_document_unlock(document);
       return error;
     }
 
-    error = zathura_page_set_document(document->pages[index], document);
-    if (error != ZATHURA_ERROR_OK) {
+    if ((error = zathura_page_set_document(new_page, document)) != ZATHURA_ERROR_OK ||
+        (error = zathura_page_set_index(new_page, index)) != ZATHURA_ERROR_OK ||
+        (error = document->plugin->functions.page_init(new_page)) != ZATHURA_ERROR_OK) {
+      zathura_page_free(new_page);
+      zathura_document_unlock(document);
       return error;
     }
 
-    error = zathura_page_set_index(document->pages[index], index);
+    /* Only publish fully initialized pages */
+    g_atomic_pointer_set(&(document->pages[index]), new_page);
+  }
+
+  *page = document->pages[index];
+
+  zathura_document_unlock(document);
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Has to be called with the document lock held */
+static void
+document_add_page_label(zathura_document_t* document, unsigned int index,
+    const char* label)
+{
+  /* Like a linear search, the first page with the label wins */
+  gpointer value = g_hash_table_lookup(document->page_labels, label);
+  if (value == NULL || index < GPOINTER_TO_UINT(value) - 1) {
+    g_hash_table_replace(document->page_labels, g_strdup(label),
+        GUINT_TO_POINTER(index + 1));
+  }
+}
+
+/* Has to be called with the document lock held, indexes the pages before
+ * the given one */
+static zathura_error_t
+document_index_page_labels(zathura_document_t* document, unsigned int
+    number_of_pages)
+{
+  for (unsigned int i = 0; i < number_of_pages; i++) {
+    zathura_page_t* page = NULL;
+    zathura_error_t error = zathura_document_get_page(document, i, &page);
     if (error != ZATHURA_ERROR_OK) {
       return error;
     }
 
-    error = document->plugin->functions.page_init(document->pages[index]);
-    if (error != ZATHURA_ERROR_OK) {
-      return error;
+    /* Newly initialized pages have registered their label already, but the
+     * index may be rebuilt after a label has been removed */
+    if (page->label != NULL) {
+      document_add_page_label(document, i, page->label);
     }
-  } else {
-    *page = document->pages[index];
+  }
+
+  if (number_of_pages == document->number_of_pages) {
+    document->page_labels_complete = true;
   }
 
   return ZATHURA_ERROR_OK;
@@ -181,14 +309,58 @@ zathura_document_get_page_by_label(zathura_document_t* document, const char* lab
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  for (unsigned int i = 0; i < document->number_of_pages; i++) {
-    if (document->pages[i]->label != NULL && strcmp(document->pages[i]->label, label) == 0) {
-      *page = document->pages[i];
-      return ZATHURA_ERROR_OK;
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  /* Labels are set by the plugin while holding the document lock */
+  zathura_document_lock(document);
+
+  gpointer value = g_hash_table_lookup(document->page_labels, label);
+  if (document->page_labels_complete == false) {
+    /* Labels are only known after the page has been initialized. A hit might
+     * not be the first page with the label, so the pages before it are
+     * initialized; without a hit all pages are initialized once and register
+     * their labels. */
+    const unsigned int number_of_pages = (value != NULL) ?
+      GPOINTER_TO_UINT(value) - 1 : document->number_of_pages;
+    error = document_index_page_labels(document, number_of_pages);
+    if (error == ZATHURA_ERROR_OK) {
+      value = g_hash_table_lookup(document->page_labels, label);
+    }
+  }
+
+  if (error == ZATHURA_ERROR_OK && value == NULL) {
+    error = ZATHURA_ERROR_DOCUMENT_INVALID_LABEL;
+  }
+
+  if (error == ZATHURA_ERROR_OK) {
+    error = zathura_document_get_page(document, GPOINTER_TO_UINT(value) - 1, page);
+  }
+
+  zathura_document_unlock(document);
+
+  return error;
+}
+
+void
+zathura_document_page_label_changed(zathura_document_t* document, unsigned int
+    index, const char* old_label, const char* new_label)
+{
+  zathura_document_lock(document);
+
+  if (old_label != NULL) {
+    gpointer value = g_hash_table_lookup(document->page_labels, old_label);
+    if (value != NULL && GPOINTER_TO_UINT(value) - 1 == index) {
+      g_hash_table_remove(document->page_labels, old_label);
+      /* Another page may share the label, it is found by the next rebuild */
+      document->page_labels_complete = false;
     }
   }
 
-  return ZATHURA_ERROR_DOCUMENT_INVALID_LABEL;
+  if (new_label != NULL) {
+    document_add_page_label(document, index, new_label);
+  }
+
+  zathura_document_unlock(document);
 }
 
 zathura_error_t
@@ -280,7 +452,11 @@ zathura_document_save_as(zathura_document_t* document, const char* path)
 
   CHECK_IF_IMPLEMENTED(document, document_save_as)
 
-  return document->plugin->functions.document_save_as(document, path);
+  zathura_document_lock(document);
+  zathura_error_t error = document->plugin->functions.document_save_as(document, path);
+  zathura_document_unlock(document);
+
+  return error;
 }
 
 zathura_error_t
@@ -292,7 +468,11 @@ zathura_document_get_outline(zathura_document_t* document, zathura_node_t** outl
 
   CHECK_IF_IMPLEMENTED(document, document_get_outline)
 
-  return document->plugin->functions.document_get_outline(document, outline);
+  zathura_document_lock(document);
+  zathura_error_t error = document->plugin->functions.document_get_outline(document, outline);
+  zathura_document_unlock(document);
+
+  return error;
 }
 
 zathura_error_t
@@ -304,7 +484,11 @@ zathura_document_get_attachments(zathura_document_t* document, zathura_list_t**
 
   CHECK_IF_IMPLEMENTED(document, document_get_attachments)
 
-  return document->plugin->functions.document_get_attachments(document, attachments);
+  zathura_document_lock(document);
+  zathura_error_t error = document->plugin->functions.document_get_attachments(document, attachments);
+  zathura_document_unlock(document);
+
+  return error;
 }
 
 zathura_error_t
@@ -317,5 +501,114 @@ zathura_document_get_metadata(zathura_document_t* document, zathura_list_t**
 
   CHECK_IF_IMPLEMENTED(document, document_get_metadata)
 
-  return document->plugin->functions.document_get_metadata(document, metadata);
+  zathura_document_lock(document);
+  zathura_error_t error = document->plugin->functions.document_get_metadata(document, metadata);
+  zathura_document_unlock(document);
+
+  return error;
+}
+
+zathura_error_t
+zathura_document_get_options(zathura_document_t* document, zathura_options_t**
+    options)
+{
+  if (document == NULL || options == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *options = document->options;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_document_get_render_cache_statistics(zathura_document_t* document,
+    zathura_render_cache_statistics_t* statistics)
+{
+  if (document == NULL || statistics == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_render_cache_get_statistics(document->render_cache, statistics);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_page_geometry_t*
+document_page_geometry_new(unsigned int number_of_pages)
+{
+  /* All arrays share a single allocation following the header */
+  const size_t entry_size = 2 * sizeof(unsigned int) + sizeof(zathura_rectangle_t);
+  if (number_of_pages > (SIZE_MAX - sizeof(zathura_page_geometry_t)) / entry_size) {
+    return NULL;
+  }
+
+  zathura_page_geometry_t* geometry = calloc(1, sizeof(*geometry) +
+      number_of_pages * entry_size);
+  if (geometry == NULL) {
+    return NULL;
+  }
+
+  geometry->number_of_pages = number_of_pages;
+  geometry->crop_box = (zathura_rectangle_t*) (geometry + 1);
+  geometry->width    = (unsigned int*) (geometry->crop_box + number_of_pages);
+  geometry->height   = geometry->width + number_of_pages;
+
+  return geometry;
+}
+
+zathura_error_t
+zathura_document_get_page_geometry(zathura_document_t* document, const
+    zathura_page_geometry_t** geometry)
+{
+  if (document == NULL || geometry == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* Fast path: the geometry has already been collected */
+  zathura_page_geometry_t* existing_geometry = g_atomic_pointer_get(&(document->page_geometry));
+  if (existing_geometry != NULL) {
+    *geometry = existing_geometry;
+    return ZATHURA_ERROR_OK;
+  }
+
+  zathura_document_lock(document);
+
+  if (document->page_geometry == NULL) {
+    zathura_page_geometry_t* new_geometry = document_page_geometry_new(document->number_of_pages);
+    if (new_geometry == NULL) {
+      zathura_document_unlock(document);
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+
+    zathura_error_t error = ZATHURA_ERROR_OK;
+    if (document->plugin != NULL && document->plugin->functions.document_get_page_geometry != NULL) {
+      error = document->plugin->functions.document_get_page_geometry(document, new_geometry);
+    } else {
+      for (unsigned int i = 0; i < document->number_of_pages; i++) {
+        zathura_page_t* page = NULL;
+        if ((error = zathura_document_get_page(document, i, &page)) != ZATHURA_ERROR_OK) {
+          break;
+        }
+
+        new_geometry->width[i]    = page->width;
+        new_geometry->height[i]   = page->height;
+        new_geometry->crop_box[i] = page->crop_box;
+      }
+    }
+
+    if (error != ZATHURA_ERROR_OK) {
+      free(new_geometry);
+      zathura_document_unlock(document);
+      return error;
+    }
+
+    g_atomic_pointer_set(&(document->page_geometry), new_geometry);
+  }
+
+  *geometry = document->page_geometry;
+
+  zathura_document_unlock(document);
+
+  return ZATHURA_ERROR_OK;
 }
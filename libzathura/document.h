@@ -9,9 +9,13 @@ extern "C" {
 
 typedef struct zathura_document_s zathura_document_t;
 
+#include <stddef.h>
+
 #include "error.h"
 #include "list.h"
 #include "node.h"
+#include "options.h"
+#include "types.h"
 #include "page.h"
 
 typedef enum zathura_page_layout_e {
@@ -131,6 +135,28 @@ typedef enum zathura_document_permission_e {
   ZATHURA_PERMISSION_HIGH_RES_PRINT = 1 << 12,
 } zathura_document_permission_t;
 
+/**
+ * Statistics of the cache of rendered pages
+ */
+typedef struct zathura_render_cache_statistics_s {
+  unsigned int hits; /**< Number of renderings served from the cache */
+  unsigned int misses; /**< Number of renderings not found in the cache */
+  unsigned int number_of_entries; /**< Number of cached renderings */
+  size_t size; /**< Memory used by the cached renderings in bytes */
+  size_t max_size; /**< Memory budget of the cache in bytes */
+} zathura_render_cache_statistics_t;
+
+/**
+ * Geometry of all pages of a document, stored as one array per property that
+ * is indexed by the page index
+ */
+typedef struct zathura_page_geometry_s {
+  unsigned int number_of_pages; /**< Number of entries of each array */
+  unsigned int* width; /**< Widths of the pages */
+  unsigned int* height; /**< Heights of the pages */
+  zathura_rectangle_t* crop_box; /**< Crop boxes of the pages */
+} zathura_page_geometry_t;
+
 /**
  * Frees the given document
  *
@@ -186,6 +212,11 @@ zathura_error_t zathura_document_get_number_of_pages(zathura_document_t*
 /**
  * Returns the page object specified by the given @a id
  *
+ * Pages are created and initialized by the plugin on first access, so the
+ * first call for an index might be considerably slower than subsequent ones.
+ * This function may be called concurrently from multiple threads; every
+ * caller receives the same page object for an index.
+ *
  * @param[in] document The zathura document object
  * @param[in] index The index of the page that should be returned
  * @param[out] page The page that should be returned
@@ -199,7 +230,9 @@ zathura_error_t zathura_document_get_page(zathura_document_t* document, unsigned
     int index, zathura_page_t** page);
 
 /**
- * Returns the page object specified by the given @a label
+ * Returns the page object specified by the given @a label. If several pages
+ * share the label, the first one is returned. Labels are indexed, but the
+ * first lookup of an unknown label initializes all pages of the document.
  *
  * @param[in] document The zathura document object
  * @param[in] label The label of the page that should be returned
@@ -293,6 +326,54 @@ zathura_error_t zathura_document_get_metadata(zathura_document_t* document,
 zathura_error_t zathura_document_get_permissions(zathura_document_t* document,
     zathura_document_permission_t* permissions);
 
+/**
+ * Returns the options of the document. The following options are available:
+ *
+ * - ``render-cache-size`` (``ZATHURA_OPTION_UINT``): Memory budget in bytes of
+ *   the cache of rendered pages. A value of 0 disables the cache.
+ *
+ * @param[in] document The zathura document object
+ * @param[out] options The options of the document
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_document_get_options(zathura_document_t* document,
+    zathura_options_t** options);
+
+/**
+ * Returns the statistics of the cache of rendered pages
+ *
+ * @param[in] document The zathura document object
+ * @param[out] statistics The statistics of the cache
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_document_get_render_cache_statistics(zathura_document_t*
+    document, zathura_render_cache_statistics_t* statistics);
+
+/**
+ * Returns the dimensions and crop boxes of all pages, e.g. to lay out the
+ * document. If the plugin supports it, the geometry is queried without
+ * initializing the pages. Otherwise all pages are initialized once.
+ *
+ * The geometry is owned by the document and stays valid until the document is
+ * freed. It is kept up to date if the plugin changes the geometry of a page.
+ *
+ * @param[in] document The zathura document object
+ * @param[out] geometry The geometry of the pages
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not support
+ *  initializing pages
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_document_get_page_geometry(zathura_document_t*
+    document, const zathura_page_geometry_t** geometry);
+
 #ifdef __cplusplus
 }
 #endif
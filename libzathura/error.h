@@ -12,6 +12,7 @@ typedef enum zathura_error_e {
   ZATHURA_ERROR_UNKNOWN, /**< Unspecified error occurred */
   ZATHURA_ERROR_OUT_OF_MEMORY, /**< Out of memory */
   ZATHURA_ERROR_INVALID_ARGUMENTS, /**< Invalid arguments have been passed */
+  ZATHURA_ERROR_CANCELLED, /**< The operation has been cancelled */
 
   ZATHURA_ERROR_PLUGIN_RESOLVE_SYMBOL, /**< Could not resolve symbol */
   ZATHURA_ERROR_PLUGIN_VERSION, /**< Miss-matching version number */
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "arena.h"
 #include "internal.h"
 #include "form-fields.h"
 #include "form-fields/internal.h"
@@ -26,11 +27,15 @@ zathura_form_field_new(zathura_page_t* page, zathura_form_field_t** form_field,
       return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  *form_field = calloc(1, sizeof(**form_field));
+  zathura_arena_t* arena = zathura_arena_get_current();
+
+  *form_field = zathura_arena_calloc(arena, sizeof(**form_field));
   if (*form_field == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
+  (*form_field)->arena = arena;
+
   switch (type) {
     case ZATHURA_FORM_FIELD_UNKNOWN:
       break;
@@ -114,7 +119,7 @@ zathura_form_field_free(zathura_form_field_t* form_field)
       break;
   }
 
-  free(form_field);
+  zathura_arena_release(form_field->arena, form_field);
 
   return ZATHURA_ERROR_OK;
 }
@@ -142,6 +147,8 @@ zathura_form_field_set_position(zathura_form_field_t* form_field,
 
   form_field->position = position;
 
+  zathura_page_content_changed(form_field->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -328,7 +335,15 @@ zathura_form_field_save(zathura_form_field_t* form_field)
 
   CHECK_IF_IMPLEMENTED(form_field->page, form_field_save)
 
-  return form_field->page->document->plugin->functions.form_field_save(form_field);
+  zathura_document_lock(form_field->page->document);
+  zathura_error_t error = form_field->page->document->plugin->functions.form_field_save(form_field);
+  zathura_document_unlock(form_field->page->document);
+
+  if (error == ZATHURA_ERROR_OK) {
+    zathura_page_content_changed(form_field->page);
+  }
+
+  return error;
 }
 
 zathura_error_t
@@ -341,7 +356,20 @@ zathura_form_field_render(zathura_form_field_t* form_field,
 
   CHECK_IF_IMPLEMENTED(form_field->page, form_field_render)
 
-  return form_field->page->document->plugin->functions.form_field_render(form_field, buffer, scale);
+  zathura_document_t* document = form_field->page->document;
+
+  const bool serialize = zathura_page_should_serialize_render(form_field->page);
+  if (serialize == true) {
+    zathura_document_lock(document);
+  }
+
+  zathura_error_t error = document->plugin->functions.form_field_render(form_field, buffer, scale);
+
+  if (serialize == true) {
+    zathura_document_unlock(document);
+  }
+
+  return error;
 }
 
 #ifdef HAVE_CAIRO
@@ -355,6 +383,19 @@ zathura_form_field_render_cairo(zathura_form_field_t*
 
   CHECK_IF_IMPLEMENTED(form_field->page, form_field_render_cairo)
 
-  return form_field->page->document->plugin->functions.form_field_render_cairo(form_field, cairo, scale);
+  zathura_document_t* document = form_field->page->document;
+
+  const bool serialize = zathura_page_should_serialize_render(form_field->page);
+  if (serialize == true) {
+    zathura_document_lock(document);
+  }
+
+  zathura_error_t error = document->plugin->functions.form_field_render_cairo(form_field, cairo, scale);
+
+  if (serialize == true) {
+    zathura_document_unlock(document);
+  }
+
+  return error;
 }
 #endif
@@ -7,6 +7,7 @@
 #include "form-field-button.h"
 #include "../plugin-api/form-fields/form-field-button.h"
 #include "internal.h"
+#include "../internal.h"
 
 zathura_error_t
 zathura_form_field_button_set_type(zathura_form_field_t* form_field,
@@ -73,6 +74,8 @@ zathura_form_field_button_set_state(zathura_form_field_t* form_field, bool
 
   form_field->data.button.state = state;
 
+  zathura_page_content_changed(form_field->page);
+
   return ZATHURA_ERROR_OK;
 }
 
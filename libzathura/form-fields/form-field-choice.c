@@ -8,6 +8,7 @@
 #include "../plugin-api/form-fields/form-field-choice.h"
 #include "../plugin-api/form-fields/form-field-choice-item.h"
 #include "internal.h"
+#include "../internal.h"
 
 zathura_error_t
 zathura_form_field_choice_set_type(zathura_form_field_t* form_field,
@@ -278,6 +279,8 @@ zathura_form_field_choice_item_select(zathura_form_field_choice_item_t* choice_i
 
   choice_item->selected = true;
 
+  zathura_page_content_changed(choice_item->form_field->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -291,6 +294,8 @@ zathura_form_field_choice_item_deselect(zathura_form_field_choice_item_t*
 
   choice_item->selected = false;
 
+  zathura_page_content_changed(choice_item->form_field->page);
+
   return ZATHURA_ERROR_OK;
 }
 
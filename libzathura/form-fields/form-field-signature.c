@@ -7,6 +7,7 @@
 #include "form-field-signature.h"
 #include "../plugin-api/form-fields/form-field-signature.h"
 #include "internal.h"
+#include "../internal.h"
 
 zathura_error_t
 zathura_form_field_signature_set_signature(zathura_form_field_t* form_field,
@@ -20,6 +21,8 @@ zathura_form_field_signature_set_signature(zathura_form_field_t* form_field,
 
   form_field->data.signature.signature = signature;
 
+  zathura_page_content_changed(form_field->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -7,6 +7,7 @@
 #include "form-field-text.h"
 #include "../plugin-api/form-fields/form-field-text.h"
 #include "internal.h"
+#include "../internal.h"
 
 zathura_error_t
 zathura_form_field_text_set_type(zathura_form_field_t* form_field, zathura_form_field_text_type_t type)
@@ -213,6 +214,8 @@ zathura_form_field_text_set_text(zathura_form_field_t* form_field, const char*
 
   form_field->data.text.text = g_strdup(text);
 
+  zathura_page_content_changed(form_field->page);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -79,6 +79,11 @@ struct zathura_form_field_s {
    */
   zathura_page_t* page;
 
+  /**
+   * The arena the form field is allocated from or NULL
+   */
+  struct zathura_arena_s* arena;
+
   /**
    * User data
    */
@@ -1,31 +1,95 @@
 /* See LICENSE file for license and copyright information */
 
+#include <math.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#include <glib.h>
 
 #include "image-buffer.h"
+#include "internal.h"
 #include "plugin-api/image-buffer.h"
 #include "checked-integer-arithmetic.h"
 
 typedef struct zathura_image_buffer_s {
   unsigned char* data; /**< The image buffers data */
+  unsigned char* allocation; /**< The allocated memory containing the data */
+  zathura_image_buffer_destroy_function_t destroy_function; /**< Releases caller supplied data */
+  void* destroy_data; /**< Data passed to the destroy function */
+  zathura_image_buffer_pool_t* pool; /**< The pool the buffer belongs to */
   unsigned int height; /**< Height of the buffer */
   unsigned int width; /**< Width of the buffer */
-  unsigned int rowstride; /**< Rowstride of the buffer */
+  unsigned int rowstride; /**< Number of bytes between the start of two rows */
+  zathura_image_buffer_format_t format; /**< Pixel format of the buffer */
+  size_t size; /**< Size of the data in bytes */
+  gint ref_count; /**< Reference count */
 } image_buffer_t;
 
+struct zathura_image_buffer_pool_s {
+  GMutex lock; /**< Protects the idle buffers */
+  GQueue idle; /**< Released buffers, most recently released first */
+  unsigned int max_idle; /**< Maximum number of idle buffers */
+  bool closed; /**< The pool has been freed by its owner */
+  gint ref_count; /**< Owner and buffers belonging to the pool */
+};
+
+static void image_buffer_pool_unref(zathura_image_buffer_pool_t* pool);
+static bool image_buffer_pool_release(zathura_image_buffer_pool_t* pool,
+    zathura_image_buffer_t* buffer);
+
+static unsigned int
+format_get_bits_per_pixel(zathura_image_buffer_format_t format)
+{
+  switch (format) {
+    case ZATHURA_IMAGE_BUFFER_FORMAT_RGB24:
+      return 24;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32:
+    case ZATHURA_IMAGE_BUFFER_FORMAT_ARGB32_PREMULTIPLIED:
+      return 32;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8:
+      return 8;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_MONO1:
+      return 1;
+  }
+
+  return 0;
+}
+
 zathura_error_t
 zathura_image_buffer_new(zathura_image_buffer_t** buffer, unsigned int width,
     unsigned int height)
 {
-  if (buffer == NULL || width == 0 || height == 0) {
+  return zathura_image_buffer_new_with_format(buffer, width, height,
+      ZATHURA_IMAGE_BUFFER_FORMAT_RGB24);
+}
+
+zathura_error_t
+zathura_image_buffer_new_with_format(zathura_image_buffer_t** buffer,
+    unsigned int width, unsigned int height, zathura_image_buffer_format_t
+    format)
+{
+  const unsigned int bits_per_pixel = format_get_bits_per_pixel(format);
+  if (buffer == NULL || width == 0 || height == 0 || bits_per_pixel == 0) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  /* Check for malicious input */
-  unsigned int size = 0;
-  if (checked_umul(width, height, &size) == true ||
-      checked_umul(size, ZATHURA_IMAGE_BUFFER_ROWSTRIDE, &size) == true) {
+  /* Check for malicious input; rows are padded to the alignment and the
+   * allocation has room to align the start of the data */
+  const unsigned int alignment = ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT;
+  unsigned int row_bits   = 0;
+  unsigned int rowstride  = 0;
+  unsigned int size       = 0;
+  unsigned int allocation = 0;
+  if (checked_umul(width, bits_per_pixel, &row_bits) == true ||
+      checked_uadd(row_bits, alignment * 8 - 1, &rowstride) == true) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  rowstride = rowstride / (alignment * 8) * alignment;
+
+  if (checked_umul(rowstride, height, &size) == true ||
+      checked_uadd(size, alignment - 1, &allocation) == true) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
@@ -33,18 +97,71 @@ zathura_image_buffer_new(zathura_image_buffer_t** buffer, unsigned int width,
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
-  if (((*buffer)->data = calloc(size, sizeof(unsigned char))) == NULL) {
+  if (((*buffer)->allocation = calloc(allocation, sizeof(unsigned char))) == NULL) {
     free(*buffer);
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
+  (*buffer)->data = (unsigned char*) (((uintptr_t) (*buffer)->allocation +
+        alignment - 1) & ~((uintptr_t) alignment - 1));
   (*buffer)->height    = height;
   (*buffer)->width     = width;
-  (*buffer)->rowstride = ZATHURA_IMAGE_BUFFER_ROWSTRIDE;
+  (*buffer)->rowstride = rowstride;
+  (*buffer)->format    = format;
+  (*buffer)->size      = size;
+  (*buffer)->ref_count = 1;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_image_buffer_new_from_data(zathura_image_buffer_t** buffer,
+    unsigned char* data, unsigned int width, unsigned int height, unsigned int
+    rowstride, zathura_image_buffer_format_t format,
+    zathura_image_buffer_destroy_function_t destroy_function, void*
+    destroy_data)
+{
+  const unsigned int bits_per_pixel = format_get_bits_per_pixel(format);
+  if (buffer == NULL || data == NULL || width == 0 || height == 0 ||
+      bits_per_pixel == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* Rows have to hold all pixels */
+  unsigned int size = 0;
+  const uint64_t row_size = ((uint64_t) width * bits_per_pixel + 7) / 8;
+  if (rowstride < row_size || checked_umul(rowstride, height, &size) == true) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if ((*buffer = calloc(1, sizeof(**buffer))) == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*buffer)->data             = data;
+  (*buffer)->destroy_function = destroy_function;
+  (*buffer)->destroy_data     = destroy_data;
+  (*buffer)->height           = height;
+  (*buffer)->width            = width;
+  (*buffer)->rowstride        = rowstride;
+  (*buffer)->format           = format;
+  (*buffer)->size             = size;
+  (*buffer)->ref_count        = 1;
 
   return ZATHURA_ERROR_OK;
 }
 
+static void
+image_buffer_destroy(zathura_image_buffer_t* buffer)
+{
+  if (buffer->destroy_function != NULL) {
+    buffer->destroy_function(buffer->destroy_data);
+  }
+
+  free(buffer->allocation);
+  free(buffer);
+}
+
 zathura_error_t
 zathura_image_buffer_free(zathura_image_buffer_t* buffer)
 {
@@ -52,12 +169,295 @@ zathura_image_buffer_free(zathura_image_buffer_t* buffer)
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  free(buffer->data);
-  free(buffer);
+  if (g_atomic_int_dec_and_test(&buffer->ref_count) == FALSE) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  /* Pooled buffers are kept for reuse */
+  if (buffer->pool != NULL && image_buffer_pool_release(buffer->pool, buffer) == true) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  image_buffer_destroy(buffer);
 
   return ZATHURA_ERROR_OK;
 }
 
+zathura_image_buffer_t*
+zathura_image_buffer_ref(zathura_image_buffer_t* buffer)
+{
+  if (buffer == NULL) {
+    return NULL;
+  }
+
+  g_atomic_int_inc(&buffer->ref_count);
+
+  return buffer;
+}
+
+zathura_error_t
+zathura_image_buffer_crop(zathura_image_buffer_t* buffer,
+    zathura_image_buffer_t** region, unsigned int x, unsigned int y, unsigned
+    int width, unsigned int height)
+{
+  if (buffer == NULL || region == NULL || width == 0 || height == 0 ||
+      x >= buffer->width || y >= buffer->height ||
+      width > buffer->width - x || height > buffer->height - y) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = zathura_image_buffer_new_with_format(region, width,
+      height, buffer->format);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  const unsigned int bits_per_pixel = format_get_bits_per_pixel(buffer->format);
+
+  for (unsigned int row = 0; row < height; row++) {
+    const unsigned char* source = buffer->data + ((size_t) y + row) * buffer->rowstride;
+    unsigned char* target = (*region)->data + (size_t) row * (*region)->rowstride;
+
+    if (bits_per_pixel % 8 == 0) {
+      const size_t bytes_per_pixel = bits_per_pixel / 8;
+      memcpy(target, source + x * bytes_per_pixel, width * bytes_per_pixel);
+    } else {
+      /* 1 bit per pixel, most significant bit first */
+      for (unsigned int column = 0; column < width; column++) {
+        const unsigned int bit = x + column;
+        if ((source[bit / 8] & (0x80 >> (bit % 8))) != 0) {
+          target[column / 8] |= 0x80 >> (column % 8);
+        }
+      }
+    }
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+static void
+pixel_read(zathura_image_buffer_format_t format, const unsigned char* row,
+    unsigned int x, uint8_t rgba[4])
+{
+  switch (format) {
+    case ZATHURA_IMAGE_BUFFER_FORMAT_RGB24:
+      rgba[0] = row[3 * x];
+      rgba[1] = row[3 * x + 1];
+      rgba[2] = row[3 * x + 2];
+      rgba[3] = 0xFF;
+      break;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32:
+      rgba[0] = row[4 * x + 2];
+      rgba[1] = row[4 * x + 1];
+      rgba[2] = row[4 * x];
+      rgba[3] = row[4 * x + 3];
+      break;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_ARGB32_PREMULTIPLIED: {
+      uint32_t value;
+      memcpy(&value, row + 4 * x, sizeof(value));
+      rgba[3] = value >> 24;
+      for (unsigned int i = 0; i < 3; i++) {
+        const unsigned int color = (value >> (16 - 8 * i)) & 0xFF;
+        rgba[i] = (rgba[3] == 0) ? 0 : MIN(color * 0xFF / rgba[3], 0xFF);
+      }
+      break;
+    }
+    case ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8:
+      rgba[0] = rgba[1] = rgba[2] = row[x];
+      rgba[3] = 0xFF;
+      break;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_MONO1:
+      rgba[0] = rgba[1] = rgba[2] = ((row[x / 8] & (0x80 >> (x % 8))) != 0) ? 0xFF : 0;
+      rgba[3] = 0xFF;
+      break;
+  }
+}
+
+static void
+pixel_write(zathura_image_buffer_format_t format, unsigned char* row,
+    unsigned int x, const uint8_t rgba[4])
+{
+  const unsigned int luminance = (rgba[0] * 77 + rgba[1] * 150 + rgba[2] * 29) >> 8;
+
+  switch (format) {
+    case ZATHURA_IMAGE_BUFFER_FORMAT_RGB24:
+      row[3 * x]     = rgba[0];
+      row[3 * x + 1] = rgba[1];
+      row[3 * x + 2] = rgba[2];
+      break;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32:
+      row[4 * x]     = rgba[2];
+      row[4 * x + 1] = rgba[1];
+      row[4 * x + 2] = rgba[0];
+      row[4 * x + 3] = rgba[3];
+      break;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_ARGB32_PREMULTIPLIED: {
+      uint32_t value = (uint32_t) rgba[3] << 24;
+      for (unsigned int i = 0; i < 3; i++) {
+        value |= (uint32_t) (rgba[i] * rgba[3] / 0xFF) << (16 - 8 * i);
+      }
+      memcpy(row + 4 * x, &value, sizeof(value));
+      break;
+    }
+    case ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8:
+      row[x] = luminance;
+      break;
+    case ZATHURA_IMAGE_BUFFER_FORMAT_MONO1:
+      if (luminance >= 0x80) {
+        row[x / 8] |= 0x80 >> (x % 8);
+      } else {
+        row[x / 8] &= ~(0x80 >> (x % 8));
+      }
+      break;
+  }
+}
+
+zathura_error_t
+zathura_image_buffer_copy_pixels(zathura_image_buffer_t* source,
+    zathura_image_buffer_t* target)
+{
+  if (source == NULL || target == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  const unsigned int width  = MIN(source->width, target->width);
+  const unsigned int height = MIN(source->height, target->height);
+  const unsigned int bits_per_pixel = format_get_bits_per_pixel(source->format);
+
+  for (unsigned int row = 0; row < height; row++) {
+    const unsigned char* source_row = source->data + (size_t) row * source->rowstride;
+    unsigned char* target_row = target->data + (size_t) row * target->rowstride;
+
+    if (source->format == target->format && bits_per_pixel % 8 == 0) {
+      memcpy(target_row, source_row, (size_t) width * (bits_per_pixel / 8));
+      continue;
+    }
+
+    for (unsigned int column = 0; column < width; column++) {
+      uint8_t rgba[4];
+      pixel_read(source->format, source_row, column, rgba);
+      pixel_write(target->format, target_row, column, rgba);
+    }
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* The blend function B(cb, cs) of the PDF specification for colors in [0, 1] */
+static double
+blend_color(zathura_blend_mode_t blend_mode, double cb, double cs)
+{
+  switch (blend_mode) {
+    case ZATHURA_BLEND_MODE_NORMAL:
+      return cs;
+    case ZATHURA_BLEND_MODE_MULTIPLY:
+      return cb * cs;
+    case ZATHURA_BLEND_MODE_SCREEN:
+      return cb + cs - cb * cs;
+    case ZATHURA_BLEND_MODE_OVERLAY:
+      return blend_color(ZATHURA_BLEND_MODE_HARD_LIGHT, cs, cb);
+    case ZATHURA_BLEND_MODE_DARKEN:
+      return MIN(cb, cs);
+    case ZATHURA_BLEND_MODE_LIGHTEN:
+      return MAX(cb, cs);
+    case ZATHURA_BLEND_MODE_COLOR_DODGE:
+      if (cb <= 0.0) {
+        return 0.0;
+      }
+      return (cs >= 1.0) ? 1.0 : MIN(1.0, cb / (1.0 - cs));
+    case ZATHURA_BLEND_MODE_COLOR_BURN:
+      if (cb >= 1.0) {
+        return 1.0;
+      }
+      return (cs <= 0.0) ? 0.0 : 1.0 - MIN(1.0, (1.0 - cb) / cs);
+    case ZATHURA_BLEND_MODE_HARD_LIGHT:
+      if (cs <= 0.5) {
+        return cb * 2.0 * cs;
+      }
+      return blend_color(ZATHURA_BLEND_MODE_SCREEN, cb, 2.0 * cs - 1.0);
+    case ZATHURA_BLEND_MODE_SOFT_LIGHT: {
+      if (cs <= 0.5) {
+        return cb - (1.0 - 2.0 * cs) * cb * (1.0 - cb);
+      }
+      const double d = (cb <= 0.25) ? ((16.0 * cb - 12.0) * cb + 4.0) * cb : sqrt(cb);
+      return cb + (2.0 * cs - 1.0) * (d - cb);
+    }
+    case ZATHURA_BLEND_MODE_DIFFERENCE:
+      return fabs(cb - cs);
+    case ZATHURA_BLEND_MODE_EXCLUSION:
+      return cb + cs - 2.0 * cb * cs;
+  }
+
+  return cs;
+}
+
+zathura_error_t
+zathura_image_buffer_blend(zathura_image_buffer_t* source, unsigned int
+    source_x, unsigned int source_y, zathura_image_buffer_t* target, unsigned
+    int target_x, unsigned int target_y, unsigned int width, unsigned int
+    height, zathura_blend_mode_t blend_mode, double opacity)
+{
+  if (source == NULL || target == NULL || opacity < 0.0 || opacity > 1.0 ||
+      source_x > source->width || width > source->width - source_x ||
+      source_y > source->height || height > source->height - source_y ||
+      target_x > target->width || width > target->width - target_x ||
+      target_y > target->height || height > target->height - target_y) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  for (unsigned int row = 0; row < height; row++) {
+    const unsigned char* source_row = source->data + (size_t) (source_y + row) * source->rowstride;
+    unsigned char* target_row = target->data + (size_t) (target_y + row) * target->rowstride;
+
+    for (unsigned int column = 0; column < width; column++) {
+      uint8_t source_rgba[4];
+      pixel_read(source->format, source_row, source_x + column, source_rgba);
+
+      /* Transparent pixels leave the target untouched */
+      const double as = source_rgba[3] / 255.0 * opacity;
+      if (as <= 0.0) {
+        continue;
+      }
+
+      /* Opaque pixels in normal mode replace the target */
+      if (blend_mode == ZATHURA_BLEND_MODE_NORMAL && source_rgba[3] == 0xFF && opacity >= 1.0) {
+        pixel_write(target->format, target_row, target_x + column, source_rgba);
+        continue;
+      }
+
+      uint8_t target_rgba[4];
+      pixel_read(target->format, target_row, target_x + column, target_rgba);
+
+      const double ab = target_rgba[3] / 255.0;
+      const double ar = as + ab - as * ab;
+
+      uint8_t result_rgba[4];
+      for (unsigned int i = 0; i < 3; i++) {
+        const double cs = source_rgba[i] / 255.0;
+        const double cb = target_rgba[i] / 255.0;
+        const double mixed = (1.0 - ab) * cs + ab * blend_color(blend_mode, cb, cs);
+        const double cr = ((1.0 - as) * ab * cb + as * mixed) / ar;
+        result_rgba[i] = lround(CLAMP(cr, 0.0, 1.0) * 255.0);
+      }
+      result_rgba[3] = lround(ar * 255.0);
+
+      pixel_write(target->format, target_row, target_x + column, result_rgba);
+    }
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+size_t
+zathura_image_buffer_get_size(zathura_image_buffer_t* buffer)
+{
+  if (buffer == NULL) {
+    return 0;
+  }
+
+  return buffer->size;
+}
+
 zathura_error_t
 zathura_image_buffer_get_data(zathura_image_buffer_t* buffer, unsigned char**
     data)
@@ -105,6 +505,13 @@ zathura_image_buffer_set_rowstride(zathura_image_buffer_t* buffer, unsigned int
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  /* Rows have to hold all pixels and fit into the allocated data */
+  const size_t row_size = ((size_t) buffer->width *
+      format_get_bits_per_pixel(buffer->format) + 7) / 8;
+  if (rowstride < row_size || (size_t) rowstride * buffer->height > buffer->size) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
   buffer->rowstride = rowstride;
 
   return ZATHURA_ERROR_OK;
@@ -122,3 +529,152 @@ zathura_image_buffer_get_rowstride(zathura_image_buffer_t* buffer, unsigned int*
 
   return ZATHURA_ERROR_OK;
 }
+
+zathura_error_t
+zathura_image_buffer_get_format(zathura_image_buffer_t* buffer,
+    zathura_image_buffer_format_t* format)
+{
+  if (buffer == NULL || format == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *format = buffer->format;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_image_buffer_pool_new(zathura_image_buffer_pool_t** pool, unsigned int
+    max_idle)
+{
+  if (pool == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if ((*pool = calloc(1, sizeof(**pool))) == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  g_mutex_init(&((*pool)->lock));
+  g_queue_init(&((*pool)->idle));
+  (*pool)->max_idle  = max_idle;
+  (*pool)->ref_count = 1;
+
+  return ZATHURA_ERROR_OK;
+}
+
+static void
+image_buffer_pool_unref(zathura_image_buffer_pool_t* pool)
+{
+  if (g_atomic_int_dec_and_test(&pool->ref_count) == FALSE) {
+    return;
+  }
+
+  g_mutex_clear(&pool->lock);
+  free(pool);
+}
+
+/* Destroys a buffer that has been removed from the pool */
+static void
+image_buffer_pool_destroy_buffer(zathura_image_buffer_t* buffer)
+{
+  zathura_image_buffer_pool_t* pool = buffer->pool;
+
+  buffer->pool = NULL;
+  image_buffer_destroy(buffer);
+  image_buffer_pool_unref(pool);
+}
+
+static bool
+image_buffer_pool_release(zathura_image_buffer_pool_t* pool,
+    zathura_image_buffer_t* buffer)
+{
+  g_mutex_lock(&pool->lock);
+
+  if (pool->closed == true || pool->max_idle == 0) {
+    g_mutex_unlock(&pool->lock);
+    image_buffer_pool_destroy_buffer(buffer);
+    return true;
+  }
+
+  g_queue_push_head(&pool->idle, buffer);
+
+  zathura_image_buffer_t* evicted = NULL;
+  if (g_queue_get_length(&pool->idle) > pool->max_idle) {
+    evicted = g_queue_pop_tail(&pool->idle);
+  }
+
+  g_mutex_unlock(&pool->lock);
+
+  if (evicted != NULL) {
+    image_buffer_pool_destroy_buffer(evicted);
+  }
+
+  return true;
+}
+
+zathura_error_t
+zathura_image_buffer_pool_free(zathura_image_buffer_pool_t* pool)
+{
+  if (pool == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_mutex_lock(&pool->lock);
+  pool->closed = true;
+  GList* idle = pool->idle.head;
+  g_queue_init(&pool->idle);
+  g_mutex_unlock(&pool->lock);
+
+  /* Buffers still in use are destroyed once they are released */
+  for (GList* link = idle; link != NULL; link = link->next) {
+    image_buffer_pool_destroy_buffer(link->data);
+  }
+  g_list_free(idle);
+
+  image_buffer_pool_unref(pool);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_image_buffer_pool_acquire(zathura_image_buffer_pool_t* pool,
+    zathura_image_buffer_t** buffer, unsigned int width, unsigned int height,
+    zathura_image_buffer_format_t format)
+{
+  if (pool == NULL || buffer == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_mutex_lock(&pool->lock);
+
+  for (GList* link = pool->idle.head; link != NULL; link = link->next) {
+    zathura_image_buffer_t* idle_buffer = link->data;
+    if (idle_buffer->width == width && idle_buffer->height == height &&
+        idle_buffer->format == format) {
+      g_queue_delete_link(&pool->idle, link);
+      g_mutex_unlock(&pool->lock);
+
+      /* Undo zathura_image_buffer_set_rowstride of the previous user; pooled
+       * buffers are allocated with rows of the default rowstride */
+      idle_buffer->rowstride = idle_buffer->size / idle_buffer->height;
+      idle_buffer->ref_count = 1;
+      *buffer = idle_buffer;
+
+      return ZATHURA_ERROR_OK;
+    }
+  }
+
+  g_mutex_unlock(&pool->lock);
+
+  zathura_error_t error = zathura_image_buffer_new_with_format(buffer, width,
+      height, format);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  g_atomic_int_inc(&pool->ref_count);
+  (*buffer)->pool = pool;
+
+  return ZATHURA_ERROR_OK;
+}
@@ -9,12 +9,57 @@ extern "C" {
 
 #include "error.h"
 
-#define ZATHURA_IMAGE_BUFFER_ROWSTRIDE 3
+/**
+ * Alignment in bytes of the data and of every row of an image buffer
+ */
+#define ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT 64
 
 typedef struct zathura_image_buffer_s zathura_image_buffer_t;
+typedef struct zathura_image_buffer_pool_s zathura_image_buffer_pool_t;
 
 /**
- * Creates an image buffer with the given @a width and @a height
+ * Function releasing caller supplied data of an image buffer
+ *
+ * @param[in] data The data passed to @ref zathura_image_buffer_new_from_data
+ */
+typedef void (*zathura_image_buffer_destroy_function_t)(void* data);
+
+/**
+ * Pixel formats of an image buffer
+ */
+typedef enum zathura_image_buffer_format_e {
+  /**
+   * 24 bits per pixel, stored as red, green and blue bytes
+   */
+  ZATHURA_IMAGE_BUFFER_FORMAT_RGB24,
+
+  /**
+   * 32 bits per pixel, stored as blue, green, red and alpha bytes
+   */
+  ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32,
+
+  /**
+   * 32 bits per pixel stored as native-endian 32-bit value with alpha in the
+   * upper 8 bits, followed by red, green and blue. The colors are
+   * premultiplied with alpha. This matches CAIRO_FORMAT_ARGB32.
+   */
+  ZATHURA_IMAGE_BUFFER_FORMAT_ARGB32_PREMULTIPLIED,
+
+  /**
+   * 8 bits per pixel, stored as gray value
+   */
+  ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8,
+
+  /**
+   * 1 bit per pixel, stored with the leftmost pixel in the most significant
+   * bit of a byte
+   */
+  ZATHURA_IMAGE_BUFFER_FORMAT_MONO1
+} zathura_image_buffer_format_t;
+
+/**
+ * Creates an image buffer with the given @a width and @a height in the @ref
+ * ZATHURA_IMAGE_BUFFER_FORMAT_RGB24 format
  *
  * @param[out] buffer The image buffer
  * @param[in] width The width of the image
@@ -28,7 +73,54 @@ typedef struct zathura_image_buffer_s zathura_image_buffer_t;
 zathura_error_t zathura_image_buffer_new(zathura_image_buffer_t** buffer, unsigned int width, unsigned int height);
 
 /**
- * Frees the image buffer
+ * Creates an image buffer with the given @a width, @a height and pixel
+ * @a format. The data and every row of the buffer are aligned to
+ * @ref ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT bytes; the number of bytes per row is
+ * returned by @ref zathura_image_buffer_get_rowstride.
+ *
+ * @param[out] buffer The image buffer
+ * @param[in] width The width of the image
+ * @param[in] height The height of the image
+ * @param[in] format The pixel format of the image
+ *
+ * @return @ref ZATHURA_ERROR_OK No error occurred
+ * @return @ref ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been
+ *  passed
+ * @return @ref ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_image_buffer_new_with_format(zathura_image_buffer_t**
+    buffer, unsigned int width, unsigned int height,
+    zathura_image_buffer_format_t format);
+
+/**
+ * Creates an image buffer for memory owned by the caller, e.g. shared memory or
+ * a mapped DMA buffer. The data is neither copied nor cleared. Once the last
+ * reference of the buffer has been released, @a destroy_function is called
+ * with @a destroy_data.
+ *
+ * @param[out] buffer The image buffer
+ * @param[in] data The pixel data
+ * @param[in] width The width of the image
+ * @param[in] height The height of the image
+ * @param[in] rowstride The number of bytes between the start of two rows
+ * @param[in] format The pixel format of the image
+ * @param[in] destroy_function Function releasing the data or NULL
+ * @param[in] destroy_data Data passed to @a destroy_function
+ *
+ * @return @ref ZATHURA_ERROR_OK No error occurred
+ * @return @ref ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been
+ *  passed
+ * @return @ref ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_image_buffer_new_from_data(zathura_image_buffer_t**
+    buffer, unsigned char* data, unsigned int width, unsigned int height,
+    unsigned int rowstride, zathura_image_buffer_format_t format,
+    zathura_image_buffer_destroy_function_t destroy_function, void*
+    destroy_data);
+
+/**
+ * Releases a reference of the image buffer. The buffer is freed once the last
+ * reference has been released.
  *
  * @param[in] buffer The image buffer
  *
@@ -38,6 +130,16 @@ zathura_error_t zathura_image_buffer_new(zathura_image_buffer_t** buffer, unsign
  */
 zathura_error_t zathura_image_buffer_free(zathura_image_buffer_t* buffer);
 
+/**
+ * Acquires an additional reference of the image buffer. Every reference has to
+ * be released with @ref zathura_image_buffer_free.
+ *
+ * @param[in] buffer The image buffer
+ *
+ * @return The image buffer or NULL if @a buffer is NULL
+ */
+zathura_image_buffer_t* zathura_image_buffer_ref(zathura_image_buffer_t* buffer);
+
 /**
  * Retrieves the data of the image buffer
  *
@@ -75,7 +177,8 @@ zathura_error_t zathura_image_buffer_get_height(zathura_image_buffer_t* buffer,
 zathura_error_t zathura_image_buffer_get_width(zathura_image_buffer_t* buffer, unsigned int* width);
 
 /**
- * Retrieves the rowstride of the image buffer
+ * Retrieves the rowstride of the image buffer, i.e. the number of bytes
+ * between the start of two consecutive rows
  *
  * @param[in] buffer The image buffer
  * @param[out] rowstride The rowstride of the buffer
@@ -86,6 +189,68 @@ zathura_error_t zathura_image_buffer_get_width(zathura_image_buffer_t* buffer, u
  */
 zathura_error_t zathura_image_buffer_get_rowstride(zathura_image_buffer_t* buffer, unsigned int* rowstride);
 
+/**
+ * Retrieves the pixel format of the image buffer
+ *
+ * @param[in] buffer The image buffer
+ * @param[out] format The pixel format of the buffer
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return @ref ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been
+ *  passed
+ */
+zathura_error_t zathura_image_buffer_get_format(zathura_image_buffer_t* buffer,
+    zathura_image_buffer_format_t* format);
+
+/**
+ * Creates a pool of image buffers. Buffers acquired from the pool return to it
+ * once their last reference has been released with @ref
+ * zathura_image_buffer_free and are handed out again for the same dimensions
+ * and format, without allocating or clearing memory.
+ *
+ * @param[out] pool The buffer pool
+ * @param[in] max_idle Maximum number of released buffers kept for reuse
+ *
+ * @return @ref ZATHURA_ERROR_OK No error occurred
+ * @return @ref ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been
+ *  passed
+ * @return @ref ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_image_buffer_pool_new(zathura_image_buffer_pool_t**
+    pool, unsigned int max_idle);
+
+/**
+ * Frees the buffer pool. Buffers that are still in use stay valid and are
+ * freed once they are released.
+ *
+ * @param[in] pool The buffer pool
+ *
+ * @return @ref ZATHURA_ERROR_OK No error occurred
+ * @return @ref ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been
+ *  passed
+ */
+zathura_error_t zathura_image_buffer_pool_free(zathura_image_buffer_pool_t* pool);
+
+/**
+ * Acquires an image buffer from the pool. A previously released buffer with
+ * the same dimensions and format is reused if available, its content is
+ * undefined. Otherwise a new buffer is created.
+ *
+ * @param[in] pool The buffer pool
+ * @param[out] buffer The image buffer
+ * @param[in] width The width of the image
+ * @param[in] height The height of the image
+ * @param[in] format The pixel format of the image
+ *
+ * @return @ref ZATHURA_ERROR_OK No error occurred
+ * @return @ref ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been
+ *  passed
+ * @return @ref ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_image_buffer_pool_acquire(zathura_image_buffer_pool_t*
+    pool, zathura_image_buffer_t** buffer, unsigned int width, unsigned int
+    height, zathura_image_buffer_format_t format);
+
 #ifdef __cplusplus
 }
 #endif
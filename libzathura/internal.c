@@ -8,11 +8,6 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <gio/gio.h>
-#include <sys/wait.h>
-
-#ifdef WITH_MAGIC
-#include <magic.h>
-#endif
 
 #include "internal.h"
 #include "fiu-local.h"
@@ -50,169 +45,19 @@ zathura_realpath(const char* path, char** real_path)
   return ZATHURA_ERROR_OK;
 }
 
-#ifdef WITH_MAGIC
-static char*
-guess_type_magic(const char* path) {
-  if (path == NULL || strlen(path) == 0) {
-    return NULL;
-  }
-
-  char* mime_type = NULL;
-
-  /* creat magic cookie */
-  const int flags =
-    MAGIC_MIME_TYPE |
-    MAGIC_SYMLINK |
-    MAGIC_NO_CHECK_APPTYPE |
-    MAGIC_NO_CHECK_CDF |
-    MAGIC_NO_CHECK_ELF |
-    MAGIC_NO_CHECK_ENCODING;
-  magic_t magic = magic_open(flags);
-  if (magic == NULL) {
-    goto cleanup;
-  }
-
-  /* ... and load mime database */
-  if (magic_load(magic, NULL) < 0) {
-    goto cleanup;
-  }
-
-  /* get the mime type */
-  const char* cmime_type = magic_file(magic, path);
-  if (cmime_type == NULL) {
-    goto cleanup;
-  }
-
-  /* dup so we own the memory */
-  mime_type = g_strdup(cmime_type);
-
-cleanup:
-
-  if (magic != NULL) {
-    magic_close(magic);
-  }
-
-  return mime_type;
-}
-#endif
-
-static char*
-guess_type_file(const char* path)
-{
-  if (path == NULL || strlen(path) == 0) {
-    return NULL;
-  }
-
-  GString* command = g_string_new("file -b --mime-type ");
-  char* tmp        = g_shell_quote(path);
-
-  g_string_append(command, tmp);
-  g_free(tmp);
-
-  GError* error = NULL;
-  char* out = NULL;
-  int ret = 0;
-  g_spawn_command_line_sync(command->str, &out, NULL, &ret, &error);
-  g_string_free(command, TRUE);
-
-  if (error != NULL) {
-    g_error_free(error);
-    g_free(out);
-    return NULL;
-  }
-
-  if (WEXITSTATUS(ret) != 0) {
-    g_free(out);
-    return NULL;
-  }
-
-  g_strdelimit(out, "\n\r", '\0');
-  return out;
-}
-
-static char*
-guess_type_glib(const char* path)
-{
-  if (path == NULL || strlen(path) == 0) {
-    return NULL;
-  }
-
-  gboolean uncertain = FALSE;
-  char* content_type = g_content_type_guess(path, NULL, 0, &uncertain);
-  if (content_type != NULL) {
-    if (uncertain == FALSE) {
-      return content_type;
-    } else {
-      g_free(content_type);
-      content_type = NULL;
-    }
-  }
-
-  FILE* f = fopen(path, "rb");
-  if (f == NULL) {
-    return NULL;
-  }
-
-  const int fd = fileno(f);
-  guchar* content = NULL;
-  size_t length = 0u;
-  ssize_t bytes_read = -1;
-  while (uncertain == TRUE && length < GT_MAX_READ && bytes_read != 0) {
-    g_free(content_type);
-    content_type = NULL;
-
-    guchar* temp_content = g_try_realloc(content, length + BUFSIZ);
-    if (temp_content == NULL) {
-      break;
-    }
-    content = temp_content;
-
-    bytes_read = read(fd, content + length, BUFSIZ);
-    if (bytes_read == -1) {
-      break;
-    }
-
-    length += bytes_read;
-    content_type = g_content_type_guess(NULL, content, length, &uncertain);
-  }
-
-  fclose(f);
-  g_free(content);
-  if (uncertain == FALSE) {
-    return content_type;
-  }
-
-  g_free(content_type);
-
-  return NULL;
-}
-
 zathura_error_t
-zathura_guess_type(const char* path, char** type)
+zathura_guess_type_data_fallback(const void* data, size_t length, char** type)
 {
-  if (path == NULL || strlen(path) == 0 || type == NULL) {
+  if (data == NULL || length == 0 || type == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-#ifdef WITH_MAGIC
-  /* try content type detection with libmagic */
-  *type = guess_type_magic(path);
-  if (*type != NULL) {
-    return ZATHURA_ERROR_OK;
-  }
-#endif
-
-  /* try content type detection with glib */
-  *type = guess_type_glib(path);
-  if (*type != NULL) {
-    return ZATHURA_ERROR_OK;
-  }
-
-  /* try content type detection with find */
-  *type = guess_type_file(path);
-  if (*type != NULL) {
-    return ZATHURA_ERROR_OK;
+  gboolean uncertain = FALSE;
+  *type = g_content_type_guess(NULL, data, MIN(length, GT_MAX_READ), &uncertain);
+  if (*type != NULL && uncertain == TRUE) {
+    g_free(*type);
+    *type = NULL;
   }
 
-  return ZATHURA_ERROR_UNKNOWN;
+  return (*type != NULL) ? ZATHURA_ERROR_OK : ZATHURA_ERROR_UNKNOWN;
 }
@@ -2,11 +2,13 @@
 #ifndef LIBZATHURA_INTERNAL_H
 #define LIBZATHURA_INTERNAL_H
 
+#include <stdbool.h>
 #include <gmodule.h>
 
 #include "document.h"
 #include "plugin-api.h"
 #include "error.h"
+#include "options.h"
 #include "transition.h"
 #include "macros.h"
 
@@ -16,6 +18,10 @@ extern "C" {
 
 struct zathura_plugin_manager_s {
   zathura_list_t* plugins; /**< List of plugins */
+  GHashTable* mime_types; /**< Maps MIME types to the plugin handling them */
+  GHashTable* mime_type_aliases; /**< Maps MIME type aliases to MIME types */
+  struct zathura_type_detector_s* type_detector; /**< Detects MIME types of files */
+  char* index_path; /**< File caching the plugins found in directories */
 };
 
 struct zathura_plugin_s {
@@ -24,8 +30,11 @@ struct zathura_plugin_s {
   zathura_plugin_functions_t functions;
   zathura_plugin_version_t version;
   zathura_list_t* mimetypes;
+  zathura_plugin_flag_t flags;
   char* name;
   char* path;
+  char* cached_name; /**< Name read from the plugin index, owned by the plugin */
+  zathura_plugin_capability_t capabilities; /**< Functions implemented by the plugin */
 };
 
 struct zathura_document_s {
@@ -39,9 +48,28 @@ struct zathura_document_s {
   zathura_page_mode_t page_mode;
   zathura_document_permission_t permissions;
 
+  GRecMutex lock; /**< Serializes page creation and calls into the plugin */
+
+  zathura_options_t* options; /**< Options of the document */
+  struct zathura_render_cache_s* render_cache; /**< Cache of rendered pages */
+
+  GHashTable* page_labels; /**< Maps page labels to page indices */
+  bool page_labels_complete; /**< All pages have been added to page_labels */
+
+  zathura_page_geometry_t* page_geometry; /**< Geometry of all pages */
+  struct zathura_text_index_s* text_index; /**< Index of the text of all pages */
+
   void* user_data;
 };
 
+struct zathura_page_objects_s {
+  gint ref_count; /**< Reference count, the page holds one while cached */
+  zathura_list_t* mappings; /**< Mappings returned by the plugin */
+  struct zathura_spatial_index_s* index; /**< Spatial index over the mappings */
+  zathura_free_function_t free_function; /**< Frees a mapping */
+  struct zathura_arena_s* arena; /**< Arena of the objects of the mappings */
+};
+
 struct zathura_page_s {
   zathura_document_t* document;
   unsigned int index;
@@ -51,6 +79,14 @@ struct zathura_page_s {
   zathura_page_transition_t* transition;
   zathura_rectangle_t crop_box;
   unsigned int duration;
+  gint constructing_objects; /**< Plugin is creating annotations or form fields */
+  gint has_glyphs; /**< The characters of the page have been extracted */
+  zathura_glyph_t* glyphs; /**< The characters of the page */
+  size_t number_of_glyphs; /**< Number of characters */
+  GMutex objects_lock; /**< Protects the cached objects below */
+  zathura_page_objects_t* links; /**< Cached links */
+  zathura_page_objects_t* annotations; /**< Cached annotations */
+  zathura_page_objects_t* form_fields; /**< Cached form fields */
 
   void* user_data;
 };
@@ -62,6 +98,33 @@ struct zathura_document_meta_entry_s {
 
 zathura_error_t zathura_document_new(zathura_document_t** document);
 
+/**
+ * Acquires the lock that serializes calls into the plugin of the document.
+ * The lock is recursive, so plugin callbacks may call back into libzathura.
+ *
+ * @param[in] document The document
+ */
+HIDDEN void zathura_document_lock(zathura_document_t* document);
+
+/**
+ * Releases the lock acquired with zathura_document_lock.
+ *
+ * @param[in] document The document
+ */
+HIDDEN void zathura_document_unlock(zathura_document_t* document);
+
+/**
+ * Updates the page label index of the document after the label of a page has
+ * been changed.
+ *
+ * @param[in] document The document
+ * @param[in] index The index of the page
+ * @param[in] old_label The previous label of the page or NULL
+ * @param[in] new_label The new label of the page
+ */
+HIDDEN void zathura_document_page_label_changed(zathura_document_t* document,
+    unsigned int index, const char* old_label, const char* new_label);
+
 /**
  * Creates a new page object
  *
@@ -76,8 +139,147 @@ zathura_error_t zathura_page_new(zathura_page_t** page);
 zathura_error_t zathura_page_free(zathura_page_t* page);
 zathura_error_t zathura_page_set_document(zathura_page_t* page, zathura_document_t* document);
 
+/**
+ * Notifies the page that an object affecting its rendering, e.g. an annotation
+ * or a form field, has been changed. Cached renderings of the page are
+ * dropped. Changes made by the plugin while it creates the objects of the page
+ * are ignored.
+ *
+ * @param[in] page The page
+ */
+HIDDEN void zathura_page_content_changed(zathura_page_t* page);
+
+/**
+ * Returns whether rendering calls into the plugin of the page have to hold the
+ * lock of the document, i.e. whether the plugin does not support concurrent
+ * rendering.
+ *
+ * @param[in] page The page
+ *
+ * @return true if the lock of the document has to be held
+ */
+HIDDEN bool zathura_page_should_serialize_render(zathura_page_t* page);
+
+/**
+ * Renders the annotation into the given image buffer, which covers the area
+ * of the page starting at @a x and @a y.
+ *
+ * @param[in] annotation The annotation
+ * @param[in] buffer The image buffer
+ * @param[in] scale Scale level
+ * @param[in] x Horizontal offset of the annotation in the buffer in pixels
+ * @param[in] y Vertical offset of the annotation in the buffer in pixels
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin cannot render
+ *   annotations into buffers
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+HIDDEN zathura_error_t zathura_annotation_render_into(zathura_annotation_t*
+    annotation, zathura_image_buffer_t* buffer, double scale, int x, int y);
+
+/**
+ * Returns the size of the data of the image buffer in bytes.
+ *
+ * @param[in] buffer The image buffer
+ *
+ * @return The size of the data
+ */
+HIDDEN size_t zathura_image_buffer_get_size(zathura_image_buffer_t* buffer);
+
+/**
+ * Copies a region of the image buffer into a new image buffer.
+ *
+ * @param[in] buffer The image buffer
+ * @param[out] region The new image buffer containing the region
+ * @param[in] x Horizontal offset of the region
+ * @param[in] y Vertical offset of the region
+ * @param[in] width Width of the region
+ * @param[in] height Height of the region
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_image_buffer_crop(zathura_image_buffer_t* buffer,
+    zathura_image_buffer_t** region, unsigned int x, unsigned int y,
+    unsigned int width, unsigned int height);
+
+/**
+ * Copies the pixels of @a source into @a target, converting them to the pixel
+ * format of @a target. If the dimensions differ, only the overlapping area at
+ * the top left corner is copied.
+ *
+ * @param[in] source The source image buffer
+ * @param[in] target The target image buffer
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+HIDDEN zathura_error_t zathura_image_buffer_copy_pixels(zathura_image_buffer_t*
+    source, zathura_image_buffer_t* target);
+
+/**
+ * Composites a region of @a source onto @a target with the given blend mode
+ * and constant opacity, as described for transparency groups in the PDF
+ * specification. The region has to lie within both image buffers.
+ *
+ * @param[in] source The source image buffer
+ * @param[in] source_x Horizontal offset of the region in @a source
+ * @param[in] source_y Vertical offset of the region in @a source
+ * @param[in] target The target image buffer
+ * @param[in] target_x Horizontal offset of the region in @a target
+ * @param[in] target_y Vertical offset of the region in @a target
+ * @param[in] width Width of the region
+ * @param[in] height Height of the region
+ * @param[in] blend_mode The blend mode
+ * @param[in] opacity The opacity between 0 and 1
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+HIDDEN zathura_error_t zathura_image_buffer_blend(zathura_image_buffer_t*
+    source, unsigned int source_x, unsigned int source_y,
+    zathura_image_buffer_t* target, unsigned int target_x, unsigned int
+    target_y, unsigned int width, unsigned int height, zathura_blend_mode_t
+    blend_mode, double opacity);
+
+/**
+ * Loads the module of a plugin that has been registered from the plugin index
+ * and registers its functions. Does nothing if the module is already loaded.
+ *
+ * @param[in] plugin The plugin
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_RESOLVE_SYMBOL Could not resolve symbol
+ * @return ZATHURA_ERROR_PLUGIN_VERSION The module does not match the index
+ */
+HIDDEN zathura_error_t zathura_plugin_load_module(zathura_plugin_t* plugin);
+
+/**
+ * Derives the capabilities of the plugin from its registered functions.
+ *
+ * @param[in] plugin The plugin
+ */
+HIDDEN void zathura_plugin_update_capabilities(zathura_plugin_t* plugin);
+
 HIDDEN zathura_error_t zathura_realpath(const char* path, char** realpath);
-HIDDEN zathura_error_t zathura_guess_type(const char* path, char** type);
+
+/**
+ * Guesses the mime type of in-memory data with glib.
+ *
+ * @param[in] data The data
+ * @param[in] length The length of the data
+ * @param[out] type The mime type, has to be freed with g_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+HIDDEN zathura_error_t zathura_guess_type_data_fallback(const void* data,
+    size_t length, char** type);
 
 #ifdef __cplusplus
 }
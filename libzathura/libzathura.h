@@ -23,6 +23,10 @@ extern "C" {
 #include "page.h"
 #include "plugin.h"
 #include "plugin-manager.h"
+#include "prefetcher.h"
+#include "render-job.h"
+#include "search.h"
+#include "search-pattern.h"
 #include "sound.h"
 #include "transition.h"
 #include "types.h"
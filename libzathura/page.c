@@ -1,13 +1,24 @@
 /* See LICENSE file for license and copyright information */
 
+#define _XOPEN_SOURCE 500
+
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdbool.h>
 
 #include "page.h"
+#include "annotations.h"
+#include "arena.h"
 #include "plugin-api.h"
 #include "internal.h"
 #include "macros.h"
+#include "render-cache.h"
+#include "search-pattern.h"
+#include "spatial-index.h"
 
 #define CHECK_IF_IMPLEMENTED(page, function) \
   if ((page)->document == NULL || \
@@ -16,6 +27,28 @@
     return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED; \
   }
 
+bool
+zathura_page_should_serialize_render(zathura_page_t* page)
+{
+  return (page->document->plugin->flags & ZATHURA_PLUGIN_FLAG_REENTRANT_RENDER) == 0;
+}
+
+/* Returns the geometry of the document if it has been collected already */
+static zathura_page_geometry_t*
+page_get_document_geometry(zathura_page_t* page)
+{
+  if (page->document == NULL) {
+    return NULL;
+  }
+
+  zathura_page_geometry_t* geometry = g_atomic_pointer_get(&(page->document->page_geometry));
+  if (geometry == NULL || page->index >= geometry->number_of_pages) {
+    return NULL;
+  }
+
+  return geometry;
+}
+
 zathura_error_t
 zathura_page_new(zathura_page_t** page)
 {
@@ -27,9 +60,60 @@ zathura_page_new(zathura_page_t** page)
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
+  g_mutex_init(&((*page)->objects_lock));
+
   return ZATHURA_ERROR_OK;
 }
 
+void
+zathura_page_content_changed(zathura_page_t* page)
+{
+  if (page == NULL || page->document == NULL) {
+    return;
+  }
+
+  /* Objects that are still being created by the plugin reflect the current
+   * state of the page */
+  if (g_atomic_int_get(&page->constructing_objects) > 0) {
+    return;
+  }
+
+  zathura_render_cache_invalidate_page(page->document->render_cache, page->index);
+}
+
+static void
+link_mapping_free(void* data)
+{
+  zathura_link_mapping_t* mapping = data;
+  if (mapping->action != NULL) {
+    zathura_action_free(mapping->action);
+  }
+
+  free(mapping);
+}
+
+static void
+annotation_mapping_free(void* data)
+{
+  zathura_annotation_mapping_t* mapping = data;
+  if (mapping->annotation != NULL) {
+    zathura_annotation_free(mapping->annotation);
+  }
+
+  free(mapping);
+}
+
+static void
+form_field_mapping_free(void* data)
+{
+  zathura_form_field_mapping_t* mapping = data;
+  if (mapping->form_field != NULL) {
+    zathura_form_field_free(mapping->form_field);
+  }
+
+  free(mapping);
+}
+
 zathura_error_t
 zathura_page_free(zathura_page_t* page)
 {
@@ -37,6 +121,10 @@ zathura_page_free(zathura_page_t* page)
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  /* Release the cached objects while the plugin data of the page exists */
+  zathura_page_objects_changed(page, ZATHURA_PAGE_OBJECT_LINKS |
+      ZATHURA_PAGE_OBJECT_ANNOTATIONS | ZATHURA_PAGE_OBJECT_FORM_FIELDS);
+
   if (page->document != NULL &&
       page->document->plugin != NULL &&
       page->document->plugin->functions.page_clear != NULL) {
@@ -47,6 +135,8 @@ zathura_page_free(zathura_page_t* page)
     free(page->label);
   }
 
+  free(page->glyphs);
+  g_mutex_clear(&(page->objects_lock));
   free(page);
 
   return ZATHURA_ERROR_OK;
@@ -135,6 +225,11 @@ zathura_page_set_width(zathura_page_t* page, unsigned int width)
 
   page->width = width;
 
+  zathura_page_geometry_t* geometry = page_get_document_geometry(page);
+  if (geometry != NULL) {
+    geometry->width[page->index] = width;
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -159,6 +254,11 @@ zathura_page_set_height(zathura_page_t* page, unsigned int height)
 
   page->height = height;
 
+  zathura_page_geometry_t* geometry = page_get_document_geometry(page);
+  if (geometry != NULL) {
+    geometry->height[page->index] = height;
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -183,23 +283,27 @@ zathura_page_set_label(zathura_page_t* page, const char* label)
 
   size_t len = strlen(label);
 
-  if (page->label != NULL) {
-    free(page->label);
-    page->label = NULL;
-  }
-
-  page->label = calloc(len + 1, sizeof(*(page->label)));
-  if (page->label == NULL) {
+  char* new_label = calloc(len + 1, sizeof(*new_label));
+  if (new_label == NULL) {
     return ZATHURA_ERROR_OUT_OF_MEMORY;
   }
 
-  if (page->label != strncpy(page->label, label, strlen(label))) {
-    free(page->label);
-    page->label = NULL;
+  if (new_label != strncpy(new_label, label, len)) {
+    free(new_label);
 
     return ZATHURA_ERROR_UNKNOWN;
   }
 
+  char* old_label = page->label;
+  page->label = new_label;
+
+  if (page->document != NULL) {
+    zathura_document_page_label_changed(page->document, page->index,
+        old_label, new_label);
+  }
+
+  free(old_label);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -248,6 +352,11 @@ zathura_page_set_crop_box(zathura_page_t* page, zathura_rectangle_t crop_box)
 
   page->crop_box = crop_box;
 
+  zathura_page_geometry_t* geometry = page_get_document_geometry(page);
+  if (geometry != NULL) {
+    geometry->crop_box[page->index] = crop_box;
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -287,6 +396,51 @@ zathura_page_get_duration(zathura_page_t* page, unsigned int* duration)
   return ZATHURA_ERROR_OK;
 }
 
+/* Matches the search item against the characters of the page */
+static zathura_error_t
+page_search_glyphs(zathura_page_t* page, const char* text,
+    zathura_search_flag_t flags, zathura_list_t** results)
+{
+  CHECK_IF_IMPLEMENTED(page, page_get_glyphs)
+
+  zathura_search_pattern_t* pattern = NULL;
+  zathura_error_t error = zathura_search_pattern_new(&pattern, &text, 1, flags);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  zathura_list_t* matches = NULL;
+  error = zathura_page_search_pattern(page, pattern, &matches);
+  zathura_search_pattern_free(pattern);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  /* Matches spanning several lines are highlighted line by line */
+  zathura_list_t* rectangles = NULL;
+  zathura_search_match_t* match = NULL;
+  ZATHURA_LIST_FOREACH(match, matches) {
+    zathura_list_t* match_rectangles = NULL;
+    error = zathura_page_get_glyph_rectangles(page, match->first_glyph,
+        match->last_glyph, &match_rectangles);
+    if (error != ZATHURA_ERROR_OK) {
+      break;
+    }
+    rectangles = g_list_concat(rectangles, match_rectangles);
+  }
+
+  zathura_list_free_full(matches, free);
+
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_list_free_full(rectangles, free);
+    return error;
+  }
+
+  *results = rectangles;
+
+  return ZATHURA_ERROR_OK;
+}
+
 zathura_error_t
 zathura_page_search_text(zathura_page_t* page, const char* text,
     zathura_search_flag_t flags, zathura_list_t** results)
@@ -295,9 +449,232 @@ zathura_page_search_text(zathura_page_t* page, const char* text,
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  CHECK_IF_IMPLEMENTED(page, page_search_text)
+  /* Plugins only know the basic flags, everything else and plugins without a
+   * search function are served from the characters of the page */
+  if ((flags & (ZATHURA_SEARCH_REGEX | ZATHURA_SEARCH_IGNORE_DIACRITICS)) != 0 ||
+      page->document == NULL || page->document->plugin == NULL ||
+      page->document->plugin->functions.page_search_text == NULL) {
+    return page_search_glyphs(page, text, flags, results);
+  }
+
+  const bool serialize = (page->document->plugin->flags & ZATHURA_PLUGIN_FLAG_REENTRANT_SEARCH) == 0;
+  if (serialize == true) {
+    zathura_document_lock(page->document);
+  }
+
+  zathura_error_t error = page->document->plugin->functions.page_search_text(page, text, flags, results);
+
+  if (serialize == true) {
+    zathura_document_unlock(page->document);
+  }
+
+  return error;
+}
+
+/* Extracts the characters of the page on first use */
+static zathura_error_t
+page_load_glyphs(zathura_page_t* page)
+{
+  if (g_atomic_int_get(&(page->has_glyphs)) != 0) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  CHECK_IF_IMPLEMENTED(page, page_get_glyphs)
 
-  return page->document->plugin->functions.page_search_text(page, text, flags, results);
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  zathura_document_lock(page->document);
+
+  if (g_atomic_int_get(&(page->has_glyphs)) == 0) {
+    zathura_glyph_t* glyphs = NULL;
+    size_t number_of_glyphs = 0;
+
+    error = page->document->plugin->functions.page_get_glyphs(page, &glyphs, &number_of_glyphs);
+    if (error == ZATHURA_ERROR_OK) {
+      page->glyphs = glyphs;
+      page->number_of_glyphs = (glyphs != NULL) ? number_of_glyphs : 0;
+      /* Publishes the array to readers that do not take the lock */
+      g_atomic_int_set(&(page->has_glyphs), 1);
+    } else {
+      free(glyphs);
+    }
+  }
+
+  zathura_document_unlock(page->document);
+
+  return error;
+}
+
+static bool
+rectangle_contains_point(zathura_rectangle_t rectangle, zathura_point_t point)
+{
+  return point.x >= MIN(rectangle.p1.x, rectangle.p2.x) &&
+         point.x <= MAX(rectangle.p1.x, rectangle.p2.x) &&
+         point.y >= MIN(rectangle.p1.y, rectangle.p2.y) &&
+         point.y <= MAX(rectangle.p1.y, rectangle.p2.y);
+}
+
+static zathura_point_t
+glyph_get_center(const zathura_glyph_t* glyph)
+{
+  return (zathura_point_t) {
+    (glyph->position.p1.x + glyph->position.p2.x) / 2,
+    (glyph->position.p1.y + glyph->position.p2.y) / 2
+  };
+}
+
+static bool
+glyphs_on_same_line(const zathura_glyph_t* a, const zathura_glyph_t* b)
+{
+  return a->line == b->line && a->block == b->block;
+}
+
+/* Collects the characters from first to last, restricted to those centered
+ * in the rectangle if one is given. The text is allocated with malloc like
+ * the text returned by plugins. */
+static char*
+glyphs_get_text(const zathura_glyph_t* glyphs, size_t first, size_t last,
+    const zathura_rectangle_t* rectangle)
+{
+  GString* text = g_string_new(NULL);
+  const zathura_glyph_t* previous = NULL;
+
+  for (size_t i = first; i <= last; i++) {
+    const zathura_glyph_t* glyph = &(glyphs[i]);
+    if (g_unichar_validate(glyph->codepoint) == FALSE ||
+        (rectangle != NULL && rectangle_contains_point(*rectangle,
+          glyph_get_center(glyph)) == false)) {
+      continue;
+    }
+
+    if (previous != NULL && glyphs_on_same_line(previous, glyph) == false) {
+      g_string_append_c(text, '\n');
+    }
+
+    g_string_append_unichar(text, glyph->codepoint);
+    previous = glyph;
+  }
+
+  char* result = strdup(text->str);
+  g_string_free(text, TRUE);
+
+  return result;
+}
+
+zathura_error_t
+zathura_page_get_glyphs(zathura_page_t* page, const zathura_glyph_t** glyphs,
+    size_t* number_of_glyphs)
+{
+  if (page == NULL || glyphs == NULL || number_of_glyphs == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = page_load_glyphs(page);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  *glyphs           = page->glyphs;
+  *number_of_glyphs = page->number_of_glyphs;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_page_get_glyph_at(zathura_page_t* page, zathura_point_t point, size_t*
+    index)
+{
+  if (page == NULL || index == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = page_load_glyphs(page);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  for (size_t i = 0; i < page->number_of_glyphs; i++) {
+    if (rectangle_contains_point(page->glyphs[i].position, point) == true) {
+      *index = i;
+      return ZATHURA_ERROR_OK;
+    }
+  }
+
+  return ZATHURA_ERROR_SEARCH_NO_RESULTS;
+}
+
+zathura_error_t
+zathura_page_get_glyph_text(zathura_page_t* page, size_t first, size_t last,
+    char** text)
+{
+  if (page == NULL || text == NULL || first > last) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = page_load_glyphs(page);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (last >= page->number_of_glyphs) {
+    return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX;
+  }
+
+  *text = glyphs_get_text(page->glyphs, first, last, NULL);
+  if (*text == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_page_get_glyph_rectangles(zathura_page_t* page, size_t first, size_t
+    last, zathura_list_t** rectangles)
+{
+  if (page == NULL || rectangles == NULL || first > last) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = page_load_glyphs(page);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (last >= page->number_of_glyphs) {
+    return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX;
+  }
+
+  zathura_list_t* list = NULL;
+  zathura_rectangle_t* rectangle = NULL;
+
+  for (size_t i = first; i <= last; i++) {
+    const zathura_rectangle_t position = page->glyphs[i].position;
+    const zathura_rectangle_t box = {
+      { MIN(position.p1.x, position.p2.x), MIN(position.p1.y, position.p2.y) },
+      { MAX(position.p1.x, position.p2.x), MAX(position.p1.y, position.p2.y) }
+    };
+
+    if (rectangle == NULL || glyphs_on_same_line(&(page->glyphs[i - 1]),
+          &(page->glyphs[i])) == false) {
+      if ((rectangle = malloc(sizeof(*rectangle))) == NULL) {
+        zathura_list_free_full(list, free);
+        return ZATHURA_ERROR_OUT_OF_MEMORY;
+      }
+
+      *rectangle = box;
+      list = zathura_list_prepend(list, rectangle);
+    } else {
+      rectangle->p1.x = MIN(rectangle->p1.x, box.p1.x);
+      rectangle->p1.y = MIN(rectangle->p1.y, box.p1.y);
+      rectangle->p2.x = MAX(rectangle->p2.x, box.p2.x);
+      rectangle->p2.y = MAX(rectangle->p2.y, box.p2.y);
+    }
+  }
+
+  *rectangles = zathura_list_reverse(list);
+
+  return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
@@ -308,9 +685,21 @@ zathura_page_get_selected_text(zathura_page_t* page, char** text,
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  CHECK_IF_IMPLEMENTED(page, page_get_text)
+  /* Prefer the cached characters over another call into the plugin */
+  if (page_load_glyphs(page) == ZATHURA_ERROR_OK) {
+    *text = (page->number_of_glyphs > 0) ?
+      glyphs_get_text(page->glyphs, 0, page->number_of_glyphs - 1, &rectangle) :
+      strdup("");
+    return (*text != NULL) ? ZATHURA_ERROR_OK : ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  CHECK_IF_IMPLEMENTED(page, page_get_selected_text)
 
-  return page->document->plugin->functions.page_get_selected_text(page, text, rectangle);
+  zathura_document_lock(page->document);
+  zathura_error_t error = page->document->plugin->functions.page_get_selected_text(page, text, rectangle);
+  zathura_document_unlock(page->document);
+
+  return error;
 }
 
 zathura_error_t
@@ -320,33 +709,150 @@ zathura_page_get_text(zathura_page_t* page, char** text)
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  CHECK_IF_IMPLEMENTED(page, page_get_selected_text)
+  CHECK_IF_IMPLEMENTED(page, page_get_text)
+
+  zathura_document_lock(page->document);
+  zathura_error_t error = page->document->plugin->functions.page_get_text(page, text);
+  zathura_document_unlock(page->document);
 
-  return page->document->plugin->functions.page_get_text(page, text);
+  return error;
+}
+
+/* Fetches the links from the plugin */
+static zathura_error_t
+page_fetch_links(zathura_page_t* page, zathura_list_t** links)
+{
+  CHECK_IF_IMPLEMENTED(page, page_get_links)
+
+  zathura_document_lock(page->document);
+  zathura_error_t error = page->document->plugin->functions.page_get_links(page, links);
+  zathura_document_unlock(page->document);
+
+  return error;
+}
+
+/* Fetches the form fields from the plugin */
+static zathura_error_t
+page_fetch_form_fields(zathura_page_t* page, zathura_list_t** form_fields)
+{
+  CHECK_IF_IMPLEMENTED(page, page_get_form_fields)
+
+  zathura_document_lock(page->document);
+  g_atomic_int_inc(&page->constructing_objects);
+  zathura_error_t error = page->document->plugin->functions.page_get_form_fields(page, form_fields);
+  g_atomic_int_add(&page->constructing_objects, -1);
+  zathura_document_unlock(page->document);
+
+  return error;
+}
+
+/* Fetches the annotations from the plugin */
+static zathura_error_t
+page_fetch_annotations(zathura_page_t* page, zathura_list_t** annotations)
+{
+  CHECK_IF_IMPLEMENTED(page, page_get_annotations)
+
+  zathura_document_lock(page->document);
+  g_atomic_int_inc(&page->constructing_objects);
+  zathura_error_t error = page->document->plugin->functions.page_get_annotations(page, annotations);
+  g_atomic_int_add(&page->constructing_objects, -1);
+  zathura_document_unlock(page->document);
+
+  return error;
+}
+
+typedef zathura_error_t (*page_fetch_objects_function_t)(zathura_page_t* page,
+    zathura_list_t** mappings);
+
+/* Returns a reference to the cached objects, fetching them on first use */
+static zathura_error_t
+page_get_objects(zathura_page_t* page, zathura_page_objects_t** cache,
+    page_fetch_objects_function_t fetch_objects, zathura_free_function_t
+    free_function, zathura_page_objects_t** objects)
+{
+  g_mutex_lock(&(page->objects_lock));
+  if (*cache != NULL) {
+    *objects = zathura_page_objects_ref(*cache);
+    g_mutex_unlock(&(page->objects_lock));
+    return ZATHURA_ERROR_OK;
+  }
+  g_mutex_unlock(&(page->objects_lock));
+
+  if (page->document == NULL) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  /* The document lock keeps other threads from fetching the same objects */
+  zathura_document_lock(page->document);
+
+  g_mutex_lock(&(page->objects_lock));
+  if (*cache != NULL) {
+    *objects = zathura_page_objects_ref(*cache);
+    g_mutex_unlock(&(page->objects_lock));
+    zathura_document_unlock(page->document);
+    return ZATHURA_ERROR_OK;
+  }
+  g_mutex_unlock(&(page->objects_lock));
+
+  zathura_page_objects_t* new_objects = calloc(1, sizeof(*new_objects));
+  if (new_objects == NULL) {
+    zathura_document_unlock(page->document);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  new_objects->ref_count     = 1;
+  new_objects->free_function = free_function;
+
+  zathura_error_t error = zathura_arena_new(&(new_objects->arena));
+  if (error == ZATHURA_ERROR_OK) {
+    /* Annotations, form fields and actions created by the plugin while
+     * fetching are allocated from the arena and released all at once */
+    zathura_arena_t* previous_arena = zathura_arena_set_current(new_objects->arena);
+    error = fetch_objects(page, &(new_objects->mappings));
+    zathura_arena_set_current(previous_arena);
+  }
+
+  if (error == ZATHURA_ERROR_OK) {
+    error = zathura_spatial_index_new(&(new_objects->index), new_objects->mappings);
+  }
+
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_page_objects_unref(new_objects);
+    zathura_document_unlock(page->document);
+    return error;
+  }
+
+  g_mutex_lock(&(page->objects_lock));
+  *cache   = new_objects;
+  *objects = zathura_page_objects_ref(new_objects);
+  g_mutex_unlock(&(page->objects_lock));
+
+  zathura_document_unlock(page->document);
+
+  return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
-zathura_page_get_links(zathura_page_t* page, zathura_list_t** links)
+zathura_page_get_links(zathura_page_t* page, zathura_page_objects_t** links)
 {
   if (page == NULL || links == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  CHECK_IF_IMPLEMENTED(page, page_get_links)
-
-  return page->document->plugin->functions.page_get_links(page, links);
+  return page_get_objects(page, &(page->links), page_fetch_links,
+      link_mapping_free, links);
 }
 
 zathura_error_t
-zathura_page_get_form_fields(zathura_page_t* page, zathura_list_t** form_fields)
+zathura_page_get_form_fields(zathura_page_t* page, zathura_page_objects_t**
+    form_fields)
 {
   if (page == NULL || form_fields == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  CHECK_IF_IMPLEMENTED(page, page_get_form_fields)
-
-  return page->document->plugin->functions.page_get_form_fields(page, form_fields);
+  return page_get_objects(page, &(page->form_fields), page_fetch_form_fields,
+      form_field_mapping_free, form_fields);
 }
 
 zathura_error_t
@@ -358,19 +864,291 @@ zathura_page_get_images(zathura_page_t* page, zathura_list_t** images)
 
   CHECK_IF_IMPLEMENTED(page, page_get_images)
 
-  return page->document->plugin->functions.page_get_images(page, images);
+  zathura_document_lock(page->document);
+  zathura_error_t error = page->document->plugin->functions.page_get_images(page, images);
+  zathura_document_unlock(page->document);
+
+  return error;
 }
 
 zathura_error_t
-zathura_page_get_annotations(zathura_page_t* page, zathura_list_t** annotations)
+zathura_page_get_annotations(zathura_page_t* page, zathura_page_objects_t**
+    annotations)
 {
   if (page == NULL || annotations == NULL) {
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  CHECK_IF_IMPLEMENTED(page, page_get_annotations)
+  return page_get_objects(page, &(page->annotations), page_fetch_annotations,
+      annotation_mapping_free, annotations);
+}
+
+zathura_error_t
+zathura_page_objects_get_mappings(zathura_page_objects_t* objects,
+    zathura_list_t** mappings)
+{
+  if (objects == NULL || mappings == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *mappings = objects->mappings;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_page_objects_t*
+zathura_page_objects_ref(zathura_page_objects_t* objects)
+{
+  if (objects == NULL) {
+    return NULL;
+  }
+
+  g_atomic_int_inc(&(objects->ref_count));
+
+  return objects;
+}
+
+zathura_error_t
+zathura_page_objects_unref(zathura_page_objects_t* objects)
+{
+  if (objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (g_atomic_int_dec_and_test(&(objects->ref_count)) == FALSE) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  zathura_spatial_index_free(objects->index);
+  zathura_list_free_full(objects->mappings, objects->free_function);
+  zathura_arena_free(objects->arena);
+  free(objects);
+
+  return ZATHURA_ERROR_OK;
+}
 
-  return page->document->plugin->functions.page_get_annotations(page, annotations);
+/* Drops the cached objects, references held elsewhere keep them alive */
+static void
+page_clear_objects(zathura_page_t* page, zathura_page_objects_t** cache)
+{
+  g_mutex_lock(&(page->objects_lock));
+  zathura_page_objects_t* objects = *cache;
+  *cache = NULL;
+  g_mutex_unlock(&(page->objects_lock));
+
+  if (objects != NULL) {
+    zathura_page_objects_unref(objects);
+  }
+}
+
+zathura_error_t
+zathura_page_objects_changed(zathura_page_t* page, zathura_page_object_type_t
+    types)
+{
+  if (page == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if ((types & ZATHURA_PAGE_OBJECT_LINKS) != 0) {
+    page_clear_objects(page, &(page->links));
+  }
+  if ((types & ZATHURA_PAGE_OBJECT_ANNOTATIONS) != 0) {
+    page_clear_objects(page, &(page->annotations));
+  }
+  if ((types & ZATHURA_PAGE_OBJECT_FORM_FIELDS) != 0) {
+    page_clear_objects(page, &(page->form_fields));
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+typedef zathura_error_t (*page_get_objects_function_t)(zathura_page_t* page,
+    zathura_page_objects_t** objects);
+
+/* The reference to the objects is passed on to the caller, as the returned
+ * mappings are owned by them */
+static zathura_error_t
+page_get_objects_at(zathura_page_t* page, page_get_objects_function_t
+    get_objects, zathura_point_t point, zathura_list_t** mappings,
+    zathura_page_objects_t** objects)
+{
+  zathura_page_objects_t* page_objects = NULL;
+  zathura_error_t error = get_objects(page, &page_objects);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  error = zathura_spatial_index_query_point(page_objects->index, point, mappings);
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_page_objects_unref(page_objects);
+    return error;
+  }
+
+  *objects = page_objects;
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_error_t
+page_get_objects_in_rectangle(zathura_page_t* page, page_get_objects_function_t
+    get_objects, zathura_rectangle_t rectangle, zathura_list_t** mappings,
+    zathura_page_objects_t** objects)
+{
+  zathura_page_objects_t* page_objects = NULL;
+  zathura_error_t error = get_objects(page, &page_objects);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  error = zathura_spatial_index_query_rectangle(page_objects->index, rectangle, mappings);
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_page_objects_unref(page_objects);
+    return error;
+  }
+
+  *objects = page_objects;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_page_get_links_at(zathura_page_t* page, zathura_point_t point,
+    zathura_list_t** links, zathura_page_objects_t** objects)
+{
+  if (page == NULL || links == NULL || objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return page_get_objects_at(page, zathura_page_get_links, point, links,
+      objects);
+}
+
+zathura_error_t
+zathura_page_get_links_in_rectangle(zathura_page_t* page, zathura_rectangle_t
+    rectangle, zathura_list_t** links, zathura_page_objects_t** objects)
+{
+  if (page == NULL || links == NULL || objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return page_get_objects_in_rectangle(page, zathura_page_get_links,
+      rectangle, links, objects);
+}
+
+zathura_error_t
+zathura_page_get_form_fields_at(zathura_page_t* page, zathura_point_t point,
+    zathura_list_t** form_fields, zathura_page_objects_t** objects)
+{
+  if (page == NULL || form_fields == NULL || objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return page_get_objects_at(page, zathura_page_get_form_fields, point,
+      form_fields, objects);
+}
+
+zathura_error_t
+zathura_page_get_form_fields_in_rectangle(zathura_page_t* page,
+    zathura_rectangle_t rectangle, zathura_list_t** form_fields,
+    zathura_page_objects_t** objects)
+{
+  if (page == NULL || form_fields == NULL || objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return page_get_objects_in_rectangle(page, zathura_page_get_form_fields,
+      rectangle, form_fields, objects);
+}
+
+zathura_error_t
+zathura_page_get_annotations_at(zathura_page_t* page, zathura_point_t point,
+    zathura_list_t** annotations, zathura_page_objects_t** objects)
+{
+  if (page == NULL || annotations == NULL || objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return page_get_objects_at(page, zathura_page_get_annotations, point,
+      annotations, objects);
+}
+
+zathura_error_t
+zathura_page_get_annotations_in_rectangle(zathura_page_t* page,
+    zathura_rectangle_t rectangle, zathura_list_t** annotations,
+    zathura_page_objects_t** objects)
+{
+  if (page == NULL || annotations == NULL || objects == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return page_get_objects_in_rectangle(page, zathura_page_get_annotations,
+      rectangle, annotations, objects);
+}
+
+/* Reports the final rendering to the job, fails if the job has been cancelled
+ * in the meantime */
+static zathura_error_t
+render_page_finish_job(zathura_render_job_t* job, zathura_image_buffer_t**
+    buffer)
+{
+  if (job == NULL) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  zathura_error_t error = zathura_render_job_report_progress(job, *buffer,
+      ZATHURA_RENDER_QUALITY_FINAL);
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_image_buffer_free(*buffer);
+    *buffer = NULL;
+  }
+
+  return error;
+}
+
+static zathura_error_t
+render_page(zathura_page_t* page, zathura_image_buffer_t** buffer, double
+    scale, int rotation, int flags, zathura_render_job_t* job)
+{
+  zathura_render_cache_t* render_cache = page->document->render_cache;
+  if (zathura_render_cache_lookup(render_cache, page->index, scale, rotation,
+        flags, buffer) == true) {
+    return render_page_finish_job(job, buffer);
+  }
+
+  const unsigned int generation = zathura_render_cache_get_generation(render_cache,
+      page->index);
+
+  const bool serialize = zathura_page_should_serialize_render(page);
+  if (serialize == true) {
+    zathura_document_lock(page->document);
+  }
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  *buffer = NULL;
+  if (job != NULL && page->document->plugin->functions.page_render_job != NULL) {
+    error = page->document->plugin->functions.page_render_job(page, buffer, scale, rotation, flags, job);
+  } else {
+    error = page->document->plugin->functions.page_render(page, buffer, scale, rotation, flags);
+  }
+
+  if (serialize == true) {
+    zathura_document_unlock(page->document);
+  }
+
+  if (error != ZATHURA_ERROR_OK || *buffer == NULL) {
+    return error;
+  }
+
+  /* Renderings of cancelled jobs are not cached */
+  if ((error = render_page_finish_job(job, buffer)) != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  zathura_render_cache_insert(render_cache, page->index, scale, rotation,
+      flags, generation, *buffer);
+
+  return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
@@ -383,7 +1161,374 @@ zathura_page_render(zathura_page_t* page, zathura_image_buffer_t** buffer,
 
   CHECK_IF_IMPLEMENTED(page, page_render)
 
-  return page->document->plugin->functions.page_render(page, buffer, scale, rotation, flags);
+  return render_page(page, buffer, scale, rotation, flags, NULL);
+}
+
+zathura_error_t
+zathura_page_render_with_job(zathura_page_t* page, zathura_image_buffer_t**
+    buffer, double scale, int rotation, int flags, zathura_render_job_t* job)
+{
+  if (page == NULL || buffer == NULL || scale <= 0.0 || job == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  CHECK_IF_IMPLEMENTED(page, page_render)
+
+  bool cancelled = false;
+  zathura_render_job_is_cancelled(job, &cancelled);
+  if (cancelled == true) {
+    return ZATHURA_ERROR_CANCELLED;
+  }
+
+  return render_page(page, buffer, scale, rotation, flags, job);
+}
+
+/* Computes the dimensions of the page rendered with the given scale and
+ * rotation, fails if they do not fit into an unsigned int */
+static zathura_error_t
+page_get_rendered_size(zathura_page_t* page, double scale, int rotation,
+    unsigned int* width, unsigned int* height)
+{
+  const double scaled_width  = page->width * scale;
+  const double scaled_height = page->height * scale;
+  if (scaled_width > UINT_MAX || scaled_height > UINT_MAX) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *width  = scaled_width;
+  *height = scaled_height;
+  if (((rotation % 360) + 360) % 180 == 90) {
+    const unsigned int tmp = *width;
+    *width  = *height;
+    *height = tmp;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Checks that the buffer has the given dimensions */
+static bool
+buffer_has_size(zathura_image_buffer_t* buffer, unsigned int width, unsigned
+    int height)
+{
+  unsigned int buffer_width  = 0;
+  unsigned int buffer_height = 0;
+  zathura_image_buffer_get_width(buffer, &buffer_width);
+  zathura_image_buffer_get_height(buffer, &buffer_height);
+
+  return buffer_width == width && buffer_height == height;
+}
+
+zathura_error_t
+zathura_page_render_into(zathura_page_t* page, zathura_image_buffer_t* buffer,
+    double scale, int rotation, int flags)
+{
+  if (page == NULL || buffer == NULL || scale <= 0.0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (page->document == NULL || page->document->plugin == NULL ||
+      (page->document->plugin->functions.page_render_into == NULL &&
+       page->document->plugin->functions.page_render == NULL)) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  /* A larger buffer would keep stale pixels, a smaller one a cropped page */
+  unsigned int width  = 0;
+  unsigned int height = 0;
+  zathura_error_t error = page_get_rendered_size(page, scale, rotation, &width, &height);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (buffer_has_size(buffer, width, height) == false) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (page->document->plugin->functions.page_render_into != NULL) {
+    const bool serialize = zathura_page_should_serialize_render(page);
+    if (serialize == true) {
+      zathura_document_lock(page->document);
+    }
+
+    error = page->document->plugin->functions.page_render_into(page, buffer,
+        scale, rotation, flags);
+
+    if (serialize == true) {
+      zathura_document_unlock(page->document);
+    }
+
+    return error;
+  }
+
+  zathura_image_buffer_t* page_buffer = NULL;
+  if ((error = render_page(page, &page_buffer, scale, rotation, flags, NULL)) != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (page_buffer == NULL) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  /* the plugin might round the dimensions of the page differently */
+  if (buffer_has_size(page_buffer, width, height) == false) {
+    zathura_image_buffer_free(page_buffer);
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  error = zathura_image_buffer_copy_pixels(page_buffer, buffer);
+  zathura_image_buffer_free(page_buffer);
+
+  return error;
+}
+
+zathura_error_t
+zathura_page_render_region(zathura_page_t* page, zathura_image_buffer_t**
+    buffer, double scale, int rotation, int flags, unsigned int x, unsigned int
+    y, unsigned int width, unsigned int height)
+{
+  if (page == NULL || buffer == NULL || scale <= 0.0 || width == 0 || height == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (page->document == NULL || page->document->plugin == NULL ||
+      (page->document->plugin->functions.page_render_region == NULL &&
+       page->document->plugin->functions.page_render == NULL)) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  /* Clip region to the dimensions of the rendered page */
+  unsigned int page_width  = 0;
+  unsigned int page_height = 0;
+  zathura_error_t error = page_get_rendered_size(page, scale, rotation,
+      &page_width, &page_height);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (x >= page_width || y >= page_height) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  width  = MIN(width, page_width - x);
+  height = MIN(height, page_height - y);
+
+  if (page->document->plugin->functions.page_render_region != NULL) {
+    const bool serialize = zathura_page_should_serialize_render(page);
+    if (serialize == true) {
+      zathura_document_lock(page->document);
+    }
+
+    *buffer = NULL;
+    error = page->document->plugin->functions.page_render_region(page, buffer,
+        scale, rotation, flags, x, y, width, height);
+
+    if (serialize == true) {
+      zathura_document_unlock(page->document);
+    }
+
+    return error;
+  }
+
+  /* Fall back to rendering the whole page, which is cached for the following
+   * regions of the same page */
+  zathura_image_buffer_t* page_buffer = NULL;
+  if ((error = zathura_page_render(page, &page_buffer, scale, rotation, flags)) != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (page_buffer == NULL) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  unsigned int buffer_width  = 0;
+  unsigned int buffer_height = 0;
+  zathura_image_buffer_get_width(page_buffer, &buffer_width);
+  zathura_image_buffer_get_height(page_buffer, &buffer_height);
+
+  /* The plugin might round the dimensions of the page differently */
+  if (x >= buffer_width || y >= buffer_height) {
+    zathura_image_buffer_free(page_buffer);
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  error = zathura_image_buffer_crop(page_buffer, buffer, x, y,
+      MIN(width, buffer_width - x), MIN(height, buffer_height - y));
+
+  zathura_image_buffer_free(page_buffer);
+
+  return error;
+}
+
+/* Clears a region of a layer to transparent */
+static void
+layer_clear(zathura_image_buffer_t* layer, unsigned int x, unsigned int y,
+    unsigned int width, unsigned int height)
+{
+  unsigned char* data    = NULL;
+  unsigned int rowstride = 0;
+  zathura_image_buffer_get_data(layer, &data);
+  zathura_image_buffer_get_rowstride(layer, &rowstride);
+
+  for (unsigned int row = y; row < y + height; row++) {
+    memset(data + (size_t) row * rowstride + (size_t) x * 4, 0, (size_t) width * 4);
+  }
+}
+
+/* Renders a single annotation and composites it onto the buffer */
+static zathura_error_t
+render_annotation(zathura_page_t* page, zathura_annotation_mapping_t* mapping,
+    zathura_image_buffer_t* buffer, zathura_image_buffer_t** layer, double
+    scale, unsigned int x, unsigned int y)
+{
+  zathura_annotation_t* annotation = mapping->annotation;
+  const zathura_plugin_functions_t* functions = &(page->document->plugin->functions);
+
+  zathura_annotation_flag_t flags = ZATHURA_ANNOTATION_FLAG_UNDEFINED;
+  zathura_annotation_get_flags(annotation, &flags);
+  if ((flags & (ZATHURA_ANNOTATION_FLAG_HIDDEN | ZATHURA_ANNOTATION_FLAG_NO_VIEW)) != 0) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  zathura_blend_mode_t blend_mode = ZATHURA_BLEND_MODE_NORMAL;
+  float opacity = 1.0f;
+  zathura_annotation_get_blend_mode(annotation, &blend_mode);
+  zathura_annotation_get_opacity(annotation, &opacity);
+  if (opacity <= 0.0f) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  opacity = MIN(opacity, 1.0f);
+
+  /* Rectangle of the annotation in pixels relative to the buffer */
+  const zathura_rectangle_t position = mapping->position;
+  const double left   = floor(MIN(position.p1.x, position.p2.x) * scale) - x;
+  const double top    = floor(MIN(position.p1.y, position.p2.y) * scale) - y;
+  const double right  = ceil(MAX(position.p1.x, position.p2.x) * scale) - x;
+  const double bottom = ceil(MAX(position.p1.y, position.p2.y) * scale) - y;
+
+  unsigned int width  = 0;
+  unsigned int height = 0;
+  zathura_image_buffer_get_width(buffer, &width);
+  zathura_image_buffer_get_height(buffer, &height);
+
+  /* Only the part of the annotation within the buffer is composited */
+  const double clip_left   = MAX(left, 0.0);
+  const double clip_top    = MAX(top, 0.0);
+  const double clip_right  = MIN(right, (double) width);
+  const double clip_bottom = MIN(bottom, (double) height);
+  if (clip_right <= clip_left || clip_bottom <= clip_top ||
+      left < INT_MIN || top < INT_MIN) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  const unsigned int target_x = clip_left;
+  const unsigned int target_y = clip_top;
+  unsigned int region_width   = clip_right - clip_left;
+  unsigned int region_height  = clip_bottom - clip_top;
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  if (functions->annotation_render_into != NULL) {
+    /* All annotations share one transparent layer of the size of the buffer */
+    if (*layer == NULL) {
+      error = zathura_image_buffer_new_with_format(layer, width, height,
+          ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32);
+      if (error != ZATHURA_ERROR_OK) {
+        return error;
+      }
+    } else {
+      layer_clear(*layer, target_x, target_y, region_width, region_height);
+    }
+
+    error = zathura_annotation_render_into(annotation, *layer, scale, left, top);
+    if (error != ZATHURA_ERROR_OK) {
+      return error;
+    }
+
+    return zathura_image_buffer_blend(*layer, target_x, target_y, buffer,
+        target_x, target_y, region_width, region_height, blend_mode, opacity);
+  }
+
+  zathura_image_buffer_t* annotation_buffer = NULL;
+  error = zathura_annotation_render(annotation, &annotation_buffer, scale);
+  if (error != ZATHURA_ERROR_OK || annotation_buffer == NULL) {
+    return error;
+  }
+
+  /* The plugin might round the dimensions of the annotation differently */
+  const unsigned int source_x = clip_left - left;
+  const unsigned int source_y = clip_top - top;
+  unsigned int annotation_width  = 0;
+  unsigned int annotation_height = 0;
+  zathura_image_buffer_get_width(annotation_buffer, &annotation_width);
+  zathura_image_buffer_get_height(annotation_buffer, &annotation_height);
+
+  if (source_x < annotation_width && source_y < annotation_height) {
+    region_width  = MIN(region_width, annotation_width - source_x);
+    region_height = MIN(region_height, annotation_height - source_y);
+
+    error = zathura_image_buffer_blend(annotation_buffer, source_x, source_y,
+        buffer, target_x, target_y, region_width, region_height, blend_mode,
+        opacity);
+  }
+
+  zathura_image_buffer_free(annotation_buffer);
+
+  return error;
+}
+
+zathura_error_t
+zathura_page_render_annotations(zathura_page_t* page, zathura_image_buffer_t*
+    buffer, double scale, unsigned int x, unsigned int y)
+{
+  if (page == NULL || buffer == NULL || scale <= 0.0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  CHECK_IF_IMPLEMENTED(page, page_get_annotations)
+
+  if (page->document->plugin->functions.annotation_render == NULL &&
+      page->document->plugin->functions.annotation_render_into == NULL) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  unsigned int width  = 0;
+  unsigned int height = 0;
+  zathura_image_buffer_get_width(buffer, &width);
+  zathura_image_buffer_get_height(buffer, &height);
+
+  zathura_page_objects_t* annotations = NULL;
+  zathura_error_t error = zathura_page_get_annotations(page, &annotations);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  /* Only annotations intersecting the buffer are considered */
+  const zathura_rectangle_t region = {
+    { x / scale, y / scale },
+    { ((double) x + width) / scale, ((double) y + height) / scale }
+  };
+
+  zathura_list_t* mappings = NULL;
+  error = zathura_spatial_index_query_rectangle(annotations->index, region, &mappings);
+
+  zathura_image_buffer_t* layer = NULL;
+  zathura_annotation_mapping_t* mapping = NULL;
+  ZATHURA_LIST_FOREACH(mapping, mappings) {
+    if ((error = render_annotation(page, mapping, buffer, &layer, scale, x, y)) != ZATHURA_ERROR_OK) {
+      break;
+    }
+  }
+
+  if (layer != NULL) {
+    zathura_image_buffer_free(layer);
+  }
+
+  zathura_list_free(mappings);
+  zathura_page_objects_unref(annotations);
+
+  return error;
 }
 
 #ifdef HAVE_CAIRO
@@ -397,6 +1542,17 @@ zathura_page_render_cairo(zathura_page_t* page, cairo_t* cairo, double scale,
 
   CHECK_IF_IMPLEMENTED(page, page_render_cairo)
 
-  return page->document->plugin->functions.page_render_cairo(page, cairo, scale, rotation, flags);
+  const bool serialize = zathura_page_should_serialize_render(page);
+  if (serialize == true) {
+    zathura_document_lock(page->document);
+  }
+
+  zathura_error_t error = page->document->plugin->functions.page_render_cairo(page, cairo, scale, rotation, flags);
+
+  if (serialize == true) {
+    zathura_document_unlock(page->document);
+  }
+
+  return error;
 }
 #endif
@@ -8,6 +8,7 @@ extern "C" {
 #endif
 
 typedef struct zathura_page_s zathura_page_t;
+typedef struct zathura_page_objects_s zathura_page_objects_t;
 
 #if HAVE_CAIRO
 #include <cairo.h>
@@ -17,6 +18,7 @@ typedef struct zathura_page_s zathura_page_t;
 #include "document.h"
 #include "types.h"
 #include "image-buffer.h"
+#include "render-job.h"
 #include "transition.h"
 
 /**
@@ -111,6 +113,12 @@ zathura_error_t zathura_page_get_duration(zathura_page_t* page, unsigned int* du
 /**
  * Returns a list of matching search results of the page.
  *
+ * The search is done by the plugin. With ZATHURA_SEARCH_REGEX or
+ * ZATHURA_SEARCH_IGNORE_DIACRITICS, or if the plugin cannot search, the
+ * library matches the search item against the characters of the page instead
+ * (see zathura_search_pattern_new) and returns one rectangle per line of each
+ * match.
+ *
  * @param[in] page The used page object
  * @param[in] text The search item
  * @param[in] flags The search flags
@@ -118,6 +126,8 @@ zathura_error_t zathura_page_get_duration(zathura_page_t* page, unsigned int* du
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin can neither search
+ *   pages nor provide their characters
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
 zathura_error_t zathura_page_search_text(zathura_page_t* page, const char* text,
@@ -136,7 +146,9 @@ zathura_error_t zathura_page_search_text(zathura_page_t* page, const char* text,
 zathura_error_t zathura_page_get_text(zathura_page_t* page, char** text);
 
 /**
- * Returns the text of the @a page that lies within the given @a rectangle.
+ * Returns the text of the @a page that lies within the given @a rectangle. If
+ * the plugin provides the characters of the page with their positions, the
+ * text is taken from those (see zathura_page_get_glyphs).
  *
  * @param[in] page The used page object
  * @param[out] text The text of the page that lies within the given rectangle
@@ -144,34 +156,134 @@ zathura_error_t zathura_page_get_text(zathura_page_t* page, char** text);
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
 zathura_error_t zathura_page_get_selected_text(zathura_page_t* page, char** text,
     zathura_rectangle_t rectangle);
 
 /**
- * Returns a list of the links of the page.
+ * Returns the characters of the @a page in reading order together with their
+ * positions. The characters are extracted once by the plugin and kept with
+ * the page, so the returned array stays valid until the page is freed.
  *
  * @param[in] page The used page object
- * @param[out] links List of links of the page
+ * @param[out] glyphs The characters of the page
+ * @param[out] number_of_glyphs The number of characters
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the characters of pages
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_page_get_links(zathura_page_t* page, zathura_list_t** links);
+zathura_error_t zathura_page_get_glyphs(zathura_page_t* page, const
+    zathura_glyph_t** glyphs, size_t* number_of_glyphs);
 
 /**
- * Returns a list of form fields of the page.
+ * Returns the index of the character of the @a page whose bounding box
+ * contains the given @a point.
  *
  * @param[in] page The used page object
- * @param[out] form_fields List of form fields of the page
+ * @param[in] point The point on the page
+ * @param[out] index The index of the character in the array returned by
+ *   zathura_page_get_glyphs
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the characters of pages
+ * @return ZATHURA_ERROR_SEARCH_NO_RESULTS There is no character at the point
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_page_get_form_fields(zathura_page_t* page, zathura_list_t** form_fields);
+zathura_error_t zathura_page_get_glyph_at(zathura_page_t* page,
+    zathura_point_t point, size_t* index);
+
+/**
+ * Returns the text of the characters from @a first to @a last (inclusive).
+ * Line and block changes are turned into line breaks.
+ *
+ * @param[in] page The used page object
+ * @param[in] first Index of the first character
+ * @param[in] last Index of the last character
+ * @param[out] text The text, has to be freed with free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the characters of pages
+ * @return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX Invalid character index
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_glyph_text(zathura_page_t* page, size_t
+    first, size_t last, char** text);
+
+/**
+ * Returns the rectangles covering the characters from @a first to @a last
+ * (inclusive), one per line, e.g. to highlight a selection or a search
+ * result.
+ *
+ * @param[in] page The used page object
+ * @param[in] first Index of the first character
+ * @param[in] last Index of the last character
+ * @param[out] rectangles List of zathura_rectangle_t, has to be freed with
+ *   zathura_list_free_full(rectangles, free)
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the characters of pages
+ * @return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX Invalid character index
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_glyph_rectangles(zathura_page_t* page,
+    size_t first, size_t last, zathura_list_t** rectangles);
+
+/**
+ * Kinds of objects of a page that are cached by the page
+ */
+typedef enum zathura_page_object_type_e {
+  ZATHURA_PAGE_OBJECT_LINKS = 1 << 0, /**< Links */
+  ZATHURA_PAGE_OBJECT_ANNOTATIONS = 1 << 1, /**< Annotations */
+  ZATHURA_PAGE_OBJECT_FORM_FIELDS = 1 << 2 /**< Form fields */
+} zathura_page_object_type_t;
+
+/**
+ * Returns the links of the page. The links are fetched from the plugin on
+ * first use and cached by the page until the plugin reports a change, so
+ * repeated calls return the same objects.
+ *
+ * @param[in] page The used page object
+ * @param[out] links The links of the page, a list of zathura_link_mapping_t;
+ *   the reference has to be released with zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the links of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_links(zathura_page_t* page, zathura_page_objects_t** links);
+
+/**
+ * Returns the form fields of the page. See zathura_page_get_links.
+ *
+ * @param[in] page The used page object
+ * @param[out] form_fields The form fields of the page, a list of
+ *   zathura_form_field_mapping_t; the reference has to be released with
+ *   zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the form fields of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_form_fields(zathura_page_t* page, zathura_page_objects_t** form_fields);
 
 /**
  * Returns a list of the images of the page.
@@ -186,16 +298,191 @@ zathura_error_t zathura_page_get_form_fields(zathura_page_t* page, zathura_list_
 zathura_error_t zathura_page_get_images(zathura_page_t* page, zathura_list_t** images);
 
 /**
- * Returns a list of annotations of the page.
+ * Returns the annotations of the page. See zathura_page_get_links.
+ *
+ * @param[in] page The used page object
+ * @param[out] annotations The annotations of the page, a list of
+ *   zathura_annotation_mapping_t; the reference has to be released with
+ *   zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the annotations of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_annotations(zathura_page_t* page, zathura_page_objects_t** annotations);
+
+/**
+ * Returns the mappings of cached page objects.
+ *
+ * @param[in] objects The page objects
+ * @param[out] mappings The mappings, owned by the page objects
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_page_objects_get_mappings(zathura_page_objects_t*
+    objects, zathura_list_t** mappings);
+
+/**
+ * Acquires another reference to the page objects. The objects stay valid
+ * while they are referenced, even after the page dropped them from its cache,
+ * but not after the document has been freed.
+ *
+ * @param[in] objects The page objects
+ *
+ * @return The page objects
+ */
+zathura_page_objects_t* zathura_page_objects_ref(zathura_page_objects_t* objects);
+
+/**
+ * Releases a reference to the page objects. The objects are freed once the
+ * last reference has been released.
+ *
+ * @param[in] objects The page objects
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_page_objects_unref(zathura_page_objects_t* objects);
+
+/**
+ * Returns the links of the page that contain the given point. The links are
+ * cached by the page together with a spatial index, so repeated hit tests do
+ * not walk all links of the page. The returned links stay valid until the
+ * reference to the links of the page is released, even if the plugin reports
+ * a change in the meantime.
+ *
+ * @param[in] page The used page object
+ * @param[in] point The point
+ * @param[out] links List of zathura_link_mapping_t in the order given by the
+ *   plugin; the list has to be freed with zathura_list_free
+ * @param[out] objects Reference to the links of the page that own the
+ *   returned links; it has to be released with zathura_page_objects_unref
+ *   once they are no longer used
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the links of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_links_at(zathura_page_t* page,
+    zathura_point_t point, zathura_list_t** links,
+    zathura_page_objects_t** objects);
+
+/**
+ * Returns the links of the page that intersect the given rectangle. See
+ * zathura_page_get_links_at.
  *
  * @param[in] page The used page object
- * @param[out] annotations List of annotations of the page
+ * @param[in] rectangle The rectangle
+ * @param[out] links List of zathura_link_mapping_t, the list has to be freed
+ *   with zathura_list_free
+ * @param[out] objects Reference to the links of the page, has to be released
+ *   with zathura_page_objects_unref
  *
  * @return ZATHURA_ERROR_OK No error occurred
  * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the links of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
  * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
  */
-zathura_error_t zathura_page_get_annotations(zathura_page_t* page, zathura_list_t** annotations);
+zathura_error_t zathura_page_get_links_in_rectangle(zathura_page_t* page,
+    zathura_rectangle_t rectangle, zathura_list_t** links,
+    zathura_page_objects_t** objects);
+
+/**
+ * Returns the form fields of the page that contain the given point. See
+ * zathura_page_get_links_at.
+ *
+ * @param[in] page The used page object
+ * @param[in] point The point
+ * @param[out] form_fields List of zathura_form_field_mapping_t, the list has
+ *   to be freed with zathura_list_free
+ * @param[out] objects Reference to the form fields of the page, has to be
+ *   released with zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the form fields of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_form_fields_at(zathura_page_t* page,
+    zathura_point_t point, zathura_list_t** form_fields,
+    zathura_page_objects_t** objects);
+
+/**
+ * Returns the form fields of the page that intersect the given rectangle. See
+ * zathura_page_get_links_at.
+ *
+ * @param[in] page The used page object
+ * @param[in] rectangle The rectangle
+ * @param[out] form_fields List of zathura_form_field_mapping_t, the list has
+ *   to be freed with zathura_list_free
+ * @param[out] objects Reference to the form fields of the page, has to be
+ *   released with zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the form fields of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_form_fields_in_rectangle(zathura_page_t* page,
+    zathura_rectangle_t rectangle, zathura_list_t** form_fields,
+    zathura_page_objects_t** objects);
+
+/**
+ * Returns the annotations of the page that contain the given point. See
+ * zathura_page_get_links_at.
+ *
+ * @param[in] page The used page object
+ * @param[in] point The point
+ * @param[out] annotations List of zathura_annotation_mapping_t, the list has
+ *   to be freed with zathura_list_free
+ * @param[out] objects Reference to the annotations of the page, has to be
+ *   released with zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the annotations of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_annotations_at(zathura_page_t* page,
+    zathura_point_t point, zathura_list_t** annotations,
+    zathura_page_objects_t** objects);
+
+/**
+ * Returns the annotations of the page that intersect the given rectangle. See
+ * zathura_page_get_links_at.
+ *
+ * @param[in] page The used page object
+ * @param[in] rectangle The rectangle
+ * @param[out] annotations List of zathura_annotation_mapping_t, the list has
+ *   to be freed with zathura_list_free
+ * @param[out] objects Reference to the annotations of the page, has to be
+ *   released with zathura_page_objects_unref
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the annotations of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_get_annotations_in_rectangle(zathura_page_t* page,
+    zathura_rectangle_t rectangle, zathura_list_t** annotations,
+    zathura_page_objects_t** objects);
 
 /**
  * Returns the crop box of the page
@@ -217,6 +504,11 @@ zathura_error_t zathura_page_get_crop_box(zathura_page_t* page, zathura_rectangl
 /**
  * Renders the page to a @a ::zathura_image_buffer_t image buffer
  *
+ * Renderings are cached by the document, so repeated calls with the same
+ * arguments return the same buffer. The buffer must not be modified and has to
+ * be released with @ref zathura_image_buffer_free. The cache is configured
+ * through the options of the document, see @ref zathura_document_get_options.
+ *
  * @param[in] page The used page object
  * @param[out] buffer The image buffer
  * @param[in] scale Scale level
@@ -230,6 +522,113 @@ zathura_error_t zathura_page_get_crop_box(zathura_page_t* page, zathura_rectangl
 zathura_error_t zathura_page_render(zathura_page_t* page,
     zathura_image_buffer_t** buffer, double scale, int rotation, int flags);
 
+/**
+ * Renders the page to a @a ::zathura_image_buffer_t image buffer as part of
+ * the given render job. The job can be cancelled from another thread, in
+ * which case the plugin stops rendering as soon as possible. Intermediate
+ * results, e.g. a coarse preview, are passed to the progress callback of the
+ * job, the final rendering is reported as well.
+ *
+ * Plugins that do not support render jobs render the page as with @ref
+ * zathura_page_render; the job is then only checked for cancellation before
+ * and after rendering.
+ *
+ * @param[in] page The used page object
+ * @param[out] buffer The image buffer
+ * @param[in] scale Scale level
+ * @param[in] rotation Rotation angle
+ * @param[in] flags Additional flags for rendering
+ * @param[in] job The render job
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_CANCELLED The render job has been cancelled
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_render_with_job(zathura_page_t* page,
+    zathura_image_buffer_t** buffer, double scale, int rotation, int flags,
+    zathura_render_job_t* job);
+
+/**
+ * Renders the page into the given image buffer, e.g. a buffer wrapping memory
+ * of the caller or acquired from a @a ::zathura_image_buffer_pool_t. The page
+ * is drawn into the buffer, which has to have the dimensions of the rendered
+ * page. The pixel format of the buffer is used.
+ *
+ * If the plugin cannot render into buffers, the page is rendered as with
+ * @ref zathura_page_render and copied into the buffer.
+ *
+ * @param[in] page The used page object
+ * @param[in] buffer The image buffer
+ * @param[in] scale Scale level
+ * @param[in] rotation Rotation angle
+ * @param[in] flags Additional flags for rendering
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_render_into(zathura_page_t* page,
+    zathura_image_buffer_t* buffer, double scale, int rotation, int flags);
+
+/**
+ * Renders a region of the page to a @a ::zathura_image_buffer_t image buffer.
+ * The region is given in pixels of the page rendered with the same @a scale
+ * and @a rotation, i.e. the buffer matches the corresponding part of the
+ * buffer returned by @ref zathura_page_render. Regions extending beyond the
+ * page are clipped, hence the buffer might be smaller than requested.
+ *
+ * If the plugin does not support rendering regions, the whole page is
+ * rendered and cropped.
+ *
+ * @param[in] page The used page object
+ * @param[out] buffer The image buffer
+ * @param[in] scale Scale level
+ * @param[in] rotation Rotation angle
+ * @param[in] flags Additional flags for rendering
+ * @param[in] x Horizontal offset of the region in pixels
+ * @param[in] y Vertical offset of the region in pixels
+ * @param[in] width Width of the region in pixels
+ * @param[in] height Height of the region in pixels
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_render_region(zathura_page_t* page,
+    zathura_image_buffer_t** buffer, double scale, int rotation, int flags,
+    unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+
+/**
+ * Composites the visible annotations of the page onto a rendered page or a
+ * region of it. The buffer covers the pixels of the page rendered with the
+ * same @a scale starting at @a x and @a y. Annotations are drawn in their
+ * order on the page using their blend mode and opacity. Annotations that
+ * are hidden or not meant to be viewed, and those outside of the buffer, are
+ * skipped.
+ *
+ * If the plugin renders annotations into given buffers, all annotations are
+ * drawn into one shared layer. Otherwise every annotation is rendered with
+ * @ref zathura_annotation_render and composited.
+ *
+ * @param[in] page The used page object
+ * @param[in] buffer The image buffer
+ * @param[in] scale Scale level
+ * @param[in] x Horizontal offset of the buffer in pixels
+ * @param[in] y Vertical offset of the buffer in pixels
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin cannot render
+ *   annotations
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_render_annotations(zathura_page_t* page,
+    zathura_image_buffer_t* buffer, double scale, unsigned int x, unsigned int
+    y);
+
 #ifdef HAVE_CAIRO
 /**
  * Renders the page to a cairo object
@@ -18,6 +18,18 @@ zathura_plugin_set_name(zathura_plugin_t* plugin, const char* name)
   return ZATHURA_ERROR_OK;
 }
 
+zathura_error_t
+zathura_plugin_set_flags(zathura_plugin_t* plugin, zathura_plugin_flag_t flags)
+{
+  if (plugin == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  plugin->flags = flags;
+
+  return ZATHURA_ERROR_OK;
+}
+
 zathura_error_t
 zathura_plugin_set_register_function(zathura_plugin_t* plugin,
     zathura_plugin_register_function_t function)
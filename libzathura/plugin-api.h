@@ -53,6 +53,39 @@ extern "C" {
   *       )
   */
 #define ZATHURA_PLUGIN_REGISTER(plugin_name, major, minor, rev, register_functions, mimetypes) \
+  PLUGIN_REGISTER(plugin_name, major, minor, rev, register_functions, ZATHURA_PLUGIN_FLAG_NONE, mimetypes)
+
+/**
+  * Macro to register a plugin with additional flags
+  *
+  * :param plugin_name: The name of the plugin
+  * :param major: The major version of the plugin
+  * :param minor: The minor version of the plugin
+  * :param minor: The revision of the plugin
+  * :param register_functions: Function that registers plugin functions
+  * :param mimetypes: Supported mimetypes
+  * :param plugin_flags: Combination of :c:type:`zathura_plugin_flag_t` values
+  *
+  * Example code:
+  * ::
+  *
+  *       ZATHURA_PLUGIN_REGISTER_WITH_FLAGS(
+  *         "my-plugin",
+  *         1,
+  *         0,
+  *         1,
+  *         register_functions,
+  *         ZATHURA_PLUGIN_MIMETYPES({
+  *           "libzathura/test-plugin",
+  *         }),
+  *         ZATHURA_PLUGIN_FLAG_REENTRANT_RENDER
+  *       )
+  */
+#define ZATHURA_PLUGIN_REGISTER_WITH_FLAGS(plugin_name, major, minor, rev, register_functions, mimetypes, plugin_flags) \
+  PLUGIN_REGISTER(plugin_name, major, minor, rev, register_functions, plugin_flags, mimetypes)
+
+/* The expanded list of mimetypes contains commas, hence it is passed last */
+#define PLUGIN_REGISTER(plugin_name, major, minor, rev, register_functions, plugin_flags, ...) \
   const zathura_plugin_version_t zathura_plugin_version = { \
     major, minor, rev \
   }; \
@@ -64,7 +97,8 @@ extern "C" {
     } \
     zathura_plugin_set_register_function(plugin, register_functions); \
     zathura_plugin_set_name(plugin, plugin_name); \
-    static const char* mime_types[] = mimetypes; \
+    zathura_plugin_set_flags(plugin, plugin_flags); \
+    static const char* mime_types[] = __VA_ARGS__; \
     for (size_t s = 0; s != sizeof(mime_types) / sizeof(const char*); ++s) { \
       zathura_plugin_add_mimetype(plugin, mime_types[s]); \
     } \
@@ -75,22 +109,29 @@ extern "C" {
 typedef void (*zathura_plugin_register_function_t)(zathura_plugin_functions_t* functions);
 
 typedef zathura_error_t (*zathura_plugin_document_open_t)(zathura_document_t* document);
+typedef zathura_error_t (*zathura_plugin_document_open_data_t)(zathura_document_t* document, const void* data, size_t length);
+typedef zathura_error_t (*zathura_plugin_document_open_fd_t)(zathura_document_t* document, int fd);
 typedef zathura_error_t (*zathura_plugin_document_free_t)(zathura_document_t* document);
 typedef zathura_error_t (*zathura_plugin_document_save_as_t)(zathura_document_t* document, const char* path);
 typedef zathura_error_t (*zathura_plugin_document_get_outline_t)(zathura_document_t* document, zathura_node_t** outline);
 typedef zathura_error_t (*zathura_plugin_document_get_attachments_t)(zathura_document_t* document, zathura_list_t** attachments);
 typedef zathura_error_t (*zathura_plugin_document_get_metadata_t)(zathura_document_t* document, zathura_list_t** metadata);
+typedef zathura_error_t (*zathura_plugin_document_get_page_geometry_t)(zathura_document_t* document, zathura_page_geometry_t* geometry);
 
 typedef zathura_error_t (*zathura_plugin_page_init_t)(zathura_page_t* page);
 typedef zathura_error_t (*zathura_plugin_page_clear_t)(zathura_page_t* page);
 typedef zathura_error_t (*zathura_plugin_page_search_text_t)(zathura_page_t* page, const char* text, zathura_search_flag_t flags, zathura_list_t** results);
 typedef zathura_error_t (*zathura_plugin_page_get_text_t)(zathura_page_t* page, char** text);
 typedef zathura_error_t (*zathura_plugin_page_get_selected_text_t)(zathura_page_t* page, char** text, zathura_rectangle_t rectangle);
+typedef zathura_error_t (*zathura_plugin_page_get_glyphs_t)(zathura_page_t* page, zathura_glyph_t** glyphs, size_t* number_of_glyphs);
 typedef zathura_error_t (*zathura_plugin_page_get_links_t)(zathura_page_t* page, zathura_list_t** links);
 typedef zathura_error_t (*zathura_plugin_page_get_form_fields_t)(zathura_page_t* page, zathura_list_t** form_fields);
 typedef zathura_error_t (*zathura_plugin_page_get_images_t)(zathura_page_t* page, zathura_list_t** images);
 typedef zathura_error_t (*zathura_plugin_page_get_annotations_t)(zathura_page_t* page, zathura_list_t** annotations);
 typedef zathura_error_t (*zathura_plugin_page_render_t)(zathura_page_t* page, zathura_image_buffer_t** buffer, double scale, int rotation, int flags);
+typedef zathura_error_t (*zathura_plugin_page_render_job_t)(zathura_page_t* page, zathura_image_buffer_t** buffer, double scale, int rotation, int flags, zathura_render_job_t* job);
+typedef zathura_error_t (*zathura_plugin_page_render_into_t)(zathura_page_t* page, zathura_image_buffer_t* buffer, double scale, int rotation, int flags);
+typedef zathura_error_t (*zathura_plugin_page_render_region_t)(zathura_page_t* page, zathura_image_buffer_t** buffer, double scale, int rotation, int flags, unsigned int x, unsigned int y, unsigned int width, unsigned int height);
 #ifdef HAVE_CAIRO
 typedef zathura_error_t (*zathura_plugin_page_render_cairo_t)(zathura_page_t* page, cairo_t* cairo, double scale, int rotation, int flags);
 #endif
@@ -102,12 +143,14 @@ typedef zathura_error_t (*zathura_plugin_form_field_render_cairo_t)(zathura_form
 typedef zathura_error_t (*zathura_plugin_form_field_save_t)(zathura_form_field_t* form_field);
 
 typedef zathura_error_t (*zathura_plugin_annotation_render_t)(zathura_annotation_t* annotation, zathura_image_buffer_t** buffer, double scale);
+typedef zathura_error_t (*zathura_plugin_annotation_render_into_t)(zathura_annotation_t* annotation, zathura_image_buffer_t* buffer, double scale, int x, int y);
 #ifdef HAVE_CAIRO
 typedef zathura_error_t (*zathura_plugin_annotation_render_cairo_t)(zathura_annotation_t* annotation, cairo_t* cairo, double scale);
 #endif
 
 /**
- * Struct to store functions exposed by the plugin
+ * Struct to store functions exposed by the plugin. New functions are appended
+ * at the end, so that the offsets of the existing ones do not change.
  */
 struct zathura_plugin_functions_s {
   /** Function to open document */
@@ -143,7 +186,12 @@ struct zathura_plugin_functions_s {
   /** Function to get selected text of a page */
   zathura_plugin_page_get_selected_text_t page_get_selected_text;
 
-  /** Function to get links on a page */
+  /**
+   * Function to get links on a page. Actions, annotations and form fields
+   * created by this function, page_get_form_fields and page_get_annotations
+   * are allocated together and released with the returned objects, so they
+   * must not be kept beyond them.
+   */
   zathura_plugin_page_get_links_t page_get_links;
 
   /** Function to get form fields of a page */
@@ -181,9 +229,52 @@ struct zathura_plugin_functions_s {
   /** Function to render an annotation to a cairo surface */
   zathura_plugin_annotation_render_cairo_t annotation_render_cairo;
 #endif
+
+  /** Function to render a region of a page (optional) */
+  zathura_plugin_page_render_region_t page_render_region;
+
+  /** Function to render a page as cancellable job (optional) */
+  zathura_plugin_page_render_job_t page_render_job;
+
+  /** Function to render a page into a given buffer (optional) */
+  zathura_plugin_page_render_into_t page_render_into;
+
+  /**
+   * Function to fill the preallocated geometry of all pages without
+   * initializing them (optional)
+   */
+  zathura_plugin_document_get_page_geometry_t document_get_page_geometry;
+
+  /**
+   * Function to open a document from memory (optional). The data stays valid
+   * until the document is freed, so the plugin may use it without copying.
+   */
+  zathura_plugin_document_open_data_t document_open_data;
+
+  /**
+   * Function to open a document from a file descriptor (optional). The
+   * descriptor stays open until the document is freed but is owned by the
+   * caller; its file offset is not guaranteed to be at the start.
+   */
+  zathura_plugin_document_open_fd_t document_open_fd;
+
+  /**
+   * Function to get the characters of a page in reading order. The array is
+   * allocated with malloc and owned by libzathura afterwards.
+   */
+  zathura_plugin_page_get_glyphs_t page_get_glyphs;
+
+  /**
+   * Function to render an annotation into a given transparent buffer
+   * (optional). The top left corner of the annotation is placed at the given
+   * pixel offset, which may be negative, and everything outside of the buffer
+   * is clipped.
+   */
+  zathura_plugin_annotation_render_into_t annotation_render_into;
 };
 
 zathura_error_t zathura_plugin_set_name(zathura_plugin_t* plugin, const char* name);
+zathura_error_t zathura_plugin_set_flags(zathura_plugin_t* plugin, zathura_plugin_flag_t flags);
 zathura_error_t zathura_plugin_set_register_function(zathura_plugin_t* plugin, zathura_plugin_register_function_t function);
 zathura_error_t zathura_plugin_add_mimetype(zathura_plugin_t* plugin, const char* mime_type);
 
@@ -193,6 +284,7 @@ zathura_error_t zathura_plugin_add_mimetype(zathura_plugin_t* plugin, const char
 #include "plugin-api/form-fields.h"
 #include "plugin-api/outline.h"
 #include "plugin-api/page.h"
+#include "plugin-api/render-job.h"
 #include "plugin-api/metadata.h"
 #include "plugin-api/transition.h"
 #include "plugin-api/action.h"
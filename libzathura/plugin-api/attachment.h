@@ -64,6 +64,73 @@ typedef zathura_error_t (*zathura_attachment_save_function_t)(zathura_attachment
  */
 zathura_error_t zathura_attachment_set_save_function(zathura_attachment_t* attachment, zathura_attachment_save_function_t save_function);
 
+/**
+ * Sets data of the attachment that is kept in memory by the plugin, e.g. as
+ * part of the mapped document. The data is not copied and has to stay valid
+ * until the free function is called or the attachment is freed.
+ *
+ * @param[in] attachment The attachment
+ * @param[in] data The data
+ * @param[in] size The size of data in bytes
+ * @param[in] free_function Releases the data, can be NULL
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_attachment_set_data_borrowed(zathura_attachment_t*
+    attachment, const char* data, uint64_t size, zathura_free_function_t
+    free_function);
+
+/**
+ * Sets a range of a file as the data of the attachment, e.g. an uncompressed
+ * stream of the document. The file is only opened when the data is read.
+ *
+ * @param[in] attachment The attachment
+ * @param[in] path The path of the file
+ * @param[in] offset The offset of the data in the file
+ * @param[in] size The size of the data in bytes
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed,
+ *   e.g. a range that exceeds the file
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The file does not exist
+ */
+zathura_error_t zathura_attachment_set_data_file(zathura_attachment_t*
+    attachment, const char* path, uint64_t offset, uint64_t size);
+
+/**
+ * A function type that can be used for a plugin to provide the data of an
+ * attachment on demand, e.g. to decompress it while it is read.
+ *
+ * @param[in] attachment The attachment
+ * @param[in] offset The offset of the requested data
+ * @param[out] buffer The buffer
+ * @param[in] length The number of requested bytes
+ * @param[out] bytes_read The number of provided bytes
+ * @param[in] user_data Custom user data (set by the plugin)
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+typedef zathura_error_t (*zathura_attachment_read_function_t)(zathura_attachment_t*
+    attachment, uint64_t offset, void* buffer, size_t length, size_t*
+    bytes_read, void* user_data);
+
+/**
+ * Sets a function that provides the data of the attachment on demand.
+ *
+ * @param[in] attachment The attachment
+ * @param[in] read_function The read function
+ * @param[in] size The size of the data in bytes
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_attachment_set_read_function(zathura_attachment_t*
+    attachment, zathura_attachment_read_function_t read_function, uint64_t
+    size);
+
 #ifdef __cplusplus
 }
 #endif
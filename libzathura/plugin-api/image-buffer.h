@@ -11,6 +11,17 @@ extern "C" {
 #include "../page.h"
 #include "../types.h"
 
+/**
+ * Sets the rowstride of the image buffer, i.e. the number of bytes between the
+ * start of two consecutive rows. The rows have to fit into the data allocated
+ * for the buffer.
+ *
+ * @param[in] buffer The image buffer
+ * @param[in] rowstride The rowstride of the buffer
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
 zathura_error_t zathura_image_buffer_set_rowstride(zathura_image_buffer_t*
     buffer, unsigned int rowstride);
 
@@ -96,6 +96,21 @@ zathura_error_t zathura_page_set_transition(zathura_page_t* page, zathura_page_t
 
 zathura_error_t zathura_page_set_duration(zathura_page_t* page, unsigned int duration);
 zathura_error_t zathura_page_set_crop_box(zathura_page_t* page, zathura_rectangle_t crop_box);
+
+/**
+ * Notifies the page that objects have been added to or removed from it. The
+ * page drops its cached objects of the given types and fetches them again on
+ * their next use, references held by callers stay valid.
+ *
+ * @param[in] page The page object
+ * @param[in] types The changed types of objects
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_page_objects_changed(zathura_page_t* page,
+    zathura_page_object_type_t types);
+
 #ifdef __cplusplus
 }
 #endif
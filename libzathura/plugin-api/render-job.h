@@ -0,0 +1,33 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_PLUGIN_API_RENDER_JOB_H
+#define LIBZATHURA_PLUGIN_API_RENDER_JOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../error.h"
+#include "../render-job.h"
+
+/**
+ * Reports an intermediate result of the render job to its progress callback.
+ * Plugins call this for example with a coarse preview before the final
+ * rendering is available.
+ *
+ * @param[in] job The render job
+ * @param[in] buffer The rendered image
+ * @param[in] quality The quality of the rendering
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_CANCELLED The job has been cancelled
+ */
+zathura_error_t zathura_render_job_report_progress(zathura_render_job_t* job,
+    zathura_image_buffer_t* buffer, zathura_render_quality_t quality);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLUGIN_API_RENDER_JOB_H */
@@ -1,8 +1,12 @@
 /* See LICENSE file for license and copyright information */
 
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <glib.h>
 #include <gmodule.h>
 
@@ -11,6 +15,7 @@
 #include "types.h"
 #include "version.h"
 #include "internal.h"
+#include "type-detector.h"
 
 typedef void (*zathura_plugin_register_service_t)(zathura_plugin_t*);
 
@@ -29,6 +34,7 @@ zathura_plugin_free(zathura_plugin_t* plugin)
     g_module_close(plugin->handle);
   }
 
+  g_free(plugin->cached_name);
   free(plugin->path);
   free(plugin);
 }
@@ -48,6 +54,17 @@ zathura_plugin_manager_new(zathura_plugin_manager_t** plugin_manager)
     goto error_ret;
   }
 
+  (*plugin_manager)->mime_types = g_hash_table_new_full(g_str_hash,
+      g_str_equal, g_free, NULL);
+  (*plugin_manager)->mime_type_aliases = g_hash_table_new_full(g_str_hash,
+      g_str_equal, g_free, g_free);
+
+  if ((error = zathura_type_detector_new(&((*plugin_manager)->type_detector))) != ZATHURA_ERROR_OK) {
+    zathura_plugin_manager_free(*plugin_manager);
+    *plugin_manager = NULL;
+    goto error_ret;
+  }
+
   return ZATHURA_ERROR_OK;
 
 error_ret:
@@ -62,6 +79,11 @@ zathura_plugin_manager_free(zathura_plugin_manager_t* plugin_manager)
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  g_free(plugin_manager->index_path);
+  g_hash_table_destroy(plugin_manager->mime_types);
+  g_hash_table_destroy(plugin_manager->mime_type_aliases);
+  zathura_type_detector_free(plugin_manager->type_detector);
+
   /* free plugins */
   if (plugin_manager->plugins != NULL) {
     zathura_list_free_full(plugin_manager->plugins, (zathura_free_function_t) zathura_plugin_free);
@@ -73,6 +95,62 @@ zathura_plugin_manager_free(zathura_plugin_manager_t* plugin_manager)
   return ZATHURA_ERROR_OK;
 }
 
+static zathura_error_t
+plugin_open_module(const char* path, GModule** handle,
+    zathura_plugin_register_service_t* register_service,
+    zathura_plugin_version_t** version)
+{
+  /* load module */
+  *handle = g_module_open(path, G_MODULE_BIND_LOCAL);
+  if (*handle == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* resolve symbols */
+  *register_service = NULL;
+  *version = NULL;
+  if (g_module_symbol(*handle, PLUGIN_REGISTER_FUNCTION, (gpointer*)
+        register_service) == FALSE || *register_service == NULL ||
+      g_module_symbol(*handle, PLUGIN_VERSION_INFO, (gpointer*) version) ==
+        FALSE || *version == NULL) {
+    g_module_close(*handle);
+    *handle = NULL;
+    return ZATHURA_ERROR_PLUGIN_RESOLVE_SYMBOL;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_error_t
+plugin_manager_register(zathura_plugin_manager_t* plugin_manager,
+    zathura_plugin_t* plugin)
+{
+  /* add plugin to the list */
+  plugin_manager->plugins = zathura_list_append(plugin_manager->plugins, plugin);
+  if (plugin_manager->plugins == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  /* index supported mime types, plugins loaded earlier take precedence */
+  char* mime_type = NULL;
+  ZATHURA_LIST_FOREACH(mime_type, plugin->mimetypes) {
+    if (mime_type == NULL) {
+      continue;
+    }
+
+    zathura_type_detector_enable_mime_type(plugin_manager->type_detector, mime_type);
+
+    char* key = g_ascii_strdown(mime_type, -1);
+    if (g_hash_table_contains(plugin_manager->mime_types, key) == FALSE) {
+      g_hash_table_insert(plugin_manager->mime_types, key, plugin);
+    } else {
+      g_free(key);
+    }
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
 zathura_error_t
 zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager, const char* path)
 {
@@ -93,25 +171,10 @@ zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager, const char
   }
 
   /* load module */
-  handle = g_module_open(real_path, G_MODULE_BIND_LOCAL);
-  if (handle == NULL) {
-    free(real_path);
-    error = ZATHURA_ERROR_INVALID_ARGUMENTS;
-    goto error_ret;
-  }
-
-  /* resolve symbols */
   zathura_plugin_register_service_t register_service = NULL;
-  if (g_module_symbol(handle, PLUGIN_REGISTER_FUNCTION, (gpointer*)
-        &register_service) == FALSE || register_service == NULL) {
-    error = ZATHURA_ERROR_PLUGIN_RESOLVE_SYMBOL;
-    goto error_free;
-  }
-
   zathura_plugin_version_t* plugin_version = NULL;
-  if (g_module_symbol(handle, PLUGIN_VERSION_INFO, (gpointer*)
-        &plugin_version) == FALSE || plugin_version == NULL) {
-    error = ZATHURA_ERROR_PLUGIN_RESOLVE_SYMBOL;
+  if ((error = plugin_open_module(real_path, &handle, &register_service,
+          &plugin_version)) != ZATHURA_ERROR_OK) {
     goto error_free;
   }
 
@@ -123,8 +186,6 @@ zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager, const char
   }
 
   /* setup plugin */
-  plugin->handle        = handle;
-  plugin->path          = real_path;
   plugin->version.major = plugin_version->major;
   plugin->version.minor = plugin_version->minor;
   plugin->version.rev   = plugin_version->rev;
@@ -132,18 +193,20 @@ zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager, const char
   register_service(plugin);
 
   if (plugin->register_function == NULL || plugin->name == NULL) {
-    free(plugin->path);
     error = ZATHURA_ERROR_OUT_OF_MEMORY;
     goto error_free;
   }
 
   /* register functions */
   plugin->register_function(&(plugin->functions));
+  zathura_plugin_update_capabilities(plugin);
 
-  /* add plugin to the list */
-  plugin_manager->plugins = zathura_list_append(plugin_manager->plugins, plugin);
-  if (plugin_manager->plugins == NULL) {
-    error = ZATHURA_ERROR_OUT_OF_MEMORY;
+  plugin->handle = handle;
+  plugin->path   = real_path;
+
+  if ((error = plugin_manager_register(plugin_manager, plugin)) != ZATHURA_ERROR_OK) {
+    plugin->handle = NULL;
+    plugin->path   = NULL;
     goto error_free;
   }
 
@@ -152,6 +215,9 @@ zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_manager, const char
 error_free:
 
   if (plugin != NULL) {
+    if (plugin->mimetypes != NULL) {
+      zathura_list_free_full(plugin->mimetypes, g_free);
+    }
     free(plugin);
   }
 
@@ -168,6 +234,186 @@ error_ret:
   return error;
 }
 
+/* Serializes loading the modules of plugins registered from the index */
+static GMutex module_lock;
+
+zathura_error_t
+zathura_plugin_load_module(zathura_plugin_t* plugin)
+{
+  if (plugin == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_mutex_lock(&module_lock);
+
+  if (plugin->handle != NULL) {
+    g_mutex_unlock(&module_lock);
+    return ZATHURA_ERROR_OK;
+  }
+
+  GModule* handle = NULL;
+  zathura_plugin_register_service_t register_service = NULL;
+  zathura_plugin_version_t* plugin_version = NULL;
+  zathura_error_t error = plugin_open_module(plugin->path, &handle,
+      &register_service, &plugin_version);
+  if (error != ZATHURA_ERROR_OK) {
+    g_mutex_unlock(&module_lock);
+    return error;
+  }
+
+  /* The plugin has been replaced without the index noticing */
+  if (plugin_version->major != plugin->version.major ||
+      plugin_version->minor != plugin->version.minor ||
+      plugin_version->rev   != plugin->version.rev) {
+    g_module_close(handle);
+    g_mutex_unlock(&module_lock);
+    return ZATHURA_ERROR_PLUGIN_VERSION;
+  }
+
+  /* Name and mime types are already known from the index, only the register
+   * function is taken from the description */
+  zathura_plugin_t description = { 0 };
+  register_service(&description);
+  if (description.mimetypes != NULL) {
+    zathura_list_free_full(description.mimetypes, g_free);
+  }
+
+  if (description.register_function == NULL) {
+    g_module_close(handle);
+    g_mutex_unlock(&module_lock);
+    return ZATHURA_ERROR_PLUGIN_RESOLVE_SYMBOL;
+  }
+
+  plugin->register_function = description.register_function;
+  plugin->register_function(&(plugin->functions));
+  zathura_plugin_update_capabilities(plugin);
+  plugin->handle = handle;
+
+  g_mutex_unlock(&module_lock);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_plugin_manager_set_index_file(zathura_plugin_manager_t* plugin_manager,
+    const char* path)
+{
+  if (plugin_manager == NULL || (path != NULL && strlen(path) == 0)) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_free(plugin_manager->index_path);
+  plugin_manager->index_path = g_strdup(path);
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Checks whether the index entry of a module describes its current state */
+static bool
+plugin_index_entry_is_current(GKeyFile* index, const char* path, const struct
+    stat* file_stat)
+{
+  if (g_key_file_has_group(index, path) == FALSE) {
+    return false;
+  }
+
+  GError* error = NULL;
+  const gint64 mtime      = g_key_file_get_int64(index, path, "mtime", &error);
+  const gint64 mtime_nsec = (error == NULL) ? g_key_file_get_int64(index, path, "mtime-nsec", &error) : 0;
+  const gint64 size       = (error == NULL) ? g_key_file_get_int64(index, path, "size", &error) : 0;
+  if (error != NULL) {
+    g_error_free(error);
+    return false;
+  }
+
+  return mtime == (gint64) file_stat->st_mtim.tv_sec &&
+    mtime_nsec == (gint64) file_stat->st_mtim.tv_nsec &&
+    size == (gint64) file_stat->st_size;
+}
+
+/* Registers a plugin from its index entry without loading its module */
+static zathura_error_t
+plugin_manager_register_from_index(zathura_plugin_manager_t* plugin_manager,
+    GKeyFile* index, const char* path)
+{
+  char* name = g_key_file_get_string(index, path, "name", NULL);
+  if (name == NULL) {
+    /* the file is known not to be a plugin */
+    return ZATHURA_ERROR_OK;
+  }
+
+  gsize number_of_mime_types = 0;
+  char** mime_types = g_key_file_get_string_list(index, path, "mimetypes",
+      &number_of_mime_types, NULL);
+
+  zathura_plugin_t* plugin = calloc(1, sizeof(*plugin));
+  if (plugin == NULL) {
+    g_free(name);
+    g_strfreev(mime_types);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  plugin->path          = strdup(path);
+  plugin->name          = name;
+  plugin->cached_name   = name;
+  plugin->flags         = g_key_file_get_integer(index, path, "flags", NULL);
+  plugin->capabilities  = g_key_file_get_integer(index, path, "capabilities", NULL);
+  plugin->version.major = g_key_file_get_integer(index, path, "major", NULL);
+  plugin->version.minor = g_key_file_get_integer(index, path, "minor", NULL);
+  plugin->version.rev   = g_key_file_get_integer(index, path, "rev", NULL);
+
+  for (gsize i = 0; i < number_of_mime_types; i++) {
+    zathura_plugin_add_mimetype(plugin, mime_types[i]);
+  }
+  g_strfreev(mime_types);
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  if (plugin->path == NULL) {
+    error = ZATHURA_ERROR_OUT_OF_MEMORY;
+  } else {
+    error = plugin_manager_register(plugin_manager, plugin);
+  }
+
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_plugin_free(plugin);
+  }
+
+  return error;
+}
+
+static void
+plugin_index_set_entry(GKeyFile* index, const char* path, const struct stat*
+    file_stat, zathura_plugin_t* plugin)
+{
+  g_key_file_remove_group(index, path, NULL);
+
+  g_key_file_set_int64(index, path, "mtime", file_stat->st_mtim.tv_sec);
+  g_key_file_set_int64(index, path, "mtime-nsec", file_stat->st_mtim.tv_nsec);
+  g_key_file_set_int64(index, path, "size", file_stat->st_size);
+
+  if (plugin == NULL) {
+    return;
+  }
+
+  g_key_file_set_string(index, path, "name", plugin->name);
+  g_key_file_set_integer(index, path, "flags", plugin->flags);
+  g_key_file_set_integer(index, path, "capabilities", plugin->capabilities);
+  g_key_file_set_integer(index, path, "major", plugin->version.major);
+  g_key_file_set_integer(index, path, "minor", plugin->version.minor);
+  g_key_file_set_integer(index, path, "rev", plugin->version.rev);
+
+  const unsigned int number_of_mime_types = zathura_list_length(plugin->mimetypes);
+  const char** mime_types = g_new0(const char*, number_of_mime_types + 1);
+  unsigned int i = 0;
+  char* mime_type = NULL;
+  ZATHURA_LIST_FOREACH(mime_type, plugin->mimetypes) {
+    mime_types[i++] = mime_type;
+  }
+
+  g_key_file_set_string_list(index, path, "mimetypes", mime_types, i);
+  g_free(mime_types);
+}
+
 zathura_error_t
 zathura_plugin_manager_load_dir(zathura_plugin_manager_t* plugin_manager, const
     char* directory)
@@ -182,6 +428,20 @@ zathura_plugin_manager_load_dir(zathura_plugin_manager_t* plugin_manager, const
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  /* The index maps modules to the plugins they contain, so that modules only
+   * have to be loaded once a document of their type is opened */
+  GKeyFile* index = NULL;
+  GHashTable* seen = NULL;
+  bool index_changed = false;
+  if (plugin_manager->index_path != NULL) {
+    index = g_key_file_new();
+    if (g_key_file_load_from_file(index, plugin_manager->index_path,
+          G_KEY_FILE_NONE, NULL) == FALSE) {
+      index_changed = true;
+    }
+    seen = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL);
+  }
+
   /* read files */
   char* name;
   while ((name = (char*) g_dir_read_name(dir)) != NULL) {
@@ -191,16 +451,71 @@ zathura_plugin_manager_load_dir(zathura_plugin_manager_t* plugin_manager, const
       continue;
     }
 
-    zathura_plugin_manager_load(plugin_manager, path);
+    if (index == NULL) {
+      zathura_plugin_manager_load(plugin_manager, path);
+      g_free(path);
+      continue;
+    }
+
+    char* real_path = NULL;
+    struct stat file_stat;
+    if (zathura_realpath(path, &real_path) != ZATHURA_ERROR_OK ||
+        stat(real_path, &file_stat) != 0) {
+      free(real_path);
+      g_free(path);
+      continue;
+    }
     g_free(path);
+
+    g_hash_table_add(seen, real_path);
+
+    if (plugin_index_entry_is_current(index, real_path, &file_stat) == true) {
+      plugin_manager_register_from_index(plugin_manager, index, real_path);
+      continue;
+    }
+
+    /* new or modified module */
+    zathura_plugin_t* plugin = NULL;
+    if (zathura_plugin_manager_load(plugin_manager, real_path) == ZATHURA_ERROR_OK) {
+      plugin = zathura_list_nth_data(plugin_manager->plugins,
+          zathura_list_length(plugin_manager->plugins) - 1);
+    }
+
+    plugin_index_set_entry(index, real_path, &file_stat, plugin);
+    index_changed = true;
   }
 
   g_dir_close(dir);
 
+  if (index != NULL) {
+    /* forget modules that have been removed from the directory */
+    char* real_directory = NULL;
+    if (zathura_realpath(directory, &real_directory) == ZATHURA_ERROR_OK) {
+      char** groups = g_key_file_get_groups(index, NULL);
+      for (char** group = groups; group != NULL && *group != NULL; group++) {
+        char* group_directory = g_path_get_dirname(*group);
+        if (strcmp(group_directory, real_directory) == 0 &&
+            g_hash_table_contains(seen, *group) == FALSE) {
+          g_key_file_remove_group(index, *group, NULL);
+          index_changed = true;
+        }
+        g_free(group_directory);
+      }
+      g_strfreev(groups);
+      free(real_directory);
+    }
+
+    if (index_changed == true) {
+      g_key_file_save_to_file(index, plugin_manager->index_path, NULL);
+    }
+
+    g_hash_table_destroy(seen);
+    g_key_file_free(index);
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
-
 zathura_error_t
 zathura_plugin_manager_get_plugins(zathura_plugin_manager_t* plugin_manager,
     zathura_list_t** plugins)
@@ -226,24 +541,87 @@ zathura_plugin_manager_get_plugin(zathura_plugin_manager_t* plugin_manager,
     return ZATHURA_ERROR_UNKNOWN;
   }
 
-  for (unsigned int i = 0; i < zathura_list_length(plugin_manager->plugins); i++) {
-    zathura_plugin_t* tmp_plugin = (zathura_plugin_t*) zathura_list_nth_data(plugin_manager->plugins, i);
-    if (tmp_plugin == NULL || tmp_plugin->mimetypes == NULL) {
-      continue;
-    }
+  char* key = g_ascii_strdown(mime_type, -1);
 
-    for (unsigned int j = 0; j < zathura_list_length(tmp_plugin->mimetypes); j++) {
-      char* tmp_mime_type = (char*) zathura_list_nth_data(tmp_plugin->mimetypes, j);
-      if (tmp_mime_type == NULL) {
-        continue;
-      }
+  const char* canonical_mime_type = g_hash_table_lookup(plugin_manager->mime_type_aliases, key);
+  if (canonical_mime_type == NULL) {
+    canonical_mime_type = key;
+  }
 
-      if (strcmp(mime_type, tmp_mime_type) == 0) {
-        *plugin = tmp_plugin;
-        return ZATHURA_ERROR_OK;
-      }
-    }
+  zathura_plugin_t* tmp_plugin = g_hash_table_lookup(plugin_manager->mime_types, canonical_mime_type);
+
+  /* fall back to plugins registered for all subtypes of the type */
+  const char* separator = strchr(canonical_mime_type, '/');
+  if (tmp_plugin == NULL && separator != NULL) {
+    char* wildcard = g_strdup_printf("%.*s/*", (int) (separator - canonical_mime_type),
+        canonical_mime_type);
+    tmp_plugin = g_hash_table_lookup(plugin_manager->mime_types, wildcard);
+    g_free(wildcard);
+  }
+
+  g_free(key);
+
+  if (tmp_plugin == NULL) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  /* plugins registered from the index are loaded on first use */
+  zathura_error_t error = zathura_plugin_load_module(tmp_plugin);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  *plugin = tmp_plugin;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_plugin_manager_add_mime_type_alias(zathura_plugin_manager_t*
+    plugin_manager, const char* alias, const char* mime_type)
+{
+  if (plugin_manager == NULL || alias == NULL || strlen(alias) == 0 ||
+      mime_type == NULL || strlen(mime_type) == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_hash_table_replace(plugin_manager->mime_type_aliases,
+      g_ascii_strdown(alias, -1), g_ascii_strdown(mime_type, -1));
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_plugin_manager_guess_type(zathura_plugin_manager_t* plugin_manager,
+    const char* path, char** mime_type)
+{
+  if (plugin_manager == NULL || path == NULL || strlen(path) == 0 || mime_type == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return zathura_type_detector_guess(plugin_manager->type_detector, path, mime_type);
+}
+
+zathura_error_t
+zathura_plugin_manager_guess_type_from_data(zathura_plugin_manager_t*
+    plugin_manager, const void* data, size_t length, char** mime_type)
+{
+  if (plugin_manager == NULL || data == NULL || length == 0 || mime_type == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return zathura_type_detector_guess_data(plugin_manager->type_detector, data,
+      length, mime_type);
+}
+
+zathura_error_t
+zathura_plugin_manager_guess_type_from_fd(zathura_plugin_manager_t*
+    plugin_manager, int fd, char** mime_type)
+{
+  if (plugin_manager == NULL || fd < 0 || mime_type == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
-  return ZATHURA_ERROR_UNKNOWN;
+  return zathura_type_detector_guess_fd(plugin_manager->type_detector, fd,
+      mime_type);
 }
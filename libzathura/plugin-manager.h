@@ -64,6 +64,24 @@ zathura_error_t zathura_plugin_manager_load(zathura_plugin_manager_t* plugin_man
  */
 zathura_error_t zathura_plugin_manager_load_dir(zathura_plugin_manager_t* plugin_manager, const char* directory);
 
+/**
+ * Sets the file used as index of the plugins found by
+ * zathura_plugin_manager_load_dir. The index records name, version, flags and
+ * mime types of every module together with its modification time and size.
+ * Modules whose entry is still current are registered without being loaded;
+ * their module is only loaded once a plugin for one of their mime types is
+ * requested with zathura_plugin_manager_get_plugin. New and modified modules
+ * are loaded and the index is rewritten.
+ *
+ * @param[in] plugin_manager The plugin manager
+ * @param[in] path The path of the index file or NULL to load all modules
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_plugin_manager_set_index_file(zathura_plugin_manager_t*
+    plugin_manager, const char* path);
+
 /**
  * Returns the list of plugins that are managed by the plugin manager
  *
@@ -76,7 +94,26 @@ zathura_error_t zathura_plugin_manager_load_dir(zathura_plugin_manager_t* plugin
 zathura_error_t zathura_plugin_manager_get_plugins(zathura_plugin_manager_t* plugin_manager, zathura_list_t** plugins);
 
 /**
- * Get a plugin that supports the given mime type
+ * Registers an alias of a mime type, e.g. application/x-pdf for
+ * application/pdf. Plugins supporting the mime type are then also used for
+ * the alias.
+ *
+ * @param[in] plugin_manager The plugin manager
+ * @param[in] alias The alias
+ * @param[in] mime_type The mime type the alias stands for
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_plugin_manager_add_mime_type_alias(zathura_plugin_manager_t*
+    plugin_manager, const char* alias, const char* mime_type);
+
+/**
+ * Get a plugin that supports the given mime type. Mime types are compared
+ * case-insensitively and aliases are resolved. If no plugin supports the mime
+ * type itself, a plugin registered for all subtypes of its type is returned,
+ * e.g. a plugin registered for "image/" followed by an asterisk. If several plugins support a mime type, the plugin that has been
+ * loaded first is used.
  *
  * @param[in] plugin_manager The plugin manager
  * @param[in] mime_type The mime type
@@ -88,6 +125,61 @@ zathura_error_t zathura_plugin_manager_get_plugins(zathura_plugin_manager_t* plu
  */
 zathura_error_t zathura_plugin_manager_get_plugin(zathura_plugin_manager_t* plugin_manager, zathura_plugin_t** plugin, const char* mime_type);
 
+/**
+ * Detects the mime type of the given file. Files of the formats supported by
+ * the loaded plugins are recognized by their signature, other files with
+ * libmagic. The plugin manager keeps the magic database loaded and caches the
+ * types of files until they are modified, so it should be reused for many
+ * detections.
+ *
+ * @param[in] plugin_manager The plugin manager
+ * @param[in] path The path of the file
+ * @param[out] mime_type The mime type, has to be freed with free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+zathura_error_t zathura_plugin_manager_guess_type(zathura_plugin_manager_t*
+    plugin_manager, const char* path, char** mime_type);
+
+/**
+ * Detects the mime type of in-memory data, e.g. a document received over a
+ * socket, without writing it to a file first. Only the first 64 KiB of the
+ * data are inspected.
+ *
+ * @param[in] plugin_manager The plugin manager
+ * @param[in] data The data
+ * @param[in] length The length of the data
+ * @param[out] mime_type The mime type, has to be freed with free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+zathura_error_t zathura_plugin_manager_guess_type_from_data(zathura_plugin_manager_t*
+    plugin_manager, const void* data, size_t length, char** mime_type);
+
+/**
+ * Detects the mime type of the file referred to by a file descriptor. The
+ * start of the file is read without changing the file offset, so the
+ * descriptor can be passed to zathura_plugin_open_document_from_fd
+ * afterwards. Only regular files are supported; data from pipes and sockets
+ * has to be read into memory and passed to
+ * zathura_plugin_manager_guess_type_from_data.
+ *
+ * @param[in] plugin_manager The plugin manager
+ * @param[in] fd The file descriptor
+ * @param[out] mime_type The mime type, has to be freed with free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+zathura_error_t zathura_plugin_manager_guess_type_from_fd(zathura_plugin_manager_t*
+    plugin_manager, int fd, char** mime_type);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,73 @@ zathura_plugin_get_version(zathura_plugin_t* plugin, zathura_plugin_version_t*
   return ZATHURA_ERROR_OK;
 }
 
+zathura_error_t
+zathura_plugin_get_flags(zathura_plugin_t* plugin, zathura_plugin_flag_t* flags)
+{
+  if (plugin == NULL || flags == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *flags = plugin->flags;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_plugin_get_capabilities(zathura_plugin_t* plugin,
+    zathura_plugin_capability_t* capabilities)
+{
+  if (plugin == NULL || capabilities == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *capabilities = plugin->capabilities;
+
+  return ZATHURA_ERROR_OK;
+}
+
+void
+zathura_plugin_update_capabilities(zathura_plugin_t* plugin)
+{
+  const zathura_plugin_functions_t* functions = &(plugin->functions);
+  zathura_plugin_capability_t capabilities = ZATHURA_PLUGIN_CAPABILITY_NONE;
+
+#define HAS_FUNCTION(function, capability) \
+  if (functions->function != NULL) { \
+    capabilities |= (capability); \
+  }
+
+  HAS_FUNCTION(document_open_data,         ZATHURA_PLUGIN_CAPABILITY_OPEN_DATA)
+  HAS_FUNCTION(document_open_fd,           ZATHURA_PLUGIN_CAPABILITY_OPEN_FD)
+  HAS_FUNCTION(document_save_as,           ZATHURA_PLUGIN_CAPABILITY_SAVE)
+  HAS_FUNCTION(document_get_outline,       ZATHURA_PLUGIN_CAPABILITY_OUTLINE)
+  HAS_FUNCTION(document_get_attachments,   ZATHURA_PLUGIN_CAPABILITY_ATTACHMENTS)
+  HAS_FUNCTION(document_get_metadata,      ZATHURA_PLUGIN_CAPABILITY_METADATA)
+  HAS_FUNCTION(document_get_page_geometry, ZATHURA_PLUGIN_CAPABILITY_PAGE_GEOMETRY)
+  HAS_FUNCTION(page_get_text,              ZATHURA_PLUGIN_CAPABILITY_TEXT)
+  HAS_FUNCTION(page_get_selected_text,     ZATHURA_PLUGIN_CAPABILITY_SELECTED_TEXT)
+  HAS_FUNCTION(page_get_glyphs,            ZATHURA_PLUGIN_CAPABILITY_GLYPHS)
+  HAS_FUNCTION(page_search_text,           ZATHURA_PLUGIN_CAPABILITY_SEARCH)
+  HAS_FUNCTION(page_get_links,             ZATHURA_PLUGIN_CAPABILITY_LINKS)
+  HAS_FUNCTION(page_get_form_fields,       ZATHURA_PLUGIN_CAPABILITY_FORM_FIELDS)
+  HAS_FUNCTION(page_get_images,            ZATHURA_PLUGIN_CAPABILITY_IMAGES)
+  HAS_FUNCTION(page_get_annotations,       ZATHURA_PLUGIN_CAPABILITY_ANNOTATIONS)
+  HAS_FUNCTION(page_render,                ZATHURA_PLUGIN_CAPABILITY_RENDER)
+#ifdef HAVE_CAIRO
+  HAS_FUNCTION(page_render_cairo,          ZATHURA_PLUGIN_CAPABILITY_RENDER_CAIRO)
+#endif
+  HAS_FUNCTION(page_render_job,            ZATHURA_PLUGIN_CAPABILITY_RENDER_JOB)
+  HAS_FUNCTION(page_render_into,           ZATHURA_PLUGIN_CAPABILITY_RENDER_INTO)
+  HAS_FUNCTION(page_render_region,         ZATHURA_PLUGIN_CAPABILITY_RENDER_REGION)
+  HAS_FUNCTION(form_field_save,            ZATHURA_PLUGIN_CAPABILITY_FORM_FIELD_SAVE)
+  HAS_FUNCTION(annotation_render,          ZATHURA_PLUGIN_CAPABILITY_ANNOTATION_RENDER)
+  HAS_FUNCTION(annotation_render_into,     ZATHURA_PLUGIN_CAPABILITY_ANNOTATION_RENDER_INTO)
+
+#undef HAS_FUNCTION
+
+  plugin->capabilities = capabilities;
+}
+
 zathura_error_t
 zathura_plugin_get_functions(zathura_plugin_t* plugin,
     zathura_plugin_functions_t** functions)
@@ -64,11 +131,59 @@ zathura_plugin_get_functions(zathura_plugin_t* plugin,
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  zathura_error_t error = zathura_plugin_load_module(plugin);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
   *functions = &(plugin->functions);
 
   return ZATHURA_ERROR_OK;
 }
 
+/* Creates the document that is passed to the open function of the plugin */
+static zathura_error_t
+plugin_document_new(zathura_plugin_t* plugin, zathura_document_t** document,
+    char* real_path, const char* password)
+{
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  /* Create document */
+  if ((error = zathura_document_new(document)) != ZATHURA_ERROR_OK) {
+    free(real_path);
+    return error;
+  }
+
+  /* Initialize document */
+  (*document)->path     = real_path;
+  (*document)->password = (password != NULL) ? g_strdup(password) : NULL;
+  (*document)->plugin   = plugin;
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Completes the document once the plugin returned from its open function */
+static zathura_error_t
+plugin_document_opened(zathura_document_t** document, zathura_error_t error)
+{
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_document_free(*document);
+    *document = NULL;
+    return error;
+  }
+
+  /* Allocate page slots; the pages themselves are created on first access in
+   * zathura_document_get_page */
+  (*document)->pages = calloc((*document)->number_of_pages, sizeof(*((*document)->pages)));
+  if ((*document)->pages == NULL) {
+    zathura_document_free(*document);
+    *document = NULL;
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
 zathura_error_t
 zathura_plugin_open_document(zathura_plugin_t* plugin, zathura_document_t**
     document, const char* path, const char* password)
@@ -77,6 +192,11 @@ zathura_plugin_open_document(zathura_plugin_t* plugin, zathura_document_t**
     return ZATHURA_ERROR_INVALID_ARGUMENTS;
   }
 
+  zathura_error_t error = zathura_plugin_load_module(plugin);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
   /* Check if open document function is set */
   if (plugin->functions.document_open == NULL) {
     return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
@@ -87,49 +207,68 @@ zathura_plugin_open_document(zathura_plugin_t* plugin, zathura_document_t**
     return ZATHURA_ERROR_DOCUMENT_DOES_NOT_EXIST;
   }
 
-  zathura_error_t error = ZATHURA_ERROR_OK;
-
   /* Determine real path */
   char* real_path;
   if ((error = zathura_realpath(path, &real_path)) != ZATHURA_ERROR_OK) {
     return error;
   }
 
-  /* Create document */
-  if ((error = zathura_document_new(document)) != ZATHURA_ERROR_OK) {
-    free(real_path);
+  if ((error = plugin_document_new(plugin, document, real_path, password)) != ZATHURA_ERROR_OK) {
     return error;
   }
 
-  /* Initialize document */
-  (*document)->path     = real_path;
-  (*document)->password = (password != NULL) ? g_strdup(password) : NULL;
-  (*document)->plugin   = plugin;
-
   /* Open document */
-  error = plugin->functions.document_open(*document);
+  return plugin_document_opened(document,
+      plugin->functions.document_open(*document));
+}
+
+zathura_error_t
+zathura_plugin_open_document_from_data(zathura_plugin_t* plugin,
+    zathura_document_t** document, const void* data, size_t length, const char*
+    password)
+{
+  if (plugin == NULL || document == NULL || data == NULL || length == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = zathura_plugin_load_module(plugin);
   if (error != ZATHURA_ERROR_OK) {
-    zathura_document_free(*document);
-    *document = NULL;
     return error;
   }
 
-  /* Allocate pages */
-  (*document)->pages = calloc((*document)->number_of_pages, sizeof(*((*document)->pages)));
-  if ((*document)->pages == NULL) {
-    zathura_document_free(*document);
-    *document = NULL;
-    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  if (plugin->functions.document_open_data == NULL) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
   }
 
-  for (unsigned int pid = 0; pid < (*document)->number_of_pages; pid++) {
-    zathura_error_t error = zathura_document_get_page(*document, pid, &((*document)->pages[pid]));
-    if (error != ZATHURA_ERROR_OK) {
-      zathura_document_free(*document);
-      *document = NULL;
-      return error;
-    }
+  if ((error = plugin_document_new(plugin, document, NULL, password)) != ZATHURA_ERROR_OK) {
+    return error;
   }
 
-  return ZATHURA_ERROR_OK;
+  return plugin_document_opened(document,
+      plugin->functions.document_open_data(*document, data, length));
+}
+
+zathura_error_t
+zathura_plugin_open_document_from_fd(zathura_plugin_t* plugin,
+    zathura_document_t** document, int fd, const char* password)
+{
+  if (plugin == NULL || document == NULL || fd < 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_error_t error = zathura_plugin_load_module(plugin);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  if (plugin->functions.document_open_fd == NULL) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  if ((error = plugin_document_new(plugin, document, NULL, password)) != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  return plugin_document_opened(document,
+      plugin->functions.document_open_fd(*document, fd));
 }
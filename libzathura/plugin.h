@@ -7,12 +7,69 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+
 #include "document.h"
 #include "error.h"
 
 typedef struct zathura_plugin_s zathura_plugin_t;
 typedef struct zathura_plugin_functions_s zathura_plugin_functions_t;
 
+/**
+ * Flags describing properties of a plugin
+ */
+typedef enum zathura_plugin_flag_e {
+  /**
+   * No flags set
+   */
+  ZATHURA_PLUGIN_FLAG_NONE = 0,
+
+  /**
+   * The page_render and page_render_cairo functions of the plugin may be
+   * called concurrently from multiple threads on pages of the same document.
+   * Without this flag all calls into the plugin for one document are
+   * serialized.
+   */
+  ZATHURA_PLUGIN_FLAG_REENTRANT_RENDER = 1 << 0,
+
+  /**
+   * The page_search_text function of the plugin may be called concurrently
+   * from multiple threads on pages of the same document, so that
+   * zathura_document_search_text searches pages in parallel.
+   */
+  ZATHURA_PLUGIN_FLAG_REENTRANT_SEARCH = 1 << 1
+} zathura_plugin_flag_t;
+
+/**
+ * Features implemented by a plugin
+ */
+typedef enum zathura_plugin_capability_e {
+  ZATHURA_PLUGIN_CAPABILITY_NONE = 0, /**< No optional feature */
+  ZATHURA_PLUGIN_CAPABILITY_OPEN_DATA = 1 << 0, /**< Documents can be opened from memory */
+  ZATHURA_PLUGIN_CAPABILITY_OPEN_FD = 1 << 1, /**< Documents can be opened from file descriptors */
+  ZATHURA_PLUGIN_CAPABILITY_SAVE = 1 << 2, /**< Documents can be saved */
+  ZATHURA_PLUGIN_CAPABILITY_OUTLINE = 1 << 3, /**< The outline of documents is available */
+  ZATHURA_PLUGIN_CAPABILITY_ATTACHMENTS = 1 << 4, /**< Attachments of documents are available */
+  ZATHURA_PLUGIN_CAPABILITY_METADATA = 1 << 5, /**< Metadata of documents is available */
+  ZATHURA_PLUGIN_CAPABILITY_PAGE_GEOMETRY = 1 << 6, /**< Page sizes are known without initializing pages */
+  ZATHURA_PLUGIN_CAPABILITY_TEXT = 1 << 7, /**< The text of pages can be extracted */
+  ZATHURA_PLUGIN_CAPABILITY_SELECTED_TEXT = 1 << 8, /**< The text of regions of pages can be extracted */
+  ZATHURA_PLUGIN_CAPABILITY_SEARCH = 1 << 9, /**< Pages can be searched */
+  ZATHURA_PLUGIN_CAPABILITY_LINKS = 1 << 10, /**< Links of pages are available */
+  ZATHURA_PLUGIN_CAPABILITY_FORM_FIELDS = 1 << 11, /**< Form fields of pages are available */
+  ZATHURA_PLUGIN_CAPABILITY_IMAGES = 1 << 12, /**< Images of pages are available */
+  ZATHURA_PLUGIN_CAPABILITY_ANNOTATIONS = 1 << 13, /**< Annotations of pages are available */
+  ZATHURA_PLUGIN_CAPABILITY_RENDER = 1 << 14, /**< Pages can be rendered to image buffers */
+  ZATHURA_PLUGIN_CAPABILITY_RENDER_CAIRO = 1 << 15, /**< Pages can be rendered with cairo */
+  ZATHURA_PLUGIN_CAPABILITY_RENDER_JOB = 1 << 16, /**< Rendering can be cancelled while in progress */
+  ZATHURA_PLUGIN_CAPABILITY_RENDER_INTO = 1 << 17, /**< Pages are rendered directly into given buffers */
+  ZATHURA_PLUGIN_CAPABILITY_RENDER_REGION = 1 << 18, /**< Regions of pages are rendered without the full page */
+  ZATHURA_PLUGIN_CAPABILITY_FORM_FIELD_SAVE = 1 << 19, /**< Changed form fields can be saved */
+  ZATHURA_PLUGIN_CAPABILITY_ANNOTATION_RENDER = 1 << 20, /**< Annotations can be rendered */
+  ZATHURA_PLUGIN_CAPABILITY_GLYPHS = 1 << 21, /**< The characters of pages can be extracted with their positions */
+  ZATHURA_PLUGIN_CAPABILITY_ANNOTATION_RENDER_INTO = 1 << 22 /**< Annotations are rendered directly into given buffers */
+} zathura_plugin_capability_t;
+
 typedef struct zathura_plugin_version_s {
   unsigned int major; /**< Major version of the plugin */
   unsigned int minor; /**< Minor version of the plugin */
@@ -55,6 +112,33 @@ zathura_error_t zathura_plugin_get_path(zathura_plugin_t* plugin, const char** p
  */
 zathura_error_t zathura_plugin_get_version(zathura_plugin_t* plugin, zathura_plugin_version_t* version);
 
+/**
+ * Returns the flags of the plugin
+ *
+ * @param[in] plugin The plugin
+ * @param[out] flags The flags of the plugin
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_plugin_get_flags(zathura_plugin_t* plugin, zathura_plugin_flag_t* flags);
+
+/**
+ * Returns the features implemented by the plugin. Calls into features the
+ * plugin lacks fail with ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED, so this allows
+ * to choose a code path up front, e.g. to skip text extraction for plugins
+ * that only render images. The capabilities of plugins registered from the
+ * plugin index are known without loading their module.
+ *
+ * @param[in] plugin The plugin
+ * @param[out] capabilities Bitmask of the capabilities of the plugin
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_plugin_get_capabilities(zathura_plugin_t* plugin,
+    zathura_plugin_capability_t* capabilities);
+
 /**
  * Returns the functions of the plugin
  *
@@ -82,6 +166,45 @@ zathura_error_t zathura_plugin_get_functions(zathura_plugin_t* plugin, zathura_p
 zathura_error_t zathura_plugin_open_document(zathura_plugin_t* plugin,
     zathura_document_t** document, const char* path, const char* password);
 
+/**
+ * Opens a document from memory, e.g. a document that has been received over a
+ * socket, without writing it to a file first. The data is not copied and has
+ * to stay valid until the document is freed. The document has no path.
+ *
+ * @param[in] plugin The plugin
+ * @param[out] document The document
+ * @param[in] data The content of the document
+ * @param[in] length The length of the data
+ * @param[in] password (Optional) password of the file
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin cannot open documents
+ *   from memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_plugin_open_document_from_data(zathura_plugin_t* plugin,
+    zathura_document_t** document, const void* data, size_t length, const char*
+    password);
+
+/**
+ * Opens a document from a file descriptor. The descriptor is not closed and
+ * has to stay open until the document is freed. The document has no path.
+ *
+ * @param[in] plugin The plugin
+ * @param[out] document The document
+ * @param[in] fd The file descriptor
+ * @param[in] password (Optional) password of the file
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin cannot open documents
+ *   from file descriptors
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_plugin_open_document_from_fd(zathura_plugin_t* plugin,
+    zathura_document_t** document, int fd, const char* password);
+
 #ifdef __cplusplus
 }
 #endif
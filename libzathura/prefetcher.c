@@ -0,0 +1,285 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <glib.h>
+
+#include "prefetcher.h"
+#include "page.h"
+#include "render-job.h"
+
+struct zathura_prefetcher_s {
+  zathura_document_t* document; /**< The document */
+  GThreadPool* pool; /**< Worker threads */
+
+  GMutex lock; /**< Protects the following members */
+  GCond idle; /**< Signalled once no page is pending */
+  unsigned int generation; /**< Incremented whenever the viewport changes */
+  unsigned int pending; /**< Number of scheduled pages */
+  GList* jobs; /**< Running render jobs */
+
+  unsigned int distance; /**< Number of pages prefetched in each direction */
+  bool has_viewport; /**< A viewport has been reported */
+  unsigned int first_page; /**< First visible page of the last viewport */
+  double scale; /**< Scale level of the last viewport */
+  int rotation; /**< Rotation of the last viewport */
+  int flags; /**< Render flags of the last viewport */
+};
+
+typedef struct prefetcher_task_s {
+  unsigned int page_index; /**< Page to prefetch */
+  unsigned int generation; /**< Generation the page has been scheduled for */
+} prefetcher_task_t;
+
+static void prefetcher_worker(gpointer data, gpointer user_data);
+
+zathura_error_t
+zathura_prefetcher_new(zathura_prefetcher_t** prefetcher, zathura_document_t*
+    document, unsigned int number_of_threads)
+{
+  if (prefetcher == NULL || document == NULL || number_of_threads == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *prefetcher = calloc(1, sizeof(**prefetcher));
+  if (*prefetcher == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*prefetcher)->document = document;
+  (*prefetcher)->distance = ZATHURA_PREFETCHER_DEFAULT_DISTANCE;
+
+  g_mutex_init(&((*prefetcher)->lock));
+  g_cond_init(&((*prefetcher)->idle));
+
+  (*prefetcher)->pool = g_thread_pool_new(prefetcher_worker, *prefetcher,
+      (gint) MIN(number_of_threads, (unsigned int) G_MAXINT), FALSE, NULL);
+  if ((*prefetcher)->pool == NULL) {
+    g_cond_clear(&((*prefetcher)->idle));
+    g_mutex_clear(&((*prefetcher)->lock));
+    free(*prefetcher);
+    *prefetcher = NULL;
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Has to be called with the lock held */
+static void
+prefetcher_drop_scheduled(zathura_prefetcher_t* prefetcher)
+{
+  /* Queued tasks notice the new generation and return immediately */
+  prefetcher->generation++;
+
+  for (GList* link = prefetcher->jobs; link != NULL; link = link->next) {
+    zathura_render_job_cancel(link->data);
+  }
+}
+
+zathura_error_t
+zathura_prefetcher_free(zathura_prefetcher_t* prefetcher)
+{
+  if (prefetcher == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_mutex_lock(&(prefetcher->lock));
+  prefetcher_drop_scheduled(prefetcher);
+  g_mutex_unlock(&(prefetcher->lock));
+
+  /* Let the workers drain the queue so every task is released */
+  g_thread_pool_free(prefetcher->pool, FALSE, TRUE);
+
+  g_cond_clear(&(prefetcher->idle));
+  g_mutex_clear(&(prefetcher->lock));
+  free(prefetcher);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_prefetcher_set_distance(zathura_prefetcher_t* prefetcher, unsigned int
+    distance)
+{
+  if (prefetcher == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_mutex_lock(&(prefetcher->lock));
+  prefetcher->distance = distance;
+  g_mutex_unlock(&(prefetcher->lock));
+
+  return ZATHURA_ERROR_OK;
+}
+
+/* Has to be called with the lock held */
+static zathura_error_t
+prefetcher_schedule(zathura_prefetcher_t* prefetcher, unsigned int page_index)
+{
+  prefetcher_task_t* task = calloc(1, sizeof(*task));
+  if (task == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  task->page_index = page_index;
+  task->generation = prefetcher->generation;
+
+  prefetcher->pending++;
+  g_thread_pool_push(prefetcher->pool, task, NULL);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_prefetcher_set_viewport(zathura_prefetcher_t* prefetcher, unsigned int
+    first_page, unsigned int last_page, double scale, int rotation, int flags)
+{
+  if (prefetcher == NULL || first_page > last_page || scale <= 0.0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  unsigned int number_of_pages = 0;
+  zathura_page_layout_t page_layout = ZATHURA_PAGE_LAYOUT_SINGLE_PAGE;
+  zathura_page_mode_t page_mode = ZATHURA_PAGE_MODE_USE_NONE;
+
+  zathura_document_get_number_of_pages(prefetcher->document, &number_of_pages);
+  zathura_document_get_page_layout(prefetcher->document, &page_layout);
+  zathura_document_get_page_mode(prefetcher->document, &page_mode);
+
+  if (last_page >= number_of_pages) {
+    return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX;
+  }
+
+  /* Two page layouts turn a pair of pages at a time */
+  unsigned int pages_per_step = 1;
+  switch (page_layout) {
+    case ZATHURA_PAGE_LAYOUT_TWO_COLUMN_LEFT:
+    case ZATHURA_PAGE_LAYOUT_TWO_COLUMN_RIGHT:
+    case ZATHURA_PAGE_LAYOUT_TWO_PAGE_LEFT:
+    case ZATHURA_PAGE_LAYOUT_TWO_PAGE_RIGHT:
+      pages_per_step = 2;
+      break;
+    default:
+      break;
+  }
+
+  g_mutex_lock(&(prefetcher->lock));
+
+  prefetcher_drop_scheduled(prefetcher);
+
+  const bool forward = (prefetcher->has_viewport == false ||
+      first_page >= prefetcher->first_page);
+
+  prefetcher->has_viewport = true;
+  prefetcher->first_page   = first_page;
+  prefetcher->scale        = scale;
+  prefetcher->rotation     = rotation;
+  prefetcher->flags        = flags;
+
+  unsigned int ahead  = prefetcher->distance * pages_per_step;
+  unsigned int behind = ahead;
+
+  /* Presentations are paged in one direction, only keep a single step
+   * against it */
+  if (page_mode == ZATHURA_PAGE_MODE_FULL_SCREEN) {
+    behind = MIN(behind, pages_per_step);
+  }
+
+  /* Alternate between both directions, starting with the direction of
+   * movement, so the closest pages are ready first */
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  for (unsigned int i = 1; i <= MAX(ahead, behind) && error == ZATHURA_ERROR_OK; i++) {
+    const bool has_next     = (i <= number_of_pages - 1 - last_page);
+    const bool has_previous = (i <= first_page);
+
+    const bool schedule_next     = has_next && i <= (forward ? ahead : behind);
+    const bool schedule_previous = has_previous && i <= (forward ? behind : ahead);
+
+    if (forward == true) {
+      if (schedule_next == true) {
+        error = prefetcher_schedule(prefetcher, last_page + i);
+      }
+      if (schedule_previous == true && error == ZATHURA_ERROR_OK) {
+        error = prefetcher_schedule(prefetcher, first_page - i);
+      }
+    } else {
+      if (schedule_previous == true) {
+        error = prefetcher_schedule(prefetcher, first_page - i);
+      }
+      if (schedule_next == true && error == ZATHURA_ERROR_OK) {
+        error = prefetcher_schedule(prefetcher, last_page + i);
+      }
+    }
+  }
+
+  g_mutex_unlock(&(prefetcher->lock));
+
+  return error;
+}
+
+zathura_error_t
+zathura_prefetcher_wait(zathura_prefetcher_t* prefetcher)
+{
+  if (prefetcher == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_mutex_lock(&(prefetcher->lock));
+  while (prefetcher->pending > 0) {
+    g_cond_wait(&(prefetcher->idle), &(prefetcher->lock));
+  }
+  g_mutex_unlock(&(prefetcher->lock));
+
+  return ZATHURA_ERROR_OK;
+}
+
+static void
+prefetcher_worker(gpointer data, gpointer user_data)
+{
+  prefetcher_task_t* task = data;
+  zathura_prefetcher_t* prefetcher = user_data;
+  zathura_render_job_t* job = NULL;
+
+  g_mutex_lock(&(prefetcher->lock));
+
+  const double scale = prefetcher->scale;
+  const int rotation = prefetcher->rotation;
+  const int flags    = prefetcher->flags;
+
+  /* Skip pages scheduled for an earlier viewport */
+  if (task->generation == prefetcher->generation &&
+      zathura_render_job_new(&job) == ZATHURA_ERROR_OK) {
+    prefetcher->jobs = g_list_prepend(prefetcher->jobs, job);
+  }
+
+  g_mutex_unlock(&(prefetcher->lock));
+
+  if (job != NULL) {
+    /* Initializes the page if that did not happen yet */
+    zathura_page_t* page = NULL;
+    if (zathura_document_get_page(prefetcher->document, task->page_index,
+          &page) == ZATHURA_ERROR_OK) {
+      zathura_image_buffer_t* buffer = NULL;
+      if (zathura_page_render_with_job(page, &buffer, scale, rotation, flags,
+            job) == ZATHURA_ERROR_OK) {
+        zathura_image_buffer_free(buffer);
+      }
+    }
+  }
+
+  g_mutex_lock(&(prefetcher->lock));
+
+  if (job != NULL) {
+    prefetcher->jobs = g_list_remove(prefetcher->jobs, job);
+    zathura_render_job_free(job);
+  }
+
+  if (--prefetcher->pending == 0) {
+    g_cond_broadcast(&(prefetcher->idle));
+  }
+
+  g_mutex_unlock(&(prefetcher->lock));
+
+  free(task);
+}
@@ -0,0 +1,103 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_PREFETCHER_H
+#define LIBZATHURA_PREFETCHER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "error.h"
+#include "document.h"
+
+/**
+ * Default number of pages prefetched in each direction
+ */
+#define ZATHURA_PREFETCHER_DEFAULT_DISTANCE 2
+
+typedef struct zathura_prefetcher_s zathura_prefetcher_t;
+
+/**
+ * Creates a prefetcher for the document. The prefetcher initializes and
+ * renders the pages around the visible ones in background threads, so that
+ * they are available from the render cache of the document once they become
+ * visible.
+ *
+ * The prefetcher has to be freed before the document.
+ *
+ * @param[out] prefetcher The prefetcher
+ * @param[in] document The document
+ * @param[in] number_of_threads Maximum number of pages prefetched in parallel
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The worker threads could not be created
+ */
+zathura_error_t zathura_prefetcher_new(zathura_prefetcher_t** prefetcher,
+    zathura_document_t* document, unsigned int number_of_threads);
+
+/**
+ * Frees the prefetcher. Pending pages are dropped and running renderings are
+ * cancelled.
+ *
+ * @param[in] prefetcher The prefetcher
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_prefetcher_free(zathura_prefetcher_t* prefetcher);
+
+/**
+ * Sets the number of pages that are prefetched in front of and behind the
+ * visible pages. For two page layouts the distance is counted in pairs of
+ * pages. It is applied with the next call of @ref
+ * zathura_prefetcher_set_viewport.
+ *
+ * @param[in] prefetcher The prefetcher
+ * @param[in] distance Number of pages, 0 disables prefetching
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_prefetcher_set_distance(zathura_prefetcher_t*
+    prefetcher, unsigned int distance);
+
+/**
+ * Reports the currently visible pages. Pages that have been scheduled for an
+ * earlier viewport and are not yet prefetched are dropped, running renderings
+ * are cancelled. The neighbouring pages are then prefetched with the given
+ * rendering parameters, starting with the pages in the direction the viewport
+ * has moved to.
+ *
+ * @param[in] prefetcher The prefetcher
+ * @param[in] first_page Index of the first visible page
+ * @param[in] last_page Index of the last visible page
+ * @param[in] scale Scale level used to render the pages
+ * @param[in] rotation Rotation angle used to render the pages
+ * @param[in] flags Additional flags for rendering
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX Invalid page index
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_prefetcher_set_viewport(zathura_prefetcher_t*
+    prefetcher, unsigned int first_page, unsigned int last_page, double scale,
+    int rotation, int flags);
+
+/**
+ * Blocks until all scheduled pages have been prefetched or dropped.
+ *
+ * @param[in] prefetcher The prefetcher
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_prefetcher_wait(zathura_prefetcher_t* prefetcher);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_PREFETCHER_H */
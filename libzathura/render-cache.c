@@ -0,0 +1,329 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdlib.h>
+#include <glib.h>
+
+#include "render-cache.h"
+#include "internal.h"
+
+typedef struct render_cache_key_s {
+  unsigned int page_index; /**< Index of the page */
+  double scale; /**< Scale level */
+  int rotation; /**< Rotation angle */
+  int flags; /**< Render flags */
+} render_cache_key_t;
+
+typedef struct render_cache_entry_s {
+  render_cache_key_t key; /**< The key of the entry */
+  zathura_image_buffer_t* buffer; /**< The rendered image */
+  size_t size; /**< Size of the image in bytes */
+  GList* link; /**< Position in the LRU queue */
+} render_cache_entry_t;
+
+struct zathura_render_cache_s {
+  GMutex lock; /**< Protects all fields below */
+  GHashTable* entries; /**< Entries indexed by their key */
+  GQueue lru; /**< Entries, most recently used first */
+  size_t size; /**< Accumulated size of all entries */
+  size_t max_size; /**< Memory budget */
+  GHashTable* generations; /**< Invalidation counters of the pages */
+  unsigned int hits; /**< Number of successful lookups */
+  unsigned int misses; /**< Number of failed lookups */
+};
+
+static guint
+render_cache_key_hash(gconstpointer data)
+{
+  const render_cache_key_t* key = data;
+
+  guint hash = key->page_index;
+  hash = hash * 31 + g_double_hash(&key->scale);
+  hash = hash * 31 + (guint) key->rotation;
+  hash = hash * 31 + (guint) key->flags;
+
+  return hash;
+}
+
+static gboolean
+render_cache_key_equal(gconstpointer a, gconstpointer b)
+{
+  const render_cache_key_t* key_a = a;
+  const render_cache_key_t* key_b = b;
+
+  return key_a->page_index == key_b->page_index &&
+    key_a->scale == key_b->scale &&
+    key_a->rotation == key_b->rotation &&
+    key_a->flags == key_b->flags;
+}
+
+static void
+render_cache_entry_free(gpointer data)
+{
+  render_cache_entry_t* entry = data;
+
+  zathura_image_buffer_free(entry->buffer);
+  free(entry);
+}
+
+/* Buffers might have been created with a destroy function supplied by the
+ * user, hence removed entries are freed once the lock has been released */
+static void
+render_cache_entries_free(GList* entries)
+{
+  g_list_free_full(entries, render_cache_entry_free);
+}
+
+static void
+render_cache_key_init(render_cache_key_t* key, unsigned int page_index,
+    double scale, int rotation, int flags)
+{
+  key->page_index = page_index;
+  key->scale      = scale;
+  key->rotation   = ((rotation % 360) + 360) % 360;
+  key->flags      = flags;
+}
+
+/* Has to be called with the lock held, the entry is added to removed */
+static void
+render_cache_remove(zathura_render_cache_t* cache, render_cache_entry_t* entry,
+    GList** removed)
+{
+  cache->size -= entry->size;
+  g_queue_delete_link(&cache->lru, entry->link);
+  g_hash_table_remove(cache->entries, &entry->key);
+
+  *removed = g_list_prepend(*removed, entry);
+}
+
+/* Has to be called with the lock held, evicted entries are added to removed */
+static void
+render_cache_evict(zathura_render_cache_t* cache, GList** removed)
+{
+  while (cache->size > cache->max_size) {
+    render_cache_entry_t* entry = g_queue_peek_tail(&cache->lru);
+    if (entry == NULL) {
+      break;
+    }
+
+    render_cache_remove(cache, entry, removed);
+  }
+}
+
+zathura_error_t
+zathura_render_cache_new(zathura_render_cache_t** cache, size_t max_size)
+{
+  if (cache == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *cache = calloc(1, sizeof(**cache));
+  if (*cache == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*cache)->entries = g_hash_table_new(render_cache_key_hash,
+      render_cache_key_equal);
+  (*cache)->generations = g_hash_table_new(g_direct_hash, g_direct_equal);
+  (*cache)->max_size = max_size;
+
+  g_mutex_init(&((*cache)->lock));
+  g_queue_init(&((*cache)->lru));
+
+  return ZATHURA_ERROR_OK;
+}
+
+void
+zathura_render_cache_free(zathura_render_cache_t* cache)
+{
+  if (cache == NULL) {
+    return;
+  }
+
+  /* The LRU queue owns the entries */
+  g_hash_table_destroy(cache->entries);
+  g_hash_table_destroy(cache->generations);
+  render_cache_entries_free(cache->lru.head);
+  g_mutex_clear(&cache->lock);
+
+  free(cache);
+}
+
+void
+zathura_render_cache_set_max_size(zathura_render_cache_t* cache, size_t
+    max_size)
+{
+  if (cache == NULL) {
+    return;
+  }
+
+  GList* removed = NULL;
+
+  g_mutex_lock(&cache->lock);
+  cache->max_size = max_size;
+  render_cache_evict(cache, &removed);
+  g_mutex_unlock(&cache->lock);
+
+  render_cache_entries_free(removed);
+}
+
+bool
+zathura_render_cache_lookup(zathura_render_cache_t* cache, unsigned int
+    page_index, double scale, int rotation, int flags, zathura_image_buffer_t**
+    buffer)
+{
+  if (cache == NULL || buffer == NULL) {
+    return false;
+  }
+
+  render_cache_key_t key;
+  render_cache_key_init(&key, page_index, scale, rotation, flags);
+
+  g_mutex_lock(&cache->lock);
+
+  render_cache_entry_t* entry = g_hash_table_lookup(cache->entries, &key);
+  if (entry == NULL) {
+    cache->misses++;
+    g_mutex_unlock(&cache->lock);
+    return false;
+  }
+
+  /* Move entry to the front of the LRU queue */
+  g_queue_unlink(&cache->lru, entry->link);
+  g_queue_push_head_link(&cache->lru, entry->link);
+
+  cache->hits++;
+  *buffer = zathura_image_buffer_ref(entry->buffer);
+
+  g_mutex_unlock(&cache->lock);
+
+  return true;
+}
+
+/* Has to be called with the lock held */
+static unsigned int
+render_cache_get_page_generation(zathura_render_cache_t* cache, unsigned int
+    page_index)
+{
+  return GPOINTER_TO_UINT(g_hash_table_lookup(cache->generations,
+        GUINT_TO_POINTER(page_index)));
+}
+
+unsigned int
+zathura_render_cache_get_generation(zathura_render_cache_t* cache, unsigned
+    int page_index)
+{
+  if (cache == NULL) {
+    return 0;
+  }
+
+  g_mutex_lock(&cache->lock);
+  const unsigned int generation = render_cache_get_page_generation(cache, page_index);
+  g_mutex_unlock(&cache->lock);
+
+  return generation;
+}
+
+void
+zathura_render_cache_insert(zathura_render_cache_t* cache, unsigned int
+    page_index, double scale, int rotation, int flags, unsigned int generation,
+    zathura_image_buffer_t* buffer)
+{
+  if (cache == NULL || buffer == NULL) {
+    return;
+  }
+
+  const size_t size = zathura_image_buffer_get_size(buffer);
+
+  g_mutex_lock(&cache->lock);
+
+  /* The page has been invalidated while it was rendered, the buffer is possibly
+   * outdated already. Buffers that exceed the whole budget are not cached at
+   * all. */
+  if (generation != render_cache_get_page_generation(cache, page_index) ||
+      size > cache->max_size) {
+    g_mutex_unlock(&cache->lock);
+    return;
+  }
+
+  render_cache_key_t key;
+  render_cache_key_init(&key, page_index, scale, rotation, flags);
+
+  /* Another thread rendered the same page concurrently */
+  if (g_hash_table_contains(cache->entries, &key) == TRUE) {
+    g_mutex_unlock(&cache->lock);
+    return;
+  }
+
+  render_cache_entry_t* entry = calloc(1, sizeof(*entry));
+  if (entry == NULL) {
+    g_mutex_unlock(&cache->lock);
+    return;
+  }
+
+  entry->key    = key;
+  entry->buffer = zathura_image_buffer_ref(buffer);
+  entry->size   = size;
+
+  g_queue_push_head(&cache->lru, entry);
+  entry->link = g_queue_peek_head_link(&cache->lru);
+  g_hash_table_insert(cache->entries, &entry->key, entry);
+  cache->size += size;
+
+  GList* removed = NULL;
+  render_cache_evict(cache, &removed);
+
+  g_mutex_unlock(&cache->lock);
+
+  render_cache_entries_free(removed);
+}
+
+void
+zathura_render_cache_invalidate_page(zathura_render_cache_t* cache, unsigned
+    int page_index)
+{
+  if (cache == NULL) {
+    return;
+  }
+
+  GList* removed = NULL;
+
+  g_mutex_lock(&cache->lock);
+
+  /* Renderings of other pages that are in progress stay valid */
+  const unsigned int generation = render_cache_get_page_generation(cache, page_index) + 1;
+  g_hash_table_insert(cache->generations, GUINT_TO_POINTER(page_index),
+      GUINT_TO_POINTER(generation));
+
+  GList* link = cache->lru.head;
+  while (link != NULL) {
+    GList* next = link->next;
+    render_cache_entry_t* entry = link->data;
+    if (entry->key.page_index == page_index) {
+      render_cache_remove(cache, entry, &removed);
+    }
+    link = next;
+  }
+
+  g_mutex_unlock(&cache->lock);
+
+  render_cache_entries_free(removed);
+}
+
+void
+zathura_render_cache_get_statistics(zathura_render_cache_t* cache,
+    zathura_render_cache_statistics_t* statistics)
+{
+  if (cache == NULL || statistics == NULL) {
+    return;
+  }
+
+  g_mutex_lock(&cache->lock);
+
+  statistics->hits              = cache->hits;
+  statistics->misses            = cache->misses;
+  statistics->number_of_entries = g_hash_table_size(cache->entries);
+  statistics->size              = cache->size;
+  statistics->max_size          = cache->max_size;
+
+  g_mutex_unlock(&cache->lock);
+}
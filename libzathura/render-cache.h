@@ -0,0 +1,124 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_RENDER_CACHE_H
+#define LIBZATHURA_RENDER_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "document.h"
+#include "image-buffer.h"
+#include "macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default memory budget of the render cache in bytes
+ */
+#define ZATHURA_RENDER_CACHE_DEFAULT_SIZE (64 * 1024 * 1024)
+
+typedef struct zathura_render_cache_s zathura_render_cache_t;
+
+/**
+ * Creates a new render cache. Renderings are kept until their accumulated size
+ * exceeds @a max_size bytes, then the least recently used ones are dropped.
+ *
+ * @param[out] cache The render cache
+ * @param[in] max_size The memory budget in bytes
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_render_cache_new(zathura_render_cache_t** cache,
+    size_t max_size);
+
+/**
+ * Frees the render cache and releases all cached image buffers.
+ *
+ * @param[in] cache The render cache
+ */
+HIDDEN void zathura_render_cache_free(zathura_render_cache_t* cache);
+
+/**
+ * Changes the memory budget of the cache. Entries are evicted immediately if
+ * the cache is larger than the new budget.
+ *
+ * @param[in] cache The render cache
+ * @param[in] max_size The memory budget in bytes
+ */
+HIDDEN void zathura_render_cache_set_max_size(zathura_render_cache_t* cache,
+    size_t max_size);
+
+/**
+ * Looks up a rendering. On success a new reference to the cached buffer is
+ * returned that has to be released with zathura_image_buffer_free.
+ *
+ * @param[in] cache The render cache
+ * @param[in] page_index Index of the rendered page
+ * @param[in] scale Scale level
+ * @param[in] rotation Rotation angle
+ * @param[in] flags Render flags
+ * @param[out] buffer The cached image buffer
+ *
+ * @return true if the rendering has been found, otherwise false
+ */
+HIDDEN bool zathura_render_cache_lookup(zathura_render_cache_t* cache,
+    unsigned int page_index, double scale, int rotation, int flags,
+    zathura_image_buffer_t** buffer);
+
+/**
+ * Returns the current generation of a page in the cache. The generation
+ * changes every time the renderings of the page are invalidated and has to be
+ * passed to zathura_render_cache_insert, so that renderings started before an
+ * invalidation of the page are not cached.
+ *
+ * @param[in] cache The render cache
+ * @param[in] page_index Index of the page
+ *
+ * @return The generation
+ */
+HIDDEN unsigned int zathura_render_cache_get_generation(zathura_render_cache_t*
+    cache, unsigned int page_index);
+
+/**
+ * Adds a rendering to the cache. The cache takes its own reference of
+ * @a buffer.
+ *
+ * @param[in] cache The render cache
+ * @param[in] page_index Index of the rendered page
+ * @param[in] scale Scale level
+ * @param[in] rotation Rotation angle
+ * @param[in] flags Render flags
+ * @param[in] generation Generation of the page when rendering started
+ * @param[in] buffer The rendered image buffer
+ */
+HIDDEN void zathura_render_cache_insert(zathura_render_cache_t* cache,
+    unsigned int page_index, double scale, int rotation, int flags,
+    unsigned int generation, zathura_image_buffer_t* buffer);
+
+/**
+ * Drops all renderings of the given page.
+ *
+ * @param[in] cache The render cache
+ * @param[in] page_index Index of the page
+ */
+HIDDEN void zathura_render_cache_invalidate_page(zathura_render_cache_t* cache,
+    unsigned int page_index);
+
+/**
+ * Retrieves the statistics of the cache.
+ *
+ * @param[in] cache The render cache
+ * @param[out] statistics The statistics
+ */
+HIDDEN void zathura_render_cache_get_statistics(zathura_render_cache_t* cache,
+    zathura_render_cache_statistics_t* statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_RENDER_CACHE_H */
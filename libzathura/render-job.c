@@ -0,0 +1,97 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdlib.h>
+#include <glib.h>
+
+#include "render-job.h"
+#include "plugin-api/render-job.h"
+
+struct zathura_render_job_s {
+  gint cancelled; /**< Set once the job has been cancelled */
+  zathura_render_job_progress_callback_t progress_callback; /**< Progress callback */
+  void* progress_data; /**< Data passed to the progress callback */
+};
+
+zathura_error_t
+zathura_render_job_new(zathura_render_job_t** job)
+{
+  if (job == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *job = calloc(1, sizeof(**job));
+  if (*job == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_render_job_free(zathura_render_job_t* job)
+{
+  if (job == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  free(job);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_render_job_set_progress_callback(zathura_render_job_t* job,
+    zathura_render_job_progress_callback_t callback, void* data)
+{
+  if (job == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  job->progress_callback = callback;
+  job->progress_data     = data;
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_render_job_cancel(zathura_render_job_t* job)
+{
+  if (job == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  g_atomic_int_set(&job->cancelled, 1);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_render_job_is_cancelled(zathura_render_job_t* job, bool* cancelled)
+{
+  if (job == NULL || cancelled == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *cancelled = (g_atomic_int_get(&job->cancelled) != 0);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_render_job_report_progress(zathura_render_job_t* job,
+    zathura_image_buffer_t* buffer, zathura_render_quality_t quality)
+{
+  if (job == NULL || buffer == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (g_atomic_int_get(&job->cancelled) != 0) {
+    return ZATHURA_ERROR_CANCELLED;
+  }
+
+  if (job->progress_callback != NULL) {
+    job->progress_callback(job, buffer, quality, job->progress_data);
+  }
+
+  return ZATHURA_ERROR_OK;
+}
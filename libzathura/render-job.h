@@ -0,0 +1,111 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_RENDER_JOB_H
+#define LIBZATHURA_RENDER_JOB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include "error.h"
+#include "image-buffer.h"
+
+typedef struct zathura_render_job_s zathura_render_job_t;
+
+/**
+ * Quality of an intermediate rendering reported to the progress callback
+ */
+typedef enum zathura_render_quality_e {
+  /**
+   * Coarse preview of the page that is shown until the final rendering is
+   * available
+   */
+  ZATHURA_RENDER_QUALITY_PREVIEW,
+
+  /**
+   * Final rendering of the page
+   */
+  ZATHURA_RENDER_QUALITY_FINAL
+} zathura_render_quality_t;
+
+/**
+ * Callback reporting intermediate results of a render job. The callback is
+ * invoked from the thread that runs the render job. The buffer is only valid
+ * during the call, use @ref zathura_image_buffer_ref to keep it.
+ *
+ * @param[in] job The render job
+ * @param[in] buffer The rendered image
+ * @param[in] quality The quality of the rendering
+ * @param[in] data User supplied data
+ */
+typedef void (*zathura_render_job_progress_callback_t)(zathura_render_job_t*
+    job, zathura_image_buffer_t* buffer, zathura_render_quality_t quality,
+    void* data);
+
+/**
+ * Creates a new render job. A render job is passed to @ref
+ * zathura_page_render_with_job and allows to cancel the rendering from
+ * another thread and to receive intermediate results.
+ *
+ * @param[out] job The render job
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_render_job_new(zathura_render_job_t** job);
+
+/**
+ * Frees the render job
+ *
+ * @param[in] job The render job
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_render_job_free(zathura_render_job_t* job);
+
+/**
+ * Sets the callback that receives intermediate results of the render job
+ *
+ * @param[in] job The render job
+ * @param[in] callback The callback
+ * @param[in] data User supplied data passed to the callback
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_render_job_set_progress_callback(zathura_render_job_t*
+    job, zathura_render_job_progress_callback_t callback, void* data);
+
+/**
+ * Cancels the render job. This function may be called from any thread. The
+ * rendering stops at the next point the plugin checks for cancellation and
+ * @ref zathura_page_render_with_job returns @ref ZATHURA_ERROR_CANCELLED.
+ *
+ * @param[in] job The render job
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_render_job_cancel(zathura_render_job_t* job);
+
+/**
+ * Checks if the render job has been cancelled
+ *
+ * @param[in] job The render job
+ * @param[out] cancelled true if the job has been cancelled, otherwise false
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_render_job_is_cancelled(zathura_render_job_t* job,
+    bool* cancelled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_RENDER_JOB_H */
@@ -0,0 +1,552 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "search-pattern.h"
+
+/* Marks missing nodes of the automaton */
+#define NO_NODE G_MAXUINT
+/* Marks nodes that do not end a term */
+#define NO_TERM SIZE_MAX
+/* Marks the line breaks inserted between the characters of a page */
+#define NO_GLYPH SIZE_MAX
+
+typedef struct pattern_node_s {
+  guint parent; /**< Parent node in the trie */
+  gunichar character; /**< Character on the edge from the parent */
+  guint depth; /**< Number of characters from the root */
+  guint fail; /**< Node of the longest proper suffix that is in the trie */
+  guint output; /**< Next node on the fail chain that ends a term */
+  size_t term; /**< Term ending at this node */
+} pattern_node_t;
+
+struct zathura_search_pattern_s {
+  zathura_search_flag_t flags; /**< Search flags */
+  size_t number_of_terms; /**< Number of terms */
+  GArray* nodes; /**< Nodes of the Aho-Corasick automaton, the root first */
+  GHashTable* edges; /**< Maps node and character to the child node */
+  GRegex** regexes; /**< Compiled terms with ZATHURA_SEARCH_REGEX */
+};
+
+/* Text prepared for matching */
+typedef struct folded_text_s {
+  GArray* characters; /**< Folded characters */
+  GArray* glyphs; /**< Glyph of each folded character, NULL for terms */
+} folded_text_t;
+
+static bool
+pattern_casefolds(zathura_search_flag_t flags)
+{
+  /* Regular expressions are compiled to ignore case instead, since folding
+   * would change their syntax */
+  return (flags & (ZATHURA_SEARCH_CASE_SENSITIVE | ZATHURA_SEARCH_REGEX)) == 0;
+}
+
+static void
+folded_text_append(folded_text_t* text, gunichar character, size_t glyph)
+{
+  g_array_append_val(text->characters, character);
+  if (text->glyphs != NULL) {
+    g_array_append_val(text->glyphs, glyph);
+  }
+}
+
+static void
+fold_character(folded_text_t* text, gunichar character, size_t glyph,
+    zathura_search_flag_t flags)
+{
+  const bool ignore_diacritics = (flags & ZATHURA_SEARCH_IGNORE_DIACRITICS) != 0;
+
+  gunichar decomposition[G_UNICHAR_MAX_DECOMPOSITION_LENGTH] = { character };
+  gsize length = 1;
+  if (ignore_diacritics == true) {
+    length = g_unichar_fully_decompose(character, FALSE, decomposition,
+        G_N_ELEMENTS(decomposition));
+  }
+
+  for (gsize i = 0; i < length; i++) {
+    const gunichar c = decomposition[i];
+    if (ignore_diacritics == true && g_unichar_ismark(c) != FALSE) {
+      continue;
+    }
+
+    if (pattern_casefolds(flags) == false) {
+      folded_text_append(text, c, glyph);
+    } else if (c < 0x80) {
+      folded_text_append(text, (gunichar) g_ascii_tolower((gchar) c), glyph);
+    } else {
+      /* Some characters fold to several, e.g. ß to ss */
+      char utf8[6];
+      char* folded = g_utf8_casefold(utf8, g_unichar_to_utf8(c, utf8));
+      for (const char* p = folded; *p != '\0'; p = g_utf8_next_char(p)) {
+        folded_text_append(text, g_utf8_get_char(p), glyph);
+      }
+      g_free(folded);
+    }
+  }
+}
+
+static void
+fold_term(folded_text_t* text, const char* term, zathura_search_flag_t flags)
+{
+  text->characters = g_array_new(FALSE, FALSE, sizeof(gunichar));
+  text->glyphs     = NULL;
+
+  for (const char* p = term; *p != '\0'; p = g_utf8_next_char(p)) {
+    fold_character(text, g_utf8_get_char(p), NO_GLYPH, flags);
+  }
+}
+
+static void
+fold_glyphs(folded_text_t* text, const zathura_glyph_t* glyphs, size_t
+    number_of_glyphs, zathura_search_flag_t flags)
+{
+  text->characters = g_array_sized_new(FALSE, FALSE, sizeof(gunichar), number_of_glyphs);
+  text->glyphs     = g_array_sized_new(FALSE, FALSE, sizeof(size_t), number_of_glyphs);
+
+  for (size_t i = 0; i < number_of_glyphs; i++) {
+    if (g_unichar_validate(glyphs[i].codepoint) == FALSE) {
+      continue;
+    }
+
+    /* Terms may span lines, which are joined by a space */
+    if (i > 0 && (glyphs[i].line != glyphs[i - 1].line ||
+          glyphs[i].block != glyphs[i - 1].block)) {
+      folded_text_append(text, ' ', NO_GLYPH);
+    }
+
+    fold_character(text, glyphs[i].codepoint, i, flags);
+  }
+}
+
+static void
+folded_text_clear(folded_text_t* text)
+{
+  g_array_free(text->characters, TRUE);
+  if (text->glyphs != NULL) {
+    g_array_free(text->glyphs, TRUE);
+  }
+}
+
+static gpointer
+edge_key_new(guint node, gunichar character)
+{
+  gint64* key = g_new(gint64, 1);
+  *key = ((gint64) node << 32) | character;
+  return key;
+}
+
+static guint
+pattern_get_child(zathura_search_pattern_t* pattern, guint node, gunichar
+    character)
+{
+  const gint64 key = ((gint64) node << 32) | character;
+  gpointer child = g_hash_table_lookup(pattern->edges, &key);
+
+  return (child != NULL) ? GPOINTER_TO_UINT(child) - 1 : NO_NODE;
+}
+
+static void
+pattern_add_term(zathura_search_pattern_t* pattern, const folded_text_t*
+    term, size_t index)
+{
+  guint node = 0;
+
+  for (guint i = 0; i < term->characters->len; i++) {
+    const gunichar character = g_array_index(term->characters, gunichar, i);
+
+    guint child = pattern_get_child(pattern, node, character);
+    if (child == NO_NODE) {
+      pattern_node_t new_node = {
+        .parent    = node,
+        .character = character,
+        .depth     = i + 1,
+        .fail      = 0,
+        .output    = NO_NODE,
+        .term      = NO_TERM
+      };
+
+      child = pattern->nodes->len;
+      g_array_append_val(pattern->nodes, new_node);
+      g_hash_table_insert(pattern->edges, edge_key_new(node, character),
+          GUINT_TO_POINTER(child + 1));
+    }
+
+    node = child;
+  }
+
+  /* Duplicate terms are reported with the index of their first occurrence */
+  pattern_node_t* nodes = (pattern_node_t*) pattern->nodes->data;
+  if (nodes[node].term == NO_TERM) {
+    nodes[node].term = index;
+  }
+}
+
+/* Links every node to its longest proper suffix in the trie, visiting the
+ * nodes by increasing depth so that the suffixes are linked already */
+static void
+pattern_link_nodes(zathura_search_pattern_t* pattern)
+{
+  pattern_node_t* nodes = (pattern_node_t*) pattern->nodes->data;
+  const guint number_of_nodes = pattern->nodes->len;
+
+  guint max_depth = 0;
+  for (guint i = 0; i < number_of_nodes; i++) {
+    max_depth = MAX(max_depth, nodes[i].depth);
+  }
+
+  guint* offsets = g_new0(guint, max_depth + 2);
+  guint* order   = g_new(guint, number_of_nodes);
+
+  for (guint i = 0; i < number_of_nodes; i++) {
+    offsets[nodes[i].depth + 1]++;
+  }
+  for (guint depth = 1; depth <= max_depth + 1; depth++) {
+    offsets[depth] += offsets[depth - 1];
+  }
+  for (guint i = 0; i < number_of_nodes; i++) {
+    order[offsets[nodes[i].depth]++] = i;
+  }
+
+  /* The root comes first and keeps its links */
+  for (guint i = 1; i < number_of_nodes; i++) {
+    pattern_node_t* node = &(nodes[order[i]]);
+
+    if (node->depth > 1) {
+      guint suffix = nodes[node->parent].fail;
+      while (true) {
+        const guint child = pattern_get_child(pattern, suffix, node->character);
+        if (child != NO_NODE) {
+          node->fail = child;
+          break;
+        }
+        if (suffix == 0) {
+          break;
+        }
+        suffix = nodes[suffix].fail;
+      }
+    }
+
+    node->output = (nodes[node->fail].term != NO_TERM) ? node->fail :
+      nodes[node->fail].output;
+  }
+
+  g_free(order);
+  g_free(offsets);
+}
+
+zathura_error_t
+zathura_search_pattern_new(zathura_search_pattern_t** pattern, const char*
+    const* terms, size_t number_of_terms, zathura_search_flag_t flags)
+{
+  if (pattern == NULL || terms == NULL || number_of_terms == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  for (size_t i = 0; i < number_of_terms; i++) {
+    if (terms[i] == NULL || strlen(terms[i]) == 0 ||
+        g_utf8_validate(terms[i], -1, NULL) == FALSE) {
+      return ZATHURA_ERROR_INVALID_ARGUMENTS;
+    }
+  }
+
+  *pattern = calloc(1, sizeof(**pattern));
+  if (*pattern == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*pattern)->flags           = flags;
+  (*pattern)->number_of_terms = number_of_terms;
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  if ((flags & ZATHURA_SEARCH_REGEX) != 0) {
+    (*pattern)->regexes = calloc(number_of_terms, sizeof(GRegex*));
+    if ((*pattern)->regexes == NULL) {
+      error = ZATHURA_ERROR_OUT_OF_MEMORY;
+      goto error_free;
+    }
+
+    const GRegexCompileFlags compile_flags = G_REGEX_OPTIMIZE |
+      (((flags & ZATHURA_SEARCH_CASE_SENSITIVE) == 0) ? G_REGEX_CASELESS : 0);
+
+    for (size_t i = 0; i < number_of_terms; i++) {
+      /* Marks are dropped from the expression just like from the text */
+      folded_text_t term;
+      fold_term(&term, terms[i], flags);
+      char* expression = g_ucs4_to_utf8((gunichar*) (void*) term.characters->data,
+          term.characters->len, NULL, NULL, NULL);
+      folded_text_clear(&term);
+
+      if (expression != NULL && strlen(expression) > 0) {
+        (*pattern)->regexes[i] = g_regex_new(expression, compile_flags, 0, NULL);
+      }
+      g_free(expression);
+
+      if ((*pattern)->regexes[i] == NULL) {
+        error = ZATHURA_ERROR_INVALID_ARGUMENTS;
+        goto error_free;
+      }
+    }
+  } else {
+    (*pattern)->nodes = g_array_new(FALSE, FALSE, sizeof(pattern_node_t));
+    (*pattern)->edges = g_hash_table_new_full(g_int64_hash, g_int64_equal, g_free, NULL);
+
+    pattern_node_t root = {
+      .parent = 0,
+      .depth  = 0,
+      .fail   = 0,
+      .output = NO_NODE,
+      .term   = NO_TERM
+    };
+    g_array_append_val((*pattern)->nodes, root);
+
+    for (size_t i = 0; i < number_of_terms; i++) {
+      folded_text_t term;
+      fold_term(&term, terms[i], flags);
+      const bool empty = (term.characters->len == 0);
+      if (empty == false) {
+        pattern_add_term(*pattern, &term, i);
+      }
+      folded_text_clear(&term);
+
+      if (empty == true) {
+        error = ZATHURA_ERROR_INVALID_ARGUMENTS;
+        goto error_free;
+      }
+    }
+
+    pattern_link_nodes(*pattern);
+  }
+
+  return ZATHURA_ERROR_OK;
+
+error_free:
+
+  zathura_search_pattern_free(*pattern);
+  *pattern = NULL;
+
+  return error;
+}
+
+zathura_error_t
+zathura_search_pattern_free(zathura_search_pattern_t* pattern)
+{
+  if (pattern == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (pattern->regexes != NULL) {
+    for (size_t i = 0; i < pattern->number_of_terms; i++) {
+      if (pattern->regexes[i] != NULL) {
+        g_regex_unref(pattern->regexes[i]);
+      }
+    }
+    free(pattern->regexes);
+  }
+
+  if (pattern->nodes != NULL) {
+    g_array_free(pattern->nodes, TRUE);
+  }
+
+  if (pattern->edges != NULL) {
+    g_hash_table_destroy(pattern->edges);
+  }
+
+  free(pattern);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static bool
+is_word_character(const folded_text_t* text, size_t position)
+{
+  return g_unichar_isalnum(g_array_index(text->characters, gunichar, position)) != FALSE;
+}
+
+/* Adds a match between the folded characters first and last */
+static zathura_error_t
+pattern_report(zathura_search_pattern_t* pattern, const folded_text_t* text,
+    size_t term, size_t first, size_t last, zathura_list_t** matches)
+{
+  if ((pattern->flags & ZATHURA_SEARCH_WHOLE_WORDS_ONLY) != 0 &&
+      ((first > 0 && is_word_character(text, first - 1) == true) ||
+       (last + 1 < text->characters->len && is_word_character(text, last + 1) == true))) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  /* Line breaks at the ends of the match do not belong to any glyph */
+  while (first <= last && g_array_index(text->glyphs, size_t, first) == NO_GLYPH) {
+    first++;
+  }
+  while (last > first && g_array_index(text->glyphs, size_t, last) == NO_GLYPH) {
+    last--;
+  }
+  if (first > last || g_array_index(text->glyphs, size_t, first) == NO_GLYPH) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  zathura_search_match_t* match = calloc(1, sizeof(*match));
+  if (match == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  match->term        = term;
+  match->first_glyph = g_array_index(text->glyphs, size_t, first);
+  match->last_glyph  = g_array_index(text->glyphs, size_t, last);
+
+  *matches = zathura_list_prepend(*matches, match);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_error_t
+pattern_match_terms(zathura_search_pattern_t* pattern, const folded_text_t*
+    text, zathura_list_t** matches)
+{
+  const pattern_node_t* nodes = (const pattern_node_t*) pattern->nodes->data;
+
+  /* Occurrences of a term must not start before this position */
+  size_t* next_start = calloc(pattern->number_of_terms, sizeof(size_t));
+  if (next_start == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  guint node = 0;
+
+  for (size_t position = 0; position < text->characters->len && error ==
+      ZATHURA_ERROR_OK; position++) {
+    const gunichar character = g_array_index(text->characters, gunichar, position);
+
+    while (true) {
+      const guint child = pattern_get_child(pattern, node, character);
+      if (child != NO_NODE) {
+        node = child;
+        break;
+      }
+      if (node == 0) {
+        break;
+      }
+      node = nodes[node].fail;
+    }
+
+    guint output = (nodes[node].term != NO_TERM) ? node : nodes[node].output;
+    for (; output != NO_NODE && error == ZATHURA_ERROR_OK; output = nodes[output].output) {
+      const size_t term  = nodes[output].term;
+      const size_t first = position + 1 - nodes[output].depth;
+      if (first < next_start[term]) {
+        continue;
+      }
+
+      error = pattern_report(pattern, text, term, first, position, matches);
+      next_start[term] = position + 1;
+    }
+  }
+
+  free(next_start);
+
+  return error;
+}
+
+static zathura_error_t
+pattern_match_regexes(zathura_search_pattern_t* pattern, const folded_text_t*
+    text, zathura_list_t** matches)
+{
+  /* Maps every byte of the subject to its folded character */
+  GString* subject = g_string_sized_new(text->characters->len);
+  GArray* positions = g_array_sized_new(FALSE, FALSE, sizeof(size_t), text->characters->len);
+
+  for (size_t position = 0; position < text->characters->len; position++) {
+    char utf8[6];
+    const gint length = g_unichar_to_utf8(g_array_index(text->characters,
+          gunichar, position), utf8);
+    g_string_append_len(subject, utf8, length);
+    for (gint i = 0; i < length; i++) {
+      g_array_append_val(positions, position);
+    }
+  }
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+
+  for (size_t term = 0; term < pattern->number_of_terms && error == ZATHURA_ERROR_OK; term++) {
+    GMatchInfo* match_info = NULL;
+    g_regex_match(pattern->regexes[term], subject->str, 0, &match_info);
+
+    while (g_match_info_matches(match_info) == TRUE && error == ZATHURA_ERROR_OK) {
+      gint start = 0;
+      gint end   = 0;
+      if (g_match_info_fetch_pos(match_info, 0, &start, &end) == TRUE && end > start) {
+        error = pattern_report(pattern, text, term,
+            g_array_index(positions, size_t, start),
+            g_array_index(positions, size_t, end - 1), matches);
+      }
+      g_match_info_next(match_info, NULL);
+    }
+
+    g_match_info_free(match_info);
+  }
+
+  g_array_free(positions, TRUE);
+  g_string_free(subject, TRUE);
+
+  return error;
+}
+
+static gint
+compare_matches(gconstpointer a, gconstpointer b)
+{
+  const zathura_search_match_t* match_a = a;
+  const zathura_search_match_t* match_b = b;
+
+  if (match_a->last_glyph != match_b->last_glyph) {
+    return (match_a->last_glyph < match_b->last_glyph) ? -1 : 1;
+  }
+  if (match_a->term != match_b->term) {
+    return (match_a->term < match_b->term) ? -1 : 1;
+  }
+
+  return 0;
+}
+
+zathura_error_t
+zathura_page_search_pattern(zathura_page_t* page, zathura_search_pattern_t*
+    pattern, zathura_list_t** matches)
+{
+  if (page == NULL || pattern == NULL || matches == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  const zathura_glyph_t* glyphs = NULL;
+  size_t number_of_glyphs = 0;
+
+  zathura_error_t error = zathura_page_get_glyphs(page, &glyphs, &number_of_glyphs);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  folded_text_t text;
+  fold_glyphs(&text, glyphs, number_of_glyphs, pattern->flags);
+
+  zathura_list_t* list = NULL;
+  if (pattern->regexes != NULL) {
+    error = pattern_match_regexes(pattern, &text, &list);
+  } else {
+    error = pattern_match_terms(pattern, &text, &list);
+  }
+
+  folded_text_clear(&text);
+
+  if (error != ZATHURA_ERROR_OK) {
+    zathura_list_free_full(list, free);
+    return error;
+  }
+
+  *matches = g_list_sort(list, compare_matches);
+
+  return ZATHURA_ERROR_OK;
+}
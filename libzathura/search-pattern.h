@@ -0,0 +1,84 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_SEARCH_PATTERN_H
+#define LIBZATHURA_SEARCH_PATTERN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include "error.h"
+#include "list.h"
+#include "page.h"
+#include "types.h"
+
+typedef struct zathura_search_pattern_s zathura_search_pattern_t;
+
+typedef struct zathura_search_match_s {
+  size_t term; /**< Index of the matching term */
+  size_t first_glyph; /**< Index of the first matching character */
+  size_t last_glyph; /**< Index of the last matching character */
+} zathura_search_match_t;
+
+/**
+ * Compiles a set of search terms that are matched against the characters of
+ * pages by the library instead of the plugin. Plain terms are combined into a
+ * single automaton, so all of them are found in one pass over a page. With
+ * ZATHURA_SEARCH_REGEX the terms are regular expressions instead, which are
+ * matched one after another.
+ *
+ * Unless ZATHURA_SEARCH_CASE_SENSITIVE is given, terms and text are compared
+ * after Unicode case folding. ZATHURA_SEARCH_IGNORE_DIACRITICS additionally
+ * ignores combining marks, so that "cafe" matches "café".
+ *
+ * @param[out] pattern The compiled pattern
+ * @param[in] terms The search terms
+ * @param[in] number_of_terms The number of search terms
+ * @param[in] flags The search flags
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed,
+ *   e.g. an empty term or an invalid regular expression
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+zathura_error_t zathura_search_pattern_new(zathura_search_pattern_t** pattern,
+    const char* const* terms, size_t number_of_terms, zathura_search_flag_t
+    flags);
+
+/**
+ * Frees the pattern.
+ *
+ * @param[in] pattern The pattern
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+zathura_error_t zathura_search_pattern_free(zathura_search_pattern_t* pattern);
+
+/**
+ * Finds all occurrences of the terms of the pattern on the page. Occurrences
+ * of the same term do not overlap, occurrences of different terms may. The
+ * pattern can be used by several threads at the same time.
+ *
+ * @param[in] page The page
+ * @param[in] pattern The pattern
+ * @param[out] matches List of zathura_search_match_t ordered by their last
+ *   character, has to be freed with zathura_list_free_full(matches, free)
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin does not provide
+ *   the characters of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_page_search_pattern(zathura_page_t* page,
+    zathura_search_pattern_t* pattern, zathura_list_t** matches);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_SEARCH_PATTERN_H */
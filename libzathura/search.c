@@ -0,0 +1,283 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "search.h"
+#include "page.h"
+#include "plugin.h"
+#include "internal.h"
+#include "text-index.h"
+
+typedef struct search_s {
+  zathura_document_t* document; /**< The searched document */
+  const char* text; /**< The search item */
+  zathura_search_flag_t flags; /**< The search flags */
+  unsigned int number_of_pages; /**< Number of pages of the document */
+  unsigned int first_page; /**< Page at the first position */
+  bool* candidates; /**< Pages that may contain the search item, NULL if all may */
+
+  GMutex lock; /**< Protects the following members */
+  GCond page_done; /**< Signalled whenever a page has been searched */
+  bool stopped; /**< Pages that did not start yet are skipped */
+  bool* done; /**< Searched pages, indexed by position */
+  zathura_list_t** results; /**< Results of the pages, indexed by position */
+  zathura_error_t* errors; /**< Errors of the pages, indexed by position */
+} search_t;
+
+static void
+search_worker(gpointer data, gpointer user_data)
+{
+  search_t* search = user_data;
+  const unsigned int position = GPOINTER_TO_UINT(data) - 1;
+  const unsigned int index = (search->first_page + position) % search->number_of_pages;
+
+  g_mutex_lock(&(search->lock));
+  const bool stopped = search->stopped;
+  g_mutex_unlock(&(search->lock));
+
+  zathura_list_t* results = NULL;
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  if (stopped == false && (search->candidates == NULL || search->candidates[index] == true)) {
+    zathura_page_t* page = NULL;
+    if ((error = zathura_document_get_page(search->document, index, &page)) == ZATHURA_ERROR_OK) {
+      error = zathura_page_search_text(page, search->text, search->flags, &results);
+    }
+  }
+
+  g_mutex_lock(&(search->lock));
+  search->results[position] = results;
+  search->errors[position]  = error;
+  search->done[position]    = true;
+  g_cond_broadcast(&(search->page_done));
+  g_mutex_unlock(&(search->lock));
+}
+
+/* Drops the results after the first count ones */
+static zathura_list_t*
+search_truncate_results(zathura_list_t* results, unsigned int count)
+{
+  zathura_list_t* tail = zathura_list_nth(results, count);
+  if (tail == NULL) {
+    return results;
+  }
+
+  if (tail->prev != NULL) {
+    tail->prev->next = NULL;
+    tail->prev = NULL;
+  } else {
+    results = NULL;
+  }
+
+  zathura_list_free_full(tail, free);
+
+  return results;
+}
+
+zathura_error_t
+zathura_document_search_text(zathura_document_t* document, const char* text,
+    zathura_search_flag_t flags, unsigned int first_page, unsigned int
+    max_results, zathura_search_callback_t callback, void* data)
+{
+  if (document == NULL || text == NULL || strlen(text) == 0 || callback == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* zathura_page_search_text serves plugins without a search function from
+   * the characters of the pages */
+  if (document->plugin == NULL ||
+      (document->plugin->functions.page_search_text == NULL &&
+       document->plugin->functions.page_get_glyphs == NULL)) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  if (first_page >= document->number_of_pages) {
+    return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX;
+  }
+
+  search_t search = {
+    .document        = document,
+    .text            = text,
+    .flags           = flags,
+    .number_of_pages = document->number_of_pages,
+    .first_page      = first_page,
+    .done            = calloc(document->number_of_pages, sizeof(bool)),
+    .results         = calloc(document->number_of_pages, sizeof(zathura_list_t*)),
+    .errors          = calloc(document->number_of_pages, sizeof(zathura_error_t))
+  };
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  GThreadPool* pool = NULL;
+
+  if (search.done == NULL || search.results == NULL || search.errors == NULL) {
+    error = ZATHURA_ERROR_OUT_OF_MEMORY;
+    goto error_free;
+  }
+
+  /* Only pages containing the search item have to be searched. Regular
+   * expressions and items with diacritics ignored are no literal text the
+   * index could look up. */
+  zathura_text_index_t* index = g_atomic_pointer_get(&(document->text_index));
+  if (index != NULL && (flags & (ZATHURA_SEARCH_REGEX | ZATHURA_SEARCH_IGNORE_DIACRITICS)) == 0) {
+    search.candidates = calloc(search.number_of_pages, sizeof(bool));
+    if (search.candidates == NULL) {
+      error = ZATHURA_ERROR_OUT_OF_MEMORY;
+      goto error_free;
+    }
+
+    if (zathura_text_index_find(index, text, search.candidates) != ZATHURA_ERROR_OK) {
+      free(search.candidates);
+      search.candidates = NULL;
+    }
+  }
+
+  g_mutex_init(&(search.lock));
+  g_cond_init(&(search.page_done));
+
+  /* Searches of plugins that are not reentrant are serialized anyway */
+  unsigned int number_of_threads = 1;
+  if ((document->plugin->flags & ZATHURA_PLUGIN_FLAG_REENTRANT_SEARCH) != 0) {
+    number_of_threads = MIN(MIN(g_get_num_processors(), search.number_of_pages),
+        (unsigned int) G_MAXINT);
+  }
+
+  pool = g_thread_pool_new(search_worker, &search, (gint) number_of_threads, FALSE, NULL);
+  if (pool == NULL) {
+    error = ZATHURA_ERROR_UNKNOWN;
+    goto error_clear;
+  }
+
+  /* Pages are queued in search order, so the next reported page is searched
+   * first */
+  for (unsigned int position = 0; position < search.number_of_pages; position++) {
+    g_thread_pool_push(pool, GUINT_TO_POINTER(position + 1), NULL);
+  }
+
+  unsigned int number_of_results = 0;
+  for (unsigned int position = 0; position < search.number_of_pages; position++) {
+    g_mutex_lock(&(search.lock));
+    while (search.done[position] == false) {
+      g_cond_wait(&(search.page_done), &(search.lock));
+    }
+    zathura_list_t* results = search.results[position];
+    search.results[position] = NULL;
+    g_mutex_unlock(&(search.lock));
+
+    if ((error = search.errors[position]) != ZATHURA_ERROR_OK) {
+      zathura_list_free_full(results, free);
+      break;
+    }
+
+    if (results == NULL) {
+      continue;
+    }
+
+    if (max_results != 0) {
+      results = search_truncate_results(results, max_results - number_of_results);
+    }
+    number_of_results += zathura_list_length(results);
+
+    const unsigned int index = (first_page + position) % search.number_of_pages;
+    if (callback(document, index, results, data) == false ||
+        (max_results != 0 && number_of_results >= max_results)) {
+      break;
+    }
+  }
+
+  /* Let the queued pages finish without searching them */
+  g_mutex_lock(&(search.lock));
+  search.stopped = true;
+  g_mutex_unlock(&(search.lock));
+
+  g_thread_pool_free(pool, FALSE, TRUE);
+
+  for (unsigned int position = 0; position < search.number_of_pages; position++) {
+    zathura_list_free_full(search.results[position], free);
+  }
+
+error_clear:
+
+  g_cond_clear(&(search.page_done));
+  g_mutex_clear(&(search.lock));
+
+error_free:
+
+  free(search.candidates);
+  free(search.errors);
+  free(search.results);
+  free(search.done);
+
+  return error;
+}
+
+zathura_error_t
+zathura_document_build_text_index(zathura_document_t* document, const char*
+    cache_directory)
+{
+  if (document == NULL || (cache_directory != NULL && strlen(cache_directory) == 0)) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (document->plugin == NULL || document->plugin->functions.page_get_text == NULL) {
+    return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED;
+  }
+
+  if (g_atomic_pointer_get(&(document->text_index)) != NULL) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  char* cache_path = NULL;
+  char* key = NULL;
+  if (cache_directory != NULL && document->path != NULL &&
+      zathura_text_index_get_document_key(document->path, &key) == ZATHURA_ERROR_OK) {
+    char* name = g_strconcat(key, ".textindex", NULL);
+    cache_path = g_build_filename(cache_directory, name, NULL);
+    g_free(name);
+    g_free(key);
+  }
+
+  zathura_text_index_t* index = NULL;
+  if (cache_path != NULL) {
+    zathura_text_index_load(&index, cache_path, document->number_of_pages);
+  }
+
+  zathura_error_t error = ZATHURA_ERROR_OK;
+  if (index == NULL) {
+    if ((error = zathura_text_index_new(&index, document->number_of_pages)) != ZATHURA_ERROR_OK) {
+      g_free(cache_path);
+      return error;
+    }
+
+    for (unsigned int i = 0; i < document->number_of_pages && error == ZATHURA_ERROR_OK; i++) {
+      zathura_page_t* page = NULL;
+      char* page_text = NULL;
+      if ((error = zathura_document_get_page(document, i, &page)) == ZATHURA_ERROR_OK &&
+          (error = zathura_page_get_text(page, &page_text)) == ZATHURA_ERROR_OK) {
+        error = zathura_text_index_add_page(index, i, (page_text != NULL) ? page_text : "");
+      }
+      free(page_text);
+    }
+
+    if (error != ZATHURA_ERROR_OK) {
+      zathura_text_index_free(index);
+      g_free(cache_path);
+      return error;
+    }
+
+    /* a missing cache file only costs the next instance a rebuild */
+    if (cache_path != NULL && g_mkdir_with_parents(cache_directory, 0700) == 0) {
+      zathura_text_index_save(index, cache_path);
+    }
+  }
+
+  g_free(cache_path);
+
+  if (g_atomic_pointer_compare_and_exchange(&(document->text_index), NULL, index) == FALSE) {
+    /* built concurrently by another thread */
+    zathura_text_index_free(index);
+  }
+
+  return ZATHURA_ERROR_OK;
+}
@@ -0,0 +1,95 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_SEARCH_H
+#define LIBZATHURA_SEARCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include "error.h"
+#include "document.h"
+#include "list.h"
+#include "types.h"
+
+/**
+ * Receives the search results of a page.
+ *
+ * @param[in] document The searched document
+ * @param[in] page_index The index of the page
+ * @param[in] results The results of the page, owned by the callback and to be
+ *   freed with zathura_list_free_full(results, free)
+ * @param[in] data Custom data passed to zathura_document_search_text
+ *
+ * @return true to continue the search, false to stop it
+ */
+typedef bool (*zathura_search_callback_t)(zathura_document_t* document,
+    unsigned int page_index, zathura_list_t* results, void* data);
+
+/**
+ * Searches all pages of the document. The pages are searched in parallel by a
+ * pool of threads; if the plugin does not set
+ * ZATHURA_PLUGIN_FLAG_REENTRANT_SEARCH, a single thread is used and the pages
+ * are searched one after another in the background.
+ *
+ * The results are passed to @a callback from the calling thread in page order,
+ * starting at @a first_page and wrapping around at the end of the document,
+ * as soon as the pages up to the respective page have been searched. Pages
+ * without results are skipped. The function returns once the whole document
+ * has been searched, @a max_results results have been reported or the
+ * callback stopped the search. If a text index has been built with
+ * zathura_document_build_text_index, pages that do not contain the search
+ * item are not searched.
+ *
+ * @param[in] document The document
+ * @param[in] text The search item
+ * @param[in] flags The search flags
+ * @param[in] first_page The page the search starts at
+ * @param[in] max_results Maximum number of reported results, 0 for all
+ * @param[in] callback Receives the results of each page
+ * @param[in] data Custom data passed to @a callback
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_DOCUMENT_INVALID_INDEX @a first_page does not exist
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin can neither search
+ *   pages nor provide their characters
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_document_search_text(zathura_document_t* document,
+    const char* text, zathura_search_flag_t flags, unsigned int first_page,
+    unsigned int max_results, zathura_search_callback_t callback, void* data);
+
+/**
+ * Builds an index of the text of all pages of the document. Once the index
+ * exists, zathura_document_search_text only asks the plugin to search pages
+ * whose text contains the search item, compared case-insensitively and with
+ * white space collapsed, instead of searching every page.
+ *
+ * Building the index extracts the text of every page. If @a cache_directory
+ * is given, the index is saved to a file in this directory named after the
+ * SHA-256 checksum of the document file and loaded from there for later
+ * instances of the same document. Documents opened without a path do not use
+ * cache files.
+ *
+ * @param[in] document The document
+ * @param[in] cache_directory (Optional) directory of the cache files
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED The plugin cannot extract the
+ *   text of pages
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN An unspecified error occurred
+ */
+zathura_error_t zathura_document_build_text_index(zathura_document_t* document,
+    const char* cache_directory);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_SEARCH_H */
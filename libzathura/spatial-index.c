@@ -0,0 +1,351 @@
+/* See LICENSE file for license and copyright information */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <glib.h>
+
+#include "spatial-index.h"
+
+/* Upper bound for the number of columns and rows of the grid */
+#define SPATIAL_INDEX_MAX_CELLS 256
+
+/* Items covering more cells are not stored in the grid */
+#define SPATIAL_INDEX_MAX_CELLS_PER_ITEM 64
+
+struct zathura_spatial_index_s {
+  size_t number_of_items; /**< Number of indexed items */
+  void** items; /**< The indexed items */
+  zathura_rectangle_t* boxes; /**< Normalized positions of the items */
+  zathura_rectangle_t bounds; /**< Bounding box of all items */
+  unsigned int columns; /**< Number of columns of the grid */
+  unsigned int rows; /**< Number of rows of the grid */
+  float cell_width; /**< Width of a cell */
+  float cell_height; /**< Height of a cell */
+  size_t* cell_offsets; /**< Start of the items of each cell in cell_items */
+  size_t* cell_items; /**< Ascending item indices of all cells */
+  size_t* large_items; /**< Ascending indices of the items not in the grid */
+  size_t number_of_large_items; /**< Number of items not in the grid */
+};
+
+typedef struct cell_range_s {
+  unsigned int first_column;
+  unsigned int last_column;
+  unsigned int first_row;
+  unsigned int last_row;
+} cell_range_t;
+
+static zathura_rectangle_t
+rectangle_normalize(zathura_rectangle_t rectangle)
+{
+  return (zathura_rectangle_t) {
+    { MIN(rectangle.p1.x, rectangle.p2.x), MIN(rectangle.p1.y, rectangle.p2.y) },
+    { MAX(rectangle.p1.x, rectangle.p2.x), MAX(rectangle.p1.y, rectangle.p2.y) }
+  };
+}
+
+static bool
+box_contains_point(const zathura_rectangle_t* box, zathura_point_t point)
+{
+  return point.x >= box->p1.x && point.x <= box->p2.x &&
+         point.y >= box->p1.y && point.y <= box->p2.y;
+}
+
+static bool
+boxes_intersect(const zathura_rectangle_t* a, const zathura_rectangle_t* b)
+{
+  return a->p1.x <= b->p2.x && b->p1.x <= a->p2.x &&
+         a->p1.y <= b->p2.y && b->p1.y <= a->p2.y;
+}
+
+static unsigned int
+cell_coordinate(float value, float origin, float cell_size, unsigned int cells)
+{
+  const float position = (value - origin) / cell_size;
+  if (!(position > 0)) {
+    return 0;
+  } else if (position >= cells) {
+    return cells - 1;
+  }
+
+  return (unsigned int) position;
+}
+
+static cell_range_t
+index_get_cell_range(const zathura_spatial_index_t* index, const
+    zathura_rectangle_t* box)
+{
+  return (cell_range_t) {
+    cell_coordinate(box->p1.x, index->bounds.p1.x, index->cell_width, index->columns),
+    cell_coordinate(box->p2.x, index->bounds.p1.x, index->cell_width, index->columns),
+    cell_coordinate(box->p1.y, index->bounds.p1.y, index->cell_height, index->rows),
+    cell_coordinate(box->p2.y, index->bounds.p1.y, index->cell_height, index->rows)
+  };
+}
+
+static size_t
+cell_range_get_size(cell_range_t range)
+{
+  return (size_t) (range.last_column - range.first_column + 1) *
+    (range.last_row - range.first_row + 1);
+}
+
+/* Chooses about one square-ish cell per item */
+static void
+index_set_grid_size(zathura_spatial_index_t* index)
+{
+  float width  = index->bounds.p2.x - index->bounds.p1.x;
+  float height = index->bounds.p2.y - index->bounds.p1.y;
+  if (!(width > 0)) {
+    width = 1;
+  }
+  if (!(height > 0)) {
+    height = 1;
+  }
+
+  const double columns = ceil(sqrt(index->number_of_items * (double) width / height));
+  index->columns = (unsigned int) CLAMP(columns, 1, SPATIAL_INDEX_MAX_CELLS);
+
+  const double rows = ceil((double) index->number_of_items / index->columns);
+  index->rows = (unsigned int) CLAMP(rows, 1, SPATIAL_INDEX_MAX_CELLS);
+
+  index->cell_width  = width / index->columns;
+  index->cell_height = height / index->rows;
+}
+
+/* Distributes the items over the cells they cover */
+static zathura_error_t
+index_fill_grid(zathura_spatial_index_t* index)
+{
+  const size_t number_of_cells = (size_t) index->columns * index->rows;
+
+  index->cell_offsets = calloc(number_of_cells + 1, sizeof(size_t));
+  index->large_items  = calloc(index->number_of_items, sizeof(size_t));
+  if (index->cell_offsets == NULL || index->large_items == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  /* Count the items of each cell, shifted by one for the prefix sum */
+  size_t number_of_entries = 0;
+  for (size_t i = 0; i < index->number_of_items; i++) {
+    const cell_range_t range = index_get_cell_range(index, &(index->boxes[i]));
+    if (cell_range_get_size(range) > SPATIAL_INDEX_MAX_CELLS_PER_ITEM) {
+      index->large_items[index->number_of_large_items++] = i;
+      continue;
+    }
+
+    for (unsigned int row = range.first_row; row <= range.last_row; row++) {
+      for (unsigned int column = range.first_column; column <= range.last_column; column++) {
+        index->cell_offsets[row * index->columns + column + 1]++;
+      }
+    }
+    number_of_entries += cell_range_get_size(range);
+  }
+
+  for (size_t cell = 0; cell < number_of_cells; cell++) {
+    index->cell_offsets[cell + 1] += index->cell_offsets[cell];
+  }
+
+  index->cell_items = calloc(MAX(number_of_entries, 1), sizeof(size_t));
+  size_t* cursors   = calloc(number_of_cells, sizeof(size_t));
+  if (index->cell_items == NULL || cursors == NULL) {
+    free(cursors);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  /* Items are visited in order, so the items of each cell stay sorted */
+  for (size_t i = 0, large = 0; i < index->number_of_items; i++) {
+    if (large < index->number_of_large_items && index->large_items[large] == i) {
+      large++;
+      continue;
+    }
+
+    const cell_range_t range = index_get_cell_range(index, &(index->boxes[i]));
+    for (unsigned int row = range.first_row; row <= range.last_row; row++) {
+      for (unsigned int column = range.first_column; column <= range.last_column; column++) {
+        const size_t cell = row * index->columns + column;
+        index->cell_items[index->cell_offsets[cell] + cursors[cell]++] = i;
+      }
+    }
+  }
+
+  free(cursors);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_spatial_index_new(zathura_spatial_index_t** index, zathura_list_t*
+    items)
+{
+  if (index == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  zathura_spatial_index_t* spatial_index = calloc(1, sizeof(*spatial_index));
+  if (spatial_index == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  spatial_index->number_of_items = zathura_list_length(items);
+  if (spatial_index->number_of_items == 0) {
+    *index = spatial_index;
+    return ZATHURA_ERROR_OK;
+  }
+
+  spatial_index->items = calloc(spatial_index->number_of_items, sizeof(void*));
+  spatial_index->boxes = calloc(spatial_index->number_of_items, sizeof(zathura_rectangle_t));
+  if (spatial_index->items == NULL || spatial_index->boxes == NULL) {
+    zathura_spatial_index_free(spatial_index);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  size_t i = 0;
+  void* item;
+  ZATHURA_LIST_FOREACH(item, items) {
+    const zathura_rectangle_t box = rectangle_normalize(*((const zathura_rectangle_t*) item));
+
+    if (i == 0) {
+      spatial_index->bounds = box;
+    } else {
+      spatial_index->bounds.p1.x = MIN(spatial_index->bounds.p1.x, box.p1.x);
+      spatial_index->bounds.p1.y = MIN(spatial_index->bounds.p1.y, box.p1.y);
+      spatial_index->bounds.p2.x = MAX(spatial_index->bounds.p2.x, box.p2.x);
+      spatial_index->bounds.p2.y = MAX(spatial_index->bounds.p2.y, box.p2.y);
+    }
+
+    spatial_index->items[i] = item;
+    spatial_index->boxes[i] = box;
+    i++;
+  }
+
+  index_set_grid_size(spatial_index);
+
+  if (index_fill_grid(spatial_index) != ZATHURA_ERROR_OK) {
+    zathura_spatial_index_free(spatial_index);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  *index = spatial_index;
+
+  return ZATHURA_ERROR_OK;
+}
+
+void
+zathura_spatial_index_free(zathura_spatial_index_t* index)
+{
+  if (index == NULL) {
+    return;
+  }
+
+  free(index->items);
+  free(index->boxes);
+  free(index->cell_offsets);
+  free(index->cell_items);
+  free(index->large_items);
+  free(index);
+}
+
+zathura_error_t
+zathura_spatial_index_query_point(zathura_spatial_index_t* index,
+    zathura_point_t point, zathura_list_t** items)
+{
+  if (index == NULL || items == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *items = NULL;
+
+  if (index->number_of_items == 0 ||
+      box_contains_point(&(index->bounds), point) == false) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  const zathura_rectangle_t box = { point, point };
+  const cell_range_t range = index_get_cell_range(index, &box);
+  const size_t cell = range.first_row * index->columns + range.first_column;
+
+  const size_t* cell_items = index->cell_items + index->cell_offsets[cell];
+  const size_t number_of_cell_items = index->cell_offsets[cell + 1] - index->cell_offsets[cell];
+
+  /* Merges the items of the cell with the large items to keep their order */
+  zathura_list_t* list = NULL;
+  size_t c = 0;
+  size_t l = 0;
+  while (c < number_of_cell_items || l < index->number_of_large_items) {
+    size_t i;
+    if (l == index->number_of_large_items ||
+        (c < number_of_cell_items && cell_items[c] < index->large_items[l])) {
+      i = cell_items[c++];
+    } else {
+      i = index->large_items[l++];
+    }
+
+    if (box_contains_point(&(index->boxes[i]), point) == true) {
+      list = zathura_list_prepend(list, index->items[i]);
+    }
+  }
+
+  *items = zathura_list_reverse(list);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static gint
+compare_item_indices(gconstpointer a, gconstpointer b)
+{
+  const size_t lhs = *((const size_t*) a);
+  const size_t rhs = *((const size_t*) b);
+
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+zathura_error_t
+zathura_spatial_index_query_rectangle(zathura_spatial_index_t* index,
+    zathura_rectangle_t rectangle, zathura_list_t** items)
+{
+  if (index == NULL || items == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *items = NULL;
+
+  const zathura_rectangle_t box = rectangle_normalize(rectangle);
+  if (index->number_of_items == 0 ||
+      boxes_intersect(&(index->bounds), &box) == false) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  /* Items covering several cells are collected more than once */
+  GArray* candidates = g_array_new(FALSE, FALSE, sizeof(size_t));
+  g_array_append_vals(candidates, index->large_items, index->number_of_large_items);
+
+  const cell_range_t range = index_get_cell_range(index, &box);
+  for (unsigned int row = range.first_row; row <= range.last_row; row++) {
+    for (unsigned int column = range.first_column; column <= range.last_column; column++) {
+      const size_t cell = row * index->columns + column;
+      g_array_append_vals(candidates, index->cell_items + index->cell_offsets[cell],
+          index->cell_offsets[cell + 1] - index->cell_offsets[cell]);
+    }
+  }
+
+  g_array_sort(candidates, compare_item_indices);
+
+  zathura_list_t* list = NULL;
+  for (guint c = 0; c < candidates->len; c++) {
+    const size_t i = g_array_index(candidates, size_t, c);
+    if (c > 0 && g_array_index(candidates, size_t, c - 1) == i) {
+      continue;
+    }
+
+    if (boxes_intersect(&(index->boxes[i]), &box) == true) {
+      list = zathura_list_prepend(list, index->items[i]);
+    }
+  }
+
+  g_array_free(candidates, TRUE);
+
+  *items = zathura_list_reverse(list);
+
+  return ZATHURA_ERROR_OK;
+}
@@ -0,0 +1,78 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_SPATIAL_INDEX_H
+#define LIBZATHURA_SPATIAL_INDEX_H
+
+#include "error.h"
+#include "list.h"
+#include "macros.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct zathura_spatial_index_s zathura_spatial_index_t;
+
+/**
+ * Creates a spatial index over the given items. Every item has to start with
+ * its position as a zathura_rectangle_t, like zathura_link_mapping_t,
+ * zathura_annotation_mapping_t and zathura_form_field_mapping_t do. The items
+ * are distributed over a uniform grid with about one cell per item, so that
+ * queries only test the items of the cells they touch. Items covering many
+ * cells are kept aside and tested by every query.
+ *
+ * The index does not take ownership of the items, which have to stay valid
+ * and unchanged while the index is used.
+ *
+ * @param[out] index The spatial index
+ * @param[in] items The items
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_spatial_index_new(zathura_spatial_index_t**
+    index, zathura_list_t* items);
+
+/**
+ * Frees the spatial index.
+ *
+ * @param[in] index The spatial index
+ */
+HIDDEN void zathura_spatial_index_free(zathura_spatial_index_t* index);
+
+/**
+ * Returns the items that contain the given point.
+ *
+ * @param[in] index The spatial index
+ * @param[in] point The point
+ * @param[out] items The items in their original order, has to be freed with
+ *   zathura_list_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+HIDDEN zathura_error_t zathura_spatial_index_query_point(zathura_spatial_index_t*
+    index, zathura_point_t point, zathura_list_t** items);
+
+/**
+ * Returns the items that intersect the given rectangle.
+ *
+ * @param[in] index The spatial index
+ * @param[in] rectangle The rectangle
+ * @param[out] items The items in their original order, has to be freed with
+ *   zathura_list_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_spatial_index_query_rectangle(zathura_spatial_index_t*
+    index, zathura_rectangle_t rectangle, zathura_list_t** items);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_SPATIAL_INDEX_H */
@@ -0,0 +1,370 @@
+/* See LICENSE file for license and copyright information */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "text-index.h"
+
+/* Identifies cache files and their format version */
+static const char TEXT_INDEX_MAGIC[4] = { 'Z', 'T', 'I', '2' };
+
+/* Length stored in cache files for pages whose text could not be indexed */
+#define TEXT_INDEX_UNREADABLE UINT32_MAX
+
+/* Size of the chunks read while computing the key of a document file */
+#define DOCUMENT_KEY_READ_SIZE (1 << 16)
+
+struct zathura_text_index_s {
+  unsigned int number_of_pages; /**< Number of pages of the document */
+  char** texts; /**< Normalized text of each page */
+  bool* unreadable; /**< Pages whose text is not valid UTF-8 */
+  GHashTable* trigrams; /**< Maps trigrams to sorted arrays of page indices */
+};
+
+/* Packs the three bytes at text into a hash table key */
+static gpointer
+trigram_key(const char* text)
+{
+  const unsigned char* bytes = (const unsigned char*) text;
+  return GUINT_TO_POINTER(((guint) bytes[0] << 16) | ((guint) bytes[1] << 8) | bytes[2]);
+}
+
+static void
+free_page_array(gpointer data)
+{
+  g_array_free(data, TRUE);
+}
+
+zathura_error_t
+zathura_text_index_new(zathura_text_index_t** index, unsigned int
+    number_of_pages)
+{
+  if (index == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *index = calloc(1, sizeof(**index));
+  if (*index == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*index)->texts      = calloc(number_of_pages, sizeof(char*));
+  (*index)->unreadable = calloc(number_of_pages, sizeof(bool));
+  if (number_of_pages > 0 && ((*index)->texts == NULL || (*index)->unreadable == NULL)) {
+    free((*index)->texts);
+    free((*index)->unreadable);
+    free(*index);
+    *index = NULL;
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  (*index)->number_of_pages = number_of_pages;
+  (*index)->trigrams = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+      NULL, free_page_array);
+
+  return ZATHURA_ERROR_OK;
+}
+
+void
+zathura_text_index_free(zathura_text_index_t* index)
+{
+  if (index == NULL) {
+    return;
+  }
+
+  for (unsigned int i = 0; i < index->number_of_pages; i++) {
+    g_free(index->texts[i]);
+  }
+
+  g_hash_table_destroy(index->trigrams);
+  free(index->texts);
+  free(index->unreadable);
+  free(index);
+}
+
+char*
+zathura_text_index_normalize(const char* text)
+{
+  if (text == NULL) {
+    return NULL;
+  }
+
+  char* normalized = g_utf8_normalize(text, -1, G_NORMALIZE_ALL);
+  if (normalized == NULL) {
+    return NULL;
+  }
+
+  char* folded = g_utf8_casefold(normalized, -1);
+  g_free(normalized);
+
+  /* Line breaks of extracted text separate words just like spaces */
+  GString* result = g_string_sized_new(strlen(folded));
+  bool pending_space = false;
+  for (const char* c = folded; *c != '\0'; c = g_utf8_next_char(c)) {
+    if (g_unichar_isspace(g_utf8_get_char(c)) == TRUE) {
+      pending_space = true;
+      continue;
+    }
+
+    if (pending_space == true && result->len > 0) {
+      g_string_append_c(result, ' ');
+    }
+    pending_space = false;
+
+    g_string_append_len(result, c, g_utf8_next_char(c) - c);
+  }
+
+  g_free(folded);
+
+  return g_string_free(result, FALSE);
+}
+
+/* Takes ownership of the normalized text */
+static zathura_error_t
+text_index_add_normalized(zathura_text_index_t* index, unsigned int
+    page_index, char* text)
+{
+  index->texts[page_index] = text;
+
+  const size_t length = strlen(text);
+  for (size_t i = 0; i + 3 <= length; i++) {
+    gpointer key = trigram_key(text + i);
+
+    GArray* pages = g_hash_table_lookup(index->trigrams, key);
+    if (pages == NULL) {
+      pages = g_array_new(FALSE, FALSE, sizeof(unsigned int));
+      g_hash_table_insert(index->trigrams, key, pages);
+    }
+
+    /* pages are added in increasing order, so the arrays stay sorted */
+    if (pages->len == 0 || g_array_index(pages, unsigned int, pages->len - 1) != page_index) {
+      g_array_append_val(pages, page_index);
+    }
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_text_index_add_page(zathura_text_index_t* index, unsigned int
+    page_index, const char* text)
+{
+  if (index == NULL || text == NULL || page_index >= index->number_of_pages ||
+      index->texts[page_index] != NULL || index->unreadable[page_index] == true) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  char* normalized = zathura_text_index_normalize(text);
+  if (normalized == NULL) {
+    /* The index cannot tell whether text that is not valid UTF-8 contains the
+     * search item, so the page is left to the plugin */
+    index->unreadable[page_index] = true;
+    return ZATHURA_ERROR_OK;
+  }
+
+  return text_index_add_normalized(index, page_index, normalized);
+}
+
+static void
+text_index_add_unreadable_pages(zathura_text_index_t* index, bool* pages)
+{
+  for (unsigned int i = 0; i < index->number_of_pages; i++) {
+    pages[i] = pages[i] || index->unreadable[i];
+  }
+}
+
+zathura_error_t
+zathura_text_index_find(zathura_text_index_t* index, const char* text, bool*
+    pages)
+{
+  if (index == NULL || text == NULL || pages == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  memset(pages, 0, index->number_of_pages * sizeof(bool));
+
+  char* needle = zathura_text_index_normalize(text);
+  if (needle == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  const size_t length = strlen(needle);
+
+  /* Only pages containing the rarest trigram of the search item have to be
+   * checked; search items shorter than a trigram are checked on all pages */
+  GArray* candidates = NULL;
+  for (size_t i = 0; i + 3 <= length; i++) {
+    GArray* trigram_pages = g_hash_table_lookup(index->trigrams, trigram_key(needle + i));
+    if (trigram_pages == NULL) {
+      text_index_add_unreadable_pages(index, pages);
+      g_free(needle);
+      return ZATHURA_ERROR_OK;
+    }
+
+    if (candidates == NULL || trigram_pages->len < candidates->len) {
+      candidates = trigram_pages;
+    }
+  }
+
+  const unsigned int number_of_candidates = (candidates != NULL) ?
+    candidates->len : index->number_of_pages;
+  for (unsigned int i = 0; i < number_of_candidates; i++) {
+    const unsigned int page = (candidates != NULL) ?
+      g_array_index(candidates, unsigned int, i) : i;
+
+    if (index->texts[page] != NULL && strstr(index->texts[page], needle) != NULL) {
+      pages[page] = true;
+    }
+  }
+
+  text_index_add_unreadable_pages(index, pages);
+  g_free(needle);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_text_index_get_document_key(const char* path, char** key)
+{
+  if (path == NULL || key == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  guchar* buffer = malloc(DOCUMENT_KEY_READ_SIZE);
+  if (buffer == NULL) {
+    fclose(file);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  GChecksum* checksum = g_checksum_new(G_CHECKSUM_SHA256);
+  size_t bytes_read = 0;
+  while ((bytes_read = fread(buffer, 1, DOCUMENT_KEY_READ_SIZE, file)) > 0) {
+    g_checksum_update(checksum, buffer, bytes_read);
+  }
+
+  const bool failed = (ferror(file) != 0);
+  fclose(file);
+  free(buffer);
+
+  *key = (failed == false) ? g_strdup(g_checksum_get_string(checksum)) : NULL;
+  g_checksum_free(checksum);
+
+  return (*key != NULL) ? ZATHURA_ERROR_OK : ZATHURA_ERROR_UNKNOWN;
+}
+
+zathura_error_t
+zathura_text_index_save(zathura_text_index_t* index, const char* path)
+{
+  if (index == NULL || path == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* magic, number of pages and for every page the length of the text
+   * followed by the text, or TEXT_INDEX_UNREADABLE */
+  GString* data = g_string_new(NULL);
+  g_string_append_len(data, TEXT_INDEX_MAGIC, sizeof(TEXT_INDEX_MAGIC));
+
+  const uint32_t number_of_pages = index->number_of_pages;
+  g_string_append_len(data, (const char*) &number_of_pages, sizeof(number_of_pages));
+
+  for (unsigned int i = 0; i < index->number_of_pages; i++) {
+    if (index->unreadable[i] == true) {
+      const uint32_t length = TEXT_INDEX_UNREADABLE;
+      g_string_append_len(data, (const char*) &length, sizeof(length));
+      continue;
+    }
+
+    const char* text = (index->texts[i] != NULL) ? index->texts[i] : "";
+    const uint32_t length = strlen(text);
+    g_string_append_len(data, (const char*) &length, sizeof(length));
+    g_string_append_len(data, text, length);
+  }
+
+  const gboolean written = g_file_set_contents(path, data->str, data->len, NULL);
+  g_string_free(data, TRUE);
+
+  return (written == TRUE) ? ZATHURA_ERROR_OK : ZATHURA_ERROR_UNKNOWN;
+}
+
+zathura_error_t
+zathura_text_index_load(zathura_text_index_t** index, const char* path,
+    unsigned int number_of_pages)
+{
+  if (index == NULL || path == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  char* data = NULL;
+  gsize size = 0;
+  if (g_file_get_contents(path, &data, &size, NULL) == FALSE) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  zathura_error_t error = ZATHURA_ERROR_UNKNOWN;
+  uint32_t stored_number_of_pages = 0;
+  size_t offset = sizeof(TEXT_INDEX_MAGIC) + sizeof(stored_number_of_pages);
+
+  if (size < offset || memcmp(data, TEXT_INDEX_MAGIC, sizeof(TEXT_INDEX_MAGIC)) != 0) {
+    goto error_free;
+  }
+
+  memcpy(&stored_number_of_pages, data + sizeof(TEXT_INDEX_MAGIC), sizeof(stored_number_of_pages));
+  if (stored_number_of_pages != number_of_pages) {
+    goto error_free;
+  }
+
+  if ((error = zathura_text_index_new(index, number_of_pages)) != ZATHURA_ERROR_OK) {
+    goto error_free;
+  }
+
+  for (unsigned int i = 0; i < number_of_pages; i++) {
+    uint32_t length = 0;
+    if (size - offset < sizeof(length)) {
+      error = ZATHURA_ERROR_UNKNOWN;
+      goto error_free_index;
+    }
+    memcpy(&length, data + offset, sizeof(length));
+    offset += sizeof(length);
+
+    if (length == TEXT_INDEX_UNREADABLE) {
+      (*index)->unreadable[i] = true;
+      continue;
+    }
+
+    if (size - offset < length) {
+      error = ZATHURA_ERROR_UNKNOWN;
+      goto error_free_index;
+    }
+
+    char* text = g_strndup(data + offset, length);
+    offset += length;
+
+    if ((error = text_index_add_normalized(*index, i, text)) != ZATHURA_ERROR_OK) {
+      goto error_free_index;
+    }
+  }
+
+  g_free(data);
+
+  return ZATHURA_ERROR_OK;
+
+error_free_index:
+
+  zathura_text_index_free(*index);
+  *index = NULL;
+
+error_free:
+
+  g_free(data);
+
+  return error;
+}
@@ -0,0 +1,131 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_TEXT_INDEX_H
+#define LIBZATHURA_TEXT_INDEX_H
+
+#include <stdbool.h>
+
+#include "error.h"
+#include "macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct zathura_text_index_s zathura_text_index_t;
+
+/**
+ * Creates an empty text index for a document. The index stores the
+ * normalized text of each page together with a trigram index over it, so
+ * that the pages containing a search item are found without asking the
+ * plugin to extract the text again.
+ *
+ * @param[out] index The text index
+ * @param[in] number_of_pages The number of pages of the document
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_text_index_new(zathura_text_index_t** index,
+    unsigned int number_of_pages);
+
+/**
+ * Frees the text index.
+ *
+ * @param[in] index The text index
+ */
+HIDDEN void zathura_text_index_free(zathura_text_index_t* index);
+
+/**
+ * Normalizes text for the index: the text is brought into compatibility
+ * decomposed form, case folded and runs of white space are collapsed into a
+ * single space.
+ *
+ * @param[in] text The text
+ *
+ * @return The normalized text, has to be freed with g_free, or NULL if the
+ *   text is not valid UTF-8
+ */
+HIDDEN char* zathura_text_index_normalize(const char* text);
+
+/**
+ * Adds the text of a page to the index. Pages have to be added in increasing
+ * order and only once. Pages whose text is not valid UTF-8 are reported as
+ * candidates by every search.
+ *
+ * @param[in] index The text index
+ * @param[in] page_index The index of the page
+ * @param[in] text The text of the page as extracted by the plugin
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_text_index_add_page(zathura_text_index_t*
+    index, unsigned int page_index, const char* text);
+
+/**
+ * Determines the pages whose normalized text contains the normalized search
+ * item. The plugin may still find no results on these pages, e.g. if the
+ * search is case-sensitive, but it finds none on the other pages.
+ *
+ * @param[in] index The text index
+ * @param[in] text The search item
+ * @param[out] pages Array with an entry for every page of the document that
+ *   is set to true for pages containing the search item
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ */
+HIDDEN zathura_error_t zathura_text_index_find(zathura_text_index_t* index,
+    const char* text, bool* pages);
+
+/**
+ * Computes the key of a document file for cache files of its text index,
+ * the SHA-256 checksum of its content.
+ *
+ * @param[in] path The path of the document file
+ * @param[out] key The key, has to be freed with g_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The file could not be read
+ */
+HIDDEN zathura_error_t zathura_text_index_get_document_key(const char* path,
+    char** key);
+
+/**
+ * Writes the text index to a cache file.
+ *
+ * @param[in] index The text index
+ * @param[in] path The path of the cache file
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The file could not be written
+ */
+HIDDEN zathura_error_t zathura_text_index_save(zathura_text_index_t* index,
+    const char* path);
+
+/**
+ * Reads a text index from a cache file written by zathura_text_index_save.
+ *
+ * @param[out] index The text index
+ * @param[in] path The path of the cache file
+ * @param[in] number_of_pages The number of pages of the document
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The file could not be read or does not match
+ *   the document
+ */
+HIDDEN zathura_error_t zathura_text_index_load(zathura_text_index_t** index,
+    const char* path, unsigned int number_of_pages);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_TEXT_INDEX_H */
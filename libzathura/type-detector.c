@@ -0,0 +1,401 @@
+/* See LICENSE file for license and copyright information */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <glib.h>
+
+#ifdef WITH_MAGIC
+#include <magic.h>
+#endif
+
+#include "type-detector.h"
+#include "internal.h"
+
+typedef struct signature_part_s {
+  size_t offset; /**< Offset relative to the start of the signature */
+  const char* bytes; /**< Expected bytes */
+  size_t length; /**< Number of expected bytes */
+} signature_part_t;
+
+typedef struct signature_s {
+  const char* mime_type; /**< Mime type identified by the signature */
+  size_t search_range; /**< The signature may start anywhere up to this offset */
+  signature_part_t parts[2]; /**< Parts that have to match, unused parts are empty */
+} signature_t;
+
+/* Signatures of document formats that are handled by plugins */
+static const signature_t signatures[] = {
+  { "application/pdf",        1024, { { 0, "%PDF-", 5 } } },
+  { "application/postscript", 0,    { { 0, "%!PS", 4 } } },
+  { "image/vnd.djvu",         0,    { { 0, "AT&TFORM", 8 }, { 12, "DJV", 3 } } },
+  { "application/epub+zip",   0,    { { 0, "PK\x03\x04", 4 }, { 30, "mimetypeapplication/epub+zip", 28 } } },
+  { "application/x-cbr",      0,    { { 0, "Rar!\x1a\x07", 6 } } },
+  { "application/x-cb7",      0,    { { 0, "7z\xbc\xaf\x27\x1c", 6 } } },
+  { "image/tiff",             0,    { { 0, "II*\0", 4 } } },
+  { "image/tiff",             0,    { { 0, "MM\0*", 4 } } },
+};
+
+/* Number of bytes read from a file descriptor for content sniffing */
+#define CONTENT_READ_SIZE (1 << 16)
+
+typedef struct type_cache_key_s {
+  dev_t device;
+  ino_t inode;
+  time_t mtime;
+  long mtime_nsec;
+  off_t size;
+} type_cache_key_t;
+
+struct zathura_type_detector_s {
+  bool enabled[G_N_ELEMENTS(signatures)]; /**< Enabled signatures */
+
+  GMutex lock; /**< Protects the cache and the magic cookie */
+  GHashTable* cache; /**< Maps type_cache_key_t to detected mime types */
+#ifdef WITH_MAGIC
+  magic_t magic; /**< Magic cookie with loaded database */
+  bool magic_failed; /**< Loading the magic database failed */
+#endif
+};
+
+static guint
+type_cache_key_hash(gconstpointer data)
+{
+  const type_cache_key_t* key = data;
+
+  guint hash = (guint) key->inode;
+  hash = hash * 31 + (guint) key->device;
+  hash = hash * 31 + (guint) key->mtime;
+  hash = hash * 31 + (guint) key->mtime_nsec;
+  hash = hash * 31 + (guint) key->size;
+
+  return hash;
+}
+
+static gboolean
+type_cache_key_equal(gconstpointer a, gconstpointer b)
+{
+  const type_cache_key_t* lhs = a;
+  const type_cache_key_t* rhs = b;
+
+  return lhs->device == rhs->device && lhs->inode == rhs->inode &&
+    lhs->mtime == rhs->mtime && lhs->mtime_nsec == rhs->mtime_nsec &&
+    lhs->size == rhs->size;
+}
+
+zathura_error_t
+zathura_type_detector_new(zathura_type_detector_t** detector)
+{
+  if (detector == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  *detector = calloc(1, sizeof(**detector));
+  if (*detector == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  g_mutex_init(&((*detector)->lock));
+  (*detector)->cache = g_hash_table_new_full(type_cache_key_hash,
+      type_cache_key_equal, free, g_free);
+
+  return ZATHURA_ERROR_OK;
+}
+
+void
+zathura_type_detector_free(zathura_type_detector_t* detector)
+{
+  if (detector == NULL) {
+    return;
+  }
+
+#ifdef WITH_MAGIC
+  if (detector->magic != NULL) {
+    magic_close(detector->magic);
+  }
+#endif
+
+  g_hash_table_destroy(detector->cache);
+  g_mutex_clear(&(detector->lock));
+  free(detector);
+}
+
+void
+zathura_type_detector_enable_mime_type(zathura_type_detector_t* detector,
+    const char* mime_type)
+{
+  if (detector == NULL || mime_type == NULL) {
+    return;
+  }
+
+  for (size_t i = 0; i < G_N_ELEMENTS(signatures); i++) {
+    if (g_ascii_strcasecmp(signatures[i].mime_type, mime_type) == 0) {
+      detector->enabled[i] = true;
+    }
+  }
+}
+
+static bool
+signature_matches(const signature_t* signature, const unsigned char* data,
+    size_t length, size_t start)
+{
+  for (size_t i = 0; i < G_N_ELEMENTS(signature->parts); i++) {
+    const signature_part_t* part = &(signature->parts[i]);
+    if (part->length == 0) {
+      continue;
+    }
+
+    const size_t offset = start + part->offset;
+    if (offset > length || part->length > length - offset ||
+        memcmp(data + offset, part->bytes, part->length) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static const char*
+detector_match_signatures(zathura_type_detector_t* detector, const unsigned
+    char* data, size_t length)
+{
+  for (size_t i = 0; i < G_N_ELEMENTS(signatures); i++) {
+    if (detector->enabled[i] == false) {
+      continue;
+    }
+
+    for (size_t start = 0; start <= signatures[i].search_range && start < length; start++) {
+      if (signature_matches(&(signatures[i]), data, length, start) == true) {
+        return signatures[i].mime_type;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+#ifdef WITH_MAGIC
+/* Has to be called with the lock held */
+static bool
+detector_load_magic(zathura_type_detector_t* detector)
+{
+  if (detector->magic == NULL && detector->magic_failed == false) {
+    const int flags =
+      MAGIC_MIME_TYPE |
+      MAGIC_SYMLINK |
+      MAGIC_NO_CHECK_APPTYPE |
+      MAGIC_NO_CHECK_CDF |
+      MAGIC_NO_CHECK_ELF |
+      MAGIC_NO_CHECK_ENCODING;
+
+    /* the database is only loaded once per detector */
+    detector->magic = magic_open(flags);
+    if (detector->magic != NULL && magic_load(detector->magic, NULL) < 0) {
+      magic_close(detector->magic);
+      detector->magic = NULL;
+    }
+
+    detector->magic_failed = (detector->magic == NULL);
+  }
+
+  return detector->magic != NULL;
+}
+
+static char*
+detector_guess_data_type_magic(zathura_type_detector_t* detector, const
+    unsigned char* data, size_t length)
+{
+  char* type = NULL;
+
+  g_mutex_lock(&(detector->lock));
+  if (detector_load_magic(detector) == true) {
+    const char* mime_type = magic_buffer(detector->magic, data, length);
+    type = (mime_type != NULL) ? g_strdup(mime_type) : NULL;
+  }
+  g_mutex_unlock(&(detector->lock));
+
+  return type;
+}
+#endif
+
+static char*
+detector_cache_lookup(zathura_type_detector_t* detector, const
+    type_cache_key_t* key)
+{
+  g_mutex_lock(&(detector->lock));
+  const char* cached_type = g_hash_table_lookup(detector->cache, key);
+  char* type = (cached_type != NULL) ? g_strdup(cached_type) : NULL;
+  g_mutex_unlock(&(detector->lock));
+
+  return type;
+}
+
+static void
+detector_cache_insert(zathura_type_detector_t* detector, const
+    type_cache_key_t* key, const char* type)
+{
+  g_mutex_lock(&(detector->lock));
+
+  if (g_hash_table_size(detector->cache) >= ZATHURA_TYPE_DETECTOR_CACHE_SIZE) {
+    g_hash_table_remove_all(detector->cache);
+  }
+
+  type_cache_key_t* cache_key = malloc(sizeof(*cache_key));
+  if (cache_key != NULL) {
+    *cache_key = *key;
+    g_hash_table_replace(detector->cache, cache_key, g_strdup(type));
+  }
+
+  g_mutex_unlock(&(detector->lock));
+}
+
+static void
+type_cache_key_init(type_cache_key_t* key, const struct stat* file_stat)
+{
+  key->device     = file_stat->st_dev;
+  key->inode      = file_stat->st_ino;
+  key->mtime      = file_stat->st_mtim.tv_sec;
+  key->mtime_nsec = file_stat->st_mtim.tv_nsec;
+  key->size       = file_stat->st_size;
+}
+
+/* Reads from the start of the file without moving the file offset */
+static size_t
+read_prefix(int fd, unsigned char* data, size_t size)
+{
+  size_t length = 0;
+  while (length < size) {
+    const ssize_t bytes_read = pread(fd, data + length, size - length, length);
+    if (bytes_read <= 0) {
+      break;
+    }
+    length += bytes_read;
+  }
+
+  return length;
+}
+
+static char*
+detector_guess_data(zathura_type_detector_t* detector, const unsigned char*
+    data, size_t length)
+{
+  /* check the signatures of the formats supported by plugins */
+  const char* mime_type = detector_match_signatures(detector, data, length);
+  if (mime_type != NULL) {
+    return g_strdup(mime_type);
+  }
+
+  char* type = NULL;
+#ifdef WITH_MAGIC
+  type = detector_guess_data_type_magic(detector, data, length);
+  if (type != NULL) {
+    return type;
+  }
+#endif
+
+  zathura_guess_type_data_fallback(data, length, &type);
+  return type;
+}
+
+/* Sniffs the start of a regular file, the results are cached by the identity
+ * and modification time of the file */
+static zathura_error_t
+detector_guess_file(zathura_type_detector_t* detector, int fd, const struct
+    stat* file_stat, char** type)
+{
+  type_cache_key_t key;
+  type_cache_key_init(&key, file_stat);
+
+  *type = detector_cache_lookup(detector, &key);
+  if (*type != NULL) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  const size_t size = MIN((size_t) file_stat->st_size, CONTENT_READ_SIZE);
+  if (size == 0) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  unsigned char* data = malloc(size);
+  if (data == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  const size_t length = read_prefix(fd, data, size);
+  if (length > 0) {
+    *type = detector_guess_data(detector, data, length);
+  }
+  free(data);
+
+  if (*type == NULL) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  detector_cache_insert(detector, &key, *type);
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+zathura_type_detector_guess(zathura_type_detector_t* detector, const char*
+    path, char** type)
+{
+  if (detector == NULL || path == NULL || strlen(path) == 0 || type == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  const int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  struct stat file_stat;
+  zathura_error_t error = ZATHURA_ERROR_UNKNOWN;
+  if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) != 0) {
+    error = detector_guess_file(detector, fd, &file_stat, type);
+  }
+
+  close(fd);
+
+  return error;
+}
+
+zathura_error_t
+zathura_type_detector_guess_data(zathura_type_detector_t* detector, const
+    void* data, size_t length, char** type)
+{
+  if (detector == NULL || data == NULL || length == 0 || type == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* at most the same amount of data is inspected as for files */
+  *type = detector_guess_data(detector, data, MIN(length, CONTENT_READ_SIZE));
+
+  return (*type != NULL) ? ZATHURA_ERROR_OK : ZATHURA_ERROR_UNKNOWN;
+}
+
+zathura_error_t
+zathura_type_detector_guess_fd(zathura_type_detector_t* detector, int fd,
+    char** type)
+{
+  if (detector == NULL || fd < 0 || type == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  /* sniffing must not consume data the plugin still has to read */
+  if (S_ISREG(file_stat.st_mode) == 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  return detector_guess_file(detector, fd, &file_stat, type);
+}
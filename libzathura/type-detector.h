@@ -0,0 +1,109 @@
+/* See LICENSE file for license and copyright information */
+
+#ifndef LIBZATHURA_TYPE_DETECTOR_H
+#define LIBZATHURA_TYPE_DETECTOR_H
+
+#include <stddef.h>
+
+#include "error.h"
+#include "macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum number of detected types that are cached
+ */
+#define ZATHURA_TYPE_DETECTOR_CACHE_SIZE 4096
+
+typedef struct zathura_type_detector_s zathura_type_detector_t;
+
+/**
+ * Creates a new type detector. A type detector keeps the magic database loaded
+ * between detections and caches the detected types of files, keyed by device,
+ * inode, modification time and size of the file.
+ *
+ * @param[out] detector The type detector
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ */
+HIDDEN zathura_error_t zathura_type_detector_new(zathura_type_detector_t** detector);
+
+/**
+ * Frees the type detector.
+ *
+ * @param[in] detector The type detector
+ */
+HIDDEN void zathura_type_detector_free(zathura_type_detector_t* detector);
+
+/**
+ * Enables the built-in signatures of the given mime type, so that files of
+ * this type are recognized from their first bytes without consulting the
+ * magic database. Mime types without a built-in signature are ignored.
+ *
+ * @param[in] detector The type detector
+ * @param[in] mime_type The mime type
+ */
+HIDDEN void zathura_type_detector_enable_mime_type(zathura_type_detector_t*
+    detector, const char* mime_type);
+
+/**
+ * Detects the mime type of the given file from its first bytes like
+ * zathura_type_detector_guess_data, so no other process is spawned. The
+ * results are cached by the identity and modification time of the file.
+ *
+ * @param[in] detector The type detector
+ * @param[in] path The path of the file
+ * @param[out] type The mime type, has to be freed with g_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+HIDDEN zathura_error_t zathura_type_detector_guess(zathura_type_detector_t*
+    detector, const char* path, char** type);
+
+/**
+ * Detects the mime type of in-memory data. The enabled signatures are checked
+ * first, then the magic database and glib are consulted. Only the first 64
+ * KiB of the data are inspected.
+ *
+ * @param[in] detector The type detector
+ * @param[in] data The data
+ * @param[in] length The length of the data
+ * @param[out] type The mime type, has to be freed with g_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+HIDDEN zathura_error_t zathura_type_detector_guess_data(zathura_type_detector_t*
+    detector, const void* data, size_t length, char** type);
+
+/**
+ * Detects the mime type of the file referred to by the file descriptor. The
+ * start of the file is read without changing the file offset, so the
+ * descriptor has to refer to a regular file. Results are cached like for
+ * zathura_type_detector_guess.
+ *
+ * @param[in] detector The type detector
+ * @param[in] fd The file descriptor
+ * @param[out] type The mime type, has to be freed with g_free
+ *
+ * @return ZATHURA_ERROR_OK No error occurred
+ * @return ZATHURA_ERROR_INVALID_ARGUMENTS Invalid arguments have been passed
+ * @return ZATHURA_ERROR_OUT_OF_MEMORY Out of memory
+ * @return ZATHURA_ERROR_UNKNOWN The type could not be detected
+ */
+HIDDEN zathura_error_t zathura_type_detector_guess_fd(zathura_type_detector_t*
+    detector, int fd, char** type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBZATHURA_TYPE_DETECTOR_H */
@@ -7,6 +7,9 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "list.h"
 #include "node.h"
 
@@ -30,11 +33,22 @@ typedef struct zathura_quad_point_s {
 typedef enum zathura_search_flag_e {
   ZATHURA_SEARCH_DEFAULT           = 0,
   ZATHURA_SEARCH_CASE_SENSITIVE    = 1 << 0,
-  ZATHURA_SEARCH_WHOLE_WORDS_ONLY = 1 << 1
+  ZATHURA_SEARCH_WHOLE_WORDS_ONLY = 1 << 1,
+  ZATHURA_SEARCH_REGEX             = 1 << 2,
+  ZATHURA_SEARCH_IGNORE_DIACRITICS = 1 << 3
 } zathura_search_flag_t;
 
+typedef struct zathura_glyph_s {
+  uint32_t codepoint; /**< Unicode code point of the character */
+  zathura_rectangle_t position; /**< Bounding box of the character */
+  unsigned int font; /**< Plugin specific id of the font */
+  unsigned int line; /**< Index of the line on the page */
+  unsigned int block; /**< Index of the block on the page */
+} zathura_glyph_t;
+
 typedef struct zathura_path_s {
-  zathura_list_t* points;
+  zathura_point_t* points; /**< The points along the path */
+  size_t number_of_points; /**< The number of points */
 } zathura_path_t;
 
 #include "action.h"
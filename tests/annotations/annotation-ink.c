@@ -48,28 +48,50 @@ START_TEST(test_annotation_ink_get_type) {
 } END_TEST
 
 START_TEST(test_annotation_ink_set_paths) {
-  zathura_list_t* paths = zathura_list_alloc();
-  fail_unless(paths != NULL);
+  zathura_point_t points[] = { { 0, 0 }, { 10, 10 }, { 20, 0 } };
+  zathura_path_t paths[] = { { points, 3 }, { NULL, 0 } };
+  zathura_path_t invalid_paths[] = { { NULL, 3 } };
 
   /* invalid arguments */
-  fail_unless(zathura_annotation_ink_set_paths(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_ink_set_paths(NULL, paths) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_set_paths(NULL, NULL, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_set_paths(NULL, paths, 2) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_set_paths(annotation, NULL, 2) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_set_paths(annotation, invalid_paths, 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
   /* valid arguments */
-  fail_unless(zathura_annotation_ink_set_paths(annotation, paths) == ZATHURA_ERROR_OK);
-  fail_unless(zathura_annotation_ink_set_paths(annotation, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_ink_set_paths(annotation, paths, 2) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_ink_set_paths(annotation, NULL, 0) == ZATHURA_ERROR_OK);
 } END_TEST
 
 START_TEST(test_annotation_ink_get_paths) {
-  zathura_list_t* paths;
+  const zathura_path_t* paths;
+  size_t number_of_paths;
+  zathura_point_t points_1[] = { { 0, 0 }, { 10, 10 }, { 20, 0 } };
+  zathura_point_t points_2[] = { { 5, 5 }, { 15, 15 } };
+  zathura_path_t paths_input[] = { { points_1, 3 }, { NULL, 0 }, { points_2, 2 } };
 
   /* invalid arguments */
-  fail_unless(zathura_annotation_ink_get_paths(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_ink_get_paths(annotation, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_ink_get_paths(NULL, &paths) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_get_paths(NULL, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_get_paths(annotation, NULL, &number_of_paths) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_get_paths(annotation, &paths, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_ink_get_paths(NULL, &paths, &number_of_paths) == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
   /* valid arguments */
-  fail_unless(zathura_annotation_ink_get_paths(annotation, &paths) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_ink_get_paths(annotation, &paths, &number_of_paths) == ZATHURA_ERROR_OK);
+  fail_unless(paths == NULL);
+  fail_unless(number_of_paths == 0);
+
+  /* the points of all paths are packed */
+  fail_unless(zathura_annotation_ink_set_paths(annotation, paths_input, 3) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_ink_get_paths(annotation, &paths, &number_of_paths) == ZATHURA_ERROR_OK);
+  fail_unless(number_of_paths == 3);
+  fail_unless(paths[0].number_of_points == 3);
+  fail_unless(paths[1].number_of_points == 0);
+  fail_unless(paths[2].number_of_points == 2);
+  fail_unless(paths[0].points != points_1);
+  fail_unless(paths[2].points == paths[0].points + 3);
+  fail_unless(paths[0].points[2].x == 20 && paths[0].points[2].y == 0);
+  fail_unless(paths[2].points[1].x == 15 && paths[2].points[1].y == 15);
 } END_TEST
 
 START_TEST(test_annotation_ink_set_border) {
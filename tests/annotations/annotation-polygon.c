@@ -48,29 +48,40 @@ START_TEST(test_annotation_polygon_get_type) {
 } END_TEST
 
 START_TEST(test_annotation_polygon_set_vertices) {
-  zathura_list_t* vertices = zathura_list_alloc();
-  fail_unless(vertices != NULL);
+  zathura_point_t vertices[] = { { 0, 0 }, { 10, 0 }, { 10, 10 } };
 
   /* invalid arguments */
-  fail_unless(zathura_annotation_polygon_set_vertices(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_polygon_set_vertices(annotation, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_polygon_set_vertices(NULL, vertices) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_set_vertices(NULL, NULL, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_set_vertices(annotation, NULL, 3) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_set_vertices(NULL, vertices, 3) == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
   /* valid arguments */
-  fail_unless(zathura_annotation_polygon_set_vertices(annotation, vertices) == ZATHURA_ERROR_OK);
-  zathura_list_free(vertices);
+  fail_unless(zathura_annotation_polygon_set_vertices(annotation, vertices, 3) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_polygon_set_vertices(annotation, NULL, 0) == ZATHURA_ERROR_OK);
 } END_TEST
 
 START_TEST(test_annotation_polygon_get_vertices) {
-  zathura_list_t* vertices;
+  const zathura_point_t* vertices;
+  size_t number_of_vertices;
+  zathura_point_t vertices_input[] = { { 0, 0 }, { 10, 0 }, { 10, 10 } };
 
   /* invalid arguments */
-  fail_unless(zathura_annotation_polygon_get_vertices(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_polygon_get_vertices(annotation, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_annotation_polygon_get_vertices(NULL, &vertices) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_get_vertices(NULL, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_get_vertices(annotation, NULL, &number_of_vertices) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_get_vertices(annotation, &vertices, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_annotation_polygon_get_vertices(NULL, &vertices, &number_of_vertices) == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
   /* valid arguments */
-  fail_unless(zathura_annotation_polygon_get_vertices(annotation, &vertices) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_polygon_get_vertices(annotation, &vertices, &number_of_vertices) == ZATHURA_ERROR_OK);
+  fail_unless(vertices == NULL);
+  fail_unless(number_of_vertices == 0);
+
+  fail_unless(zathura_annotation_polygon_set_vertices(annotation, vertices_input, 3) == ZATHURA_ERROR_OK);
+  vertices_input[2].x = 20;
+  fail_unless(zathura_annotation_polygon_get_vertices(annotation, &vertices, &number_of_vertices) == ZATHURA_ERROR_OK);
+  fail_unless(number_of_vertices == 3);
+  fail_unless(vertices[1].x == 10 && vertices[1].y == 0);
+  fail_unless(vertices[2].x == 10 && vertices[2].y == 10);
 } END_TEST
 
 START_TEST(test_annotation_polygon_set_border) {
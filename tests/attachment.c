@@ -1,9 +1,13 @@
 /* See LICENSE file for license and copyright information */
 
+#define _XOPEN_SOURCE 700
+
 #include <check.h>
 #include <fiu.h>
 #include <fiu-control.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 
 #include <libzathura/attachment.h>
 #include <libzathura/plugin-api.h>
@@ -13,6 +17,7 @@
 #define CHECKSUM "ABCDABCDABCDABCD"
 #define DESCRIPTION "description"
 #define NAME "name"
+#define FILE_DATA "0123456789"
 
 zathura_attachment_t* attachment;
 
@@ -149,7 +154,7 @@ START_TEST(test_attachment_get_data) {
 } END_TEST
 
 START_TEST(test_attachment_get_size) {
-  unsigned int size = 0;
+  uint64_t size = 0;
 
   /* invalid arguments */
   fail_unless(zathura_attachment_get_size(NULL, NULL)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
@@ -157,11 +162,164 @@ START_TEST(test_attachment_get_size) {
   fail_unless(zathura_attachment_get_size(NULL, &size)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
   /* valid arguments */
-  unsigned int size2 = 1;
+  uint64_t size2 = 1;
   fail_unless(zathura_attachment_get_size(attachment, &size2) == ZATHURA_ERROR_OK);
   fail_unless(size == size2);
 } END_TEST
 
+static unsigned int borrowed_data_freed = 0;
+
+static void borrowed_data_free_function(void* data) {
+  borrowed_data_freed++;
+}
+
+START_TEST(test_attachment_set_data_borrowed) {
+  const char* data = "data";
+
+  /* invalid arguments */
+  fail_unless(zathura_attachment_set_data_borrowed(NULL, NULL, 0, NULL)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_borrowed(NULL, data, 4, NULL)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_borrowed(attachment, NULL, 0, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the data is not copied */
+  borrowed_data_freed = 0;
+  fail_unless(zathura_attachment_set_data_borrowed(attachment, data, strlen(data), borrowed_data_free_function) == ZATHURA_ERROR_OK);
+
+  char* data2;
+  uint64_t size;
+  fail_unless(zathura_attachment_get_data(attachment, &data2) == ZATHURA_ERROR_OK);
+  fail_unless(data2 == data);
+  fail_unless(zathura_attachment_get_size(attachment, &size) == ZATHURA_ERROR_OK);
+  fail_unless(size == strlen(data));
+
+  /* replacing the data releases it */
+  fail_unless(zathura_attachment_set_data(attachment, data, strlen(data)) == ZATHURA_ERROR_OK);
+  fail_unless(borrowed_data_freed == 1);
+} END_TEST
+
+static char* create_data_file(void) {
+  char* path = strdup("/tmp/libzathura-attachment-XXXXXX");
+  fail_unless(path != NULL);
+
+  const int fd = mkstemp(path);
+  fail_unless(fd != -1);
+  fail_unless(write(fd, FILE_DATA, strlen(FILE_DATA)) == (ssize_t) strlen(FILE_DATA));
+  fail_unless(close(fd) == 0);
+
+  return path;
+}
+
+static void check_file_contents(const char* path, const char* data) {
+  char buffer[32] = { 0 };
+
+  FILE* file = fopen(path, "rb");
+  fail_unless(file != NULL);
+  fail_unless(fread(buffer, 1, sizeof(buffer) - 1, file) == strlen(data));
+  fail_unless(fclose(file) == 0);
+  fail_unless(strcmp(buffer, data) == 0);
+}
+
+START_TEST(test_attachment_set_data_file) {
+  char* path = create_data_file();
+
+  /* invalid arguments */
+  fail_unless(zathura_attachment_set_data_file(NULL, path, 0, 1)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_file(attachment, NULL, 0, 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_file(attachment, "", 0, 1)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_file(attachment, path, 8, 4) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_file(attachment, path, 11, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_data_file(attachment, "/nonexistent", 0, 1) == ZATHURA_ERROR_UNKNOWN);
+
+  /* valid arguments */
+  fail_unless(zathura_attachment_set_data_file(attachment, path, 2, 4) == ZATHURA_ERROR_OK);
+
+  uint64_t size;
+  fail_unless(zathura_attachment_get_size(attachment, &size) == ZATHURA_ERROR_OK);
+  fail_unless(size == 4);
+
+  char* data;
+  fail_unless(zathura_attachment_get_data(attachment, &data) == ZATHURA_ERROR_OK);
+  fail_unless(memcmp(data, "2345", 4) == 0);
+
+  unlink(path);
+  free(path);
+} END_TEST
+
+static zathura_error_t attachment_read_function(zathura_attachment_t* attachment,
+    uint64_t offset, void* buffer, size_t length, size_t* bytes_read, void* user_data) {
+  /* provides at most three bytes at once */
+  const size_t n = length < 3 ? length : 3;
+  for (size_t i = 0; i < n; i++) {
+    ((char*) buffer)[i] = FILE_DATA[(offset + i) % 10];
+  }
+
+  *bytes_read = n;
+  return ZATHURA_ERROR_OK;
+}
+
+START_TEST(test_attachment_set_read_function) {
+  /* invalid arguments */
+  fail_unless(zathura_attachment_set_read_function(NULL, NULL, 0)                           == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_read_function(NULL, attachment_read_function, 0)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_set_read_function(attachment, NULL, 0)                     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* sizes beyond 4 GiB */
+  const uint64_t large_size = UINT64_C(5) << 30;
+  fail_unless(zathura_attachment_set_read_function(attachment, attachment_read_function, large_size) == ZATHURA_ERROR_OK);
+
+  uint64_t size;
+  fail_unless(zathura_attachment_get_size(attachment, &size) == ZATHURA_ERROR_OK);
+  fail_unless(size == large_size);
+
+  /* the data is not available in memory */
+  char* data;
+  fail_unless(zathura_attachment_get_data(attachment, &data) == ZATHURA_ERROR_UNKNOWN);
+} END_TEST
+
+START_TEST(test_attachment_reader) {
+  zathura_attachment_reader_t* reader;
+  char buffer[16];
+  size_t bytes_read;
+
+  /* invalid arguments */
+  fail_unless(zathura_attachment_reader_new(NULL, NULL)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_reader_new(NULL, attachment) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_reader_new(&reader, NULL)    == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_reader_free(NULL)            == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* read function */
+  fail_unless(zathura_attachment_set_read_function(attachment, attachment_read_function, 8) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_attachment_reader_new(&reader, attachment) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_attachment_reader_read(NULL, buffer, sizeof(buffer), &bytes_read) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_reader_read(reader, NULL, sizeof(buffer), &bytes_read) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_attachment_reader_read(reader, buffer, sizeof(buffer), NULL)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  size_t offset = 0;
+  do {
+    fail_unless(zathura_attachment_reader_read(reader, buffer + offset, sizeof(buffer) - offset, &bytes_read) == ZATHURA_ERROR_OK);
+    offset += bytes_read;
+  } while (bytes_read > 0);
+
+  fail_unless(offset == 8);
+  fail_unless(memcmp(buffer, "01234567", 8) == 0);
+  fail_unless(zathura_attachment_reader_free(reader) == ZATHURA_ERROR_OK);
+
+  /* file range */
+  char* path = create_data_file();
+  fail_unless(zathura_attachment_set_data_file(attachment, path, 3, 5) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_attachment_reader_new(&reader, attachment) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_attachment_reader_read(reader, buffer, sizeof(buffer), &bytes_read) == ZATHURA_ERROR_OK);
+  fail_unless(bytes_read == 5);
+  fail_unless(memcmp(buffer, "34567", 5) == 0);
+  fail_unless(zathura_attachment_reader_read(reader, buffer, sizeof(buffer), &bytes_read) == ZATHURA_ERROR_OK);
+  fail_unless(bytes_read == 0);
+  fail_unless(zathura_attachment_reader_free(reader) == ZATHURA_ERROR_OK);
+
+  unlink(path);
+  free(path);
+} END_TEST
+
 START_TEST(test_attachment_set_creation_time) {
   time_t creation_time = time(NULL);
 
@@ -260,6 +418,34 @@ START_TEST(test_attachment_save) {
   fail_unless(zathura_attachment_save(attachment, "")   == ZATHURA_ERROR_INVALID_ARGUMENTS);
 } END_TEST
 
+START_TEST(test_attachment_save_data) {
+  char* source = create_data_file();
+  char* path   = create_data_file();
+
+  /* copied data */
+  fail_unless(zathura_attachment_set_data(attachment, "data", 4) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_attachment_save(attachment, path) == ZATHURA_ERROR_OK);
+  check_file_contents(path, "data");
+
+  /* file range */
+  fail_unless(zathura_attachment_set_data_file(attachment, source, 2, 4) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_attachment_save(attachment, path) == ZATHURA_ERROR_OK);
+  check_file_contents(path, "2345");
+
+  /* read function */
+  fail_unless(zathura_attachment_set_read_function(attachment, attachment_read_function, 12) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_attachment_save(attachment, path) == ZATHURA_ERROR_OK);
+  check_file_contents(path, FILE_DATA "01");
+
+  /* invalid path */
+  fail_unless(zathura_attachment_save(attachment, "/nonexistent/attachment") == ZATHURA_ERROR_UNKNOWN);
+
+  unlink(source);
+  unlink(path);
+  free(source);
+  free(path);
+} END_TEST
+
 START_TEST(test_attachment_set_user_data) {
   void* user_data;
 
@@ -330,6 +516,9 @@ create_suite(void)
   tcase_add_test(tcase, test_attachment_set_data);
   tcase_add_test(tcase, test_attachment_get_data);
   tcase_add_test(tcase, test_attachment_get_size);
+  tcase_add_test(tcase, test_attachment_set_data_borrowed);
+  tcase_add_test(tcase, test_attachment_set_data_file);
+  tcase_add_test(tcase, test_attachment_set_read_function);
   tcase_add_test(tcase, test_attachment_set_creation_time);
   tcase_add_test(tcase, test_attachment_get_creation_time);
   tcase_add_test(tcase, test_attachment_set_modification_time);
@@ -339,6 +528,12 @@ create_suite(void)
   tcase = tcase_create("save");
   tcase_add_checked_fixture(tcase, setup, teardown);
   tcase_add_test(tcase, test_attachment_save);
+  tcase_add_test(tcase, test_attachment_save_data);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("reader");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_attachment_reader);
   suite_add_tcase(suite, tcase);
 
   return suite;
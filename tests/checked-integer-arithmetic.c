@@ -16,6 +16,14 @@ START_TEST(test_checked_integer_arithmetic_umul) {
   fail_unless(checked_umul(UINT_MAX, UINT_MAX, &res) == true);
 } END_TEST
 
+START_TEST(test_checked_integer_arithmetic_uadd) {
+  unsigned int res = 0;
+  fail_unless(checked_uadd(1, 1, &res) == false);
+  fail_unless(res == 2);
+
+  fail_unless(checked_uadd(UINT_MAX, 1, &res) == true);
+} END_TEST
+
 Suite*
 create_suite(void)
 {
@@ -24,6 +32,7 @@ create_suite(void)
 
   tcase = tcase_create("unsigned int");
   tcase_add_test(tcase, test_checked_integer_arithmetic_umul);
+  tcase_add_test(tcase, test_checked_integer_arithmetic_uadd);
   suite_add_tcase(suite, tcase);
 
   return suite;
@@ -5,6 +5,7 @@
 #include <libzathura/document.h>
 #include <libzathura/plugin-manager.h>
 #include <libzathura/plugin-api.h>
+#include <libzathura/internal.h>
 
 #include "tests.h"
 #include "utils.h"
@@ -138,6 +139,59 @@ START_TEST(test_document_get_page) {
   fail_unless(zathura_document_get_page(document, 100, &page) == ZATHURA_ERROR_DOCUMENT_INVALID_INDEX);
 } END_TEST
 
+START_TEST(test_document_get_page_lazy) {
+  zathura_page_t* page;
+  zathura_page_t* other_page;
+  unsigned int index;
+
+  /* pages are not created when the document is opened */
+  for (unsigned int i = 0; i < document->number_of_pages; i++) {
+    fail_unless(document->pages[i] == NULL);
+  }
+
+  /* ... but on first access */
+  fail_unless(zathura_document_get_page(document, 5, &page) == ZATHURA_ERROR_OK);
+  fail_unless(page != NULL);
+  fail_unless(document->pages[5] == page);
+  fail_unless(document->pages[4] == NULL);
+  fail_unless(zathura_page_get_index(page, &index) == ZATHURA_ERROR_OK);
+  fail_unless(index == 5);
+
+  /* subsequent calls return the same page */
+  fail_unless(zathura_document_get_page(document, 5, &other_page) == ZATHURA_ERROR_OK);
+  fail_unless(page == other_page);
+} END_TEST
+
+static gpointer
+get_page_thread(gpointer data)
+{
+  zathura_page_t* page = NULL;
+  if (zathura_document_get_page(document, GPOINTER_TO_UINT(data), &page) != ZATHURA_ERROR_OK) {
+    return NULL;
+  }
+
+  return page;
+}
+
+START_TEST(test_document_get_page_concurrent) {
+  GThread* threads[8];
+
+  /* all threads requesting the same page receive the same object */
+  for (unsigned int i = 0; i < G_N_ELEMENTS(threads); i++) {
+    threads[i] = g_thread_new(NULL, get_page_thread, GUINT_TO_POINTER(3));
+  }
+
+  zathura_page_t* page = NULL;
+  for (unsigned int i = 0; i < G_N_ELEMENTS(threads); i++) {
+    zathura_page_t* thread_page = g_thread_join(threads[i]);
+    fail_unless(thread_page != NULL);
+    fail_unless(page == NULL || page == thread_page);
+    page = thread_page;
+  }
+
+  fail_unless(document->pages[3] == page);
+} END_TEST
+
 START_TEST(test_document_get_page_by_label) {
   zathura_page_t* page;
 
@@ -148,9 +202,37 @@ START_TEST(test_document_get_page_by_label) {
   fail_unless(zathura_document_get_page_by_label(document, "abc", NULL)  == ZATHURA_ERROR_INVALID_ARGUMENTS);
   fail_unless(zathura_document_get_page_by_label(document, "",    &page) == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
+  /* pages before a known page with the label are checked first */
+  zathura_page_t* page_5 = NULL;
+  fail_unless(zathura_document_get_page(document, 5, &page_5) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_set_label(page_5, "abc") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_page_by_label(document, "abc", &page) == ZATHURA_ERROR_OK);
+  fail_unless(page == document->pages[0]);
+  fail_unless(zathura_page_set_label(page_5, "v") == ZATHURA_ERROR_OK);
+
   /* valid arguments */
   fail_unless(zathura_document_get_page_by_label(document, "abc", &page) == ZATHURA_ERROR_OK);
   fail_unless(zathura_document_get_page_by_label(document, "xyz", &page) == ZATHURA_ERROR_DOCUMENT_INVALID_LABEL);
+
+  /* label changes are reflected */
+  zathura_page_t* page_3 = NULL;
+  fail_unless(zathura_document_get_page(document, 3, &page_3) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_set_label(page_3, "xii") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_page_by_label(document, "xii", &page) == ZATHURA_ERROR_OK);
+  fail_unless(page == page_3);
+
+  fail_unless(zathura_page_set_label(page_3, "xiii") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_page_by_label(document, "xii", &page) == ZATHURA_ERROR_DOCUMENT_INVALID_LABEL);
+  fail_unless(zathura_document_get_page_by_label(document, "xiii", &page) == ZATHURA_ERROR_OK);
+  fail_unless(page == page_3);
+
+  /* the first page with a label is returned */
+  fail_unless(zathura_page_set_label(page_3, "abc") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_page_by_label(document, "abc", &page) == ZATHURA_ERROR_OK);
+  fail_unless(page == document->pages[0]);
+  fail_unless(zathura_page_set_label(document->pages[0], "i") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_page_by_label(document, "abc", &page) == ZATHURA_ERROR_OK);
+  fail_unless(page == page_3);
 } END_TEST
 
 START_TEST(test_document_set_page_mode) {
@@ -249,6 +331,96 @@ START_TEST(test_document_get_permissions) {
   fail_unless(zathura_document_get_permissions(document, &permissions) == ZATHURA_ERROR_OK);
 } END_TEST
 
+START_TEST(test_document_get_options) {
+  zathura_options_t* options = NULL;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_document_get_options(NULL,     NULL)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_get_options(document, NULL)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_get_options(NULL,     &options) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_document_get_options(document, &options) == ZATHURA_ERROR_OK);
+  fail_unless(options != NULL);
+
+  unsigned int render_cache_size = 0;
+  fail_unless(zathura_options_get_value_uint(options, "render-cache-size", &render_cache_size) == ZATHURA_ERROR_OK);
+  fail_unless(render_cache_size > 0);
+
+  /* other options do not change the budget of the render cache */
+  zathura_render_cache_statistics_t statistics;
+  fail_unless(zathura_options_add(options, "other", ZATHURA_OPTION_UINT) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_options_set_value_uint(options, "other", 1) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.max_size == render_cache_size);
+} END_TEST
+
+START_TEST(test_document_get_render_cache_statistics) {
+  zathura_render_cache_statistics_t statistics;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_document_get_render_cache_statistics(NULL,     NULL)        == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_get_render_cache_statistics(document, NULL)        == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_get_render_cache_statistics(NULL,     &statistics) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.hits == 0);
+  fail_unless(statistics.misses == 0);
+  fail_unless(statistics.number_of_entries == 0);
+  fail_unless(statistics.size == 0);
+} END_TEST
+
+START_TEST(test_document_get_page_geometry) {
+  const zathura_page_geometry_t* geometry = NULL;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_document_get_page_geometry(NULL,     NULL)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_get_page_geometry(document, NULL)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_get_page_geometry(NULL,     &geometry) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_document_get_page_geometry(document, &geometry) == ZATHURA_ERROR_OK);
+  fail_unless(geometry != NULL);
+  fail_unless(geometry->number_of_pages == 10);
+  for (unsigned int i = 0; i < geometry->number_of_pages; i++) {
+    fail_unless(geometry->width[i] == 600);
+    fail_unless(geometry->height[i] == 800);
+    fail_unless(geometry->crop_box[i].p2.x == 600);
+    fail_unless(geometry->crop_box[i].p2.y == 800);
+  }
+
+  /* pages are not initialized */
+  for (unsigned int i = 0; i < geometry->number_of_pages; i++) {
+    fail_unless(document->pages[i] == NULL);
+  }
+
+  /* the geometry follows changes of the pages */
+  zathura_page_t* page = NULL;
+  fail_unless(zathura_document_get_page(document, 2, &page) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_set_width(page, 300) == ZATHURA_ERROR_OK);
+  fail_unless(geometry->width[2] == 300);
+
+  const zathura_page_geometry_t* geometry_2 = NULL;
+  fail_unless(zathura_document_get_page_geometry(document, &geometry_2) == ZATHURA_ERROR_OK);
+  fail_unless(geometry_2 == geometry);
+} END_TEST
+
+START_TEST(test_document_get_page_geometry_fallback) {
+  const zathura_page_geometry_t* geometry = NULL;
+
+  document->plugin->functions.document_get_page_geometry = NULL;
+
+  /* pages are initialized to query their geometry */
+  fail_unless(zathura_document_get_page_geometry(document, &geometry) == ZATHURA_ERROR_OK);
+  fail_unless(geometry->number_of_pages == 10);
+  for (unsigned int i = 0; i < geometry->number_of_pages; i++) {
+    fail_unless(document->pages[i] != NULL);
+    fail_unless(geometry->width[i] == 600);
+    fail_unless(geometry->height[i] == 800);
+  }
+} END_TEST
+
 Suite*
 create_suite(void)
 {
@@ -270,6 +442,14 @@ create_suite(void)
   tcase_add_test(tcase, test_document_get_page_layout);
   tcase_add_test(tcase, test_document_set_permissions);
   tcase_add_test(tcase, test_document_get_permissions);
+  tcase_add_test(tcase, test_document_get_options);
+  tcase_add_test(tcase, test_document_get_render_cache_statistics);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("geometry");
+  tcase_add_checked_fixture(tcase, setup_document, teardown_document);
+  tcase_add_test(tcase, test_document_get_page_geometry);
+  tcase_add_test(tcase, test_document_get_page_geometry_fallback);
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("save-as");
@@ -280,6 +460,8 @@ create_suite(void)
   tcase = tcase_create("pages");
   tcase_add_checked_fixture(tcase, setup_document, teardown_document);
   tcase_add_test(tcase, test_document_get_page);
+  tcase_add_test(tcase, test_document_get_page_lazy);
+  tcase_add_test(tcase, test_document_get_page_concurrent);
   tcase_add_test(tcase, test_document_get_page_by_label);
   suite_add_tcase(suite, tcase);
 
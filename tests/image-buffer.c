@@ -3,6 +3,7 @@
 #include <check.h>
 #include <fiu.h>
 #include <fiu-control.h>
+#include <stdint.h>
 
 #include <libzathura/image-buffer.h>
 #include <libzathura/plugin-api/image-buffer.h>
@@ -108,7 +109,7 @@ START_TEST(test_image_buffer_get_height) {
 
 START_TEST(test_image_buffer_set_rowstride) {
   zathura_image_buffer_t* buffer;
-  unsigned int rowstride = ZATHURA_IMAGE_BUFFER_ROWSTRIDE;
+  unsigned int rowstride = 3;
 
   /* invalid arguments  */
   fail_unless(zathura_image_buffer_set_rowstride(NULL, rowstride) == ZATHURA_ERROR_INVALID_ARGUMENTS);
@@ -116,10 +117,14 @@ START_TEST(test_image_buffer_set_rowstride) {
   /* setup */
   fail_unless(zathura_image_buffer_new(&buffer, 1, 1) == ZATHURA_ERROR_OK);
 
+  /* rows do not hold all pixels or exceed the data */
+  fail_unless(zathura_image_buffer_set_rowstride(buffer, 2) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_set_rowstride(buffer, ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT + 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
   /* valid arguments  */
   fail_unless(zathura_image_buffer_set_rowstride(buffer, rowstride) == ZATHURA_ERROR_OK);
   fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
-  fail_unless(rowstride == ZATHURA_IMAGE_BUFFER_ROWSTRIDE);
+  fail_unless(rowstride == 3);
 
   /* clean-up */
   fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
@@ -138,10 +143,161 @@ START_TEST(test_image_buffer_get_rowstride) {
 
   /* valid arguments  */
   fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
-  fail_unless(rowstride == ZATHURA_IMAGE_BUFFER_ROWSTRIDE);
+  fail_unless(rowstride == ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  /* rows are padded to the alignment */
+  fail_unless(zathura_image_buffer_new(&buffer, 22, 1) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  fail_unless(rowstride == 2 * ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT);
   fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
 } END_TEST
 
+START_TEST(test_image_buffer_new_with_format) {
+  zathura_image_buffer_t* buffer;
+  unsigned char* data;
+  unsigned int rowstride;
+  zathura_image_buffer_format_t format;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_image_buffer_new_with_format(NULL,    1, 1, ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_with_format(&buffer, 0, 1, ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_with_format(&buffer, 1, 0, ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_with_format(&buffer, 1, 1, 0xFF) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* invalid integers */
+  fail_unless(zathura_image_buffer_new_with_format(&buffer, 0xFFFFFFFFUL, 1, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_with_format(&buffer, 0xFFFFFFFUL, 0xFFFFFFFUL, ZATHURA_IMAGE_BUFFER_FORMAT_MONO1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  const struct {
+    zathura_image_buffer_format_t format;
+    unsigned int rowstride;
+  } formats[] = {
+    { ZATHURA_IMAGE_BUFFER_FORMAT_RGB24,                 192 },
+    { ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32,                256 },
+    { ZATHURA_IMAGE_BUFFER_FORMAT_ARGB32_PREMULTIPLIED,  256 },
+    { ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8,                 64  },
+    { ZATHURA_IMAGE_BUFFER_FORMAT_MONO1,                 64  },
+  };
+
+  /* valid arguments */
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+    fail_unless(zathura_image_buffer_new_with_format(&buffer, 64, 2, formats[i].format) == ZATHURA_ERROR_OK);
+    fail_unless(zathura_image_buffer_get_format(buffer, &format) == ZATHURA_ERROR_OK);
+    fail_unless(format == formats[i].format);
+    fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+    fail_unless(rowstride == formats[i].rowstride);
+    fail_unless(zathura_image_buffer_get_data(buffer, &data) == ZATHURA_ERROR_OK);
+    fail_unless(((uintptr_t) data) % ZATHURA_IMAGE_BUFFER_ROW_ALIGNMENT == 0);
+    fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+  }
+} END_TEST
+
+START_TEST(test_image_buffer_get_format) {
+  zathura_image_buffer_t* buffer;
+  zathura_image_buffer_format_t format;
+
+  /* invalid arguments  */
+  fail_unless(zathura_image_buffer_get_format(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_get_format(NULL, &format) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  fail_unless(zathura_image_buffer_new(&buffer, 1, 1) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_format(buffer, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments  */
+  fail_unless(zathura_image_buffer_get_format(buffer, &format) == ZATHURA_ERROR_OK);
+  fail_unless(format == ZATHURA_IMAGE_BUFFER_FORMAT_RGB24);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+} END_TEST
+
+static void
+cb_destroy_data(void* data)
+{
+  unsigned int* counter = data;
+  (*counter)++;
+}
+
+START_TEST(test_image_buffer_new_from_data) {
+  zathura_image_buffer_t* buffer;
+  unsigned char data[4 * 10 * 2];
+  unsigned char* buffer_data = NULL;
+  unsigned int rowstride     = 0;
+  unsigned int counter       = 0;
+
+  /* invalid arguments */
+  fail_unless(zathura_image_buffer_new_from_data(NULL, data, 10, 2, 40, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_from_data(&buffer, NULL, 10, 2, 40, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_from_data(&buffer, data, 0, 2, 40, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_from_data(&buffer, data, 10, 0, 40, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_new_from_data(&buffer, data, 10, 2, 39, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_image_buffer_new_from_data(&buffer, data, 10, 2, 40, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32, cb_destroy_data, &counter) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_data(buffer, &buffer_data) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_data == data);
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  fail_unless(rowstride == 40);
+
+  /* data is released with the last reference */
+  fail_unless(zathura_image_buffer_ref(buffer) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+  fail_unless(counter == 0);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+  fail_unless(counter == 1);
+} END_TEST
+
+START_TEST(test_image_buffer_pool_new) {
+  zathura_image_buffer_pool_t* pool;
+
+  /* invalid arguments */
+  fail_unless(zathura_image_buffer_pool_new(NULL, 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_pool_free(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_image_buffer_pool_new(&pool, 1) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_pool_free(pool) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_image_buffer_pool_acquire) {
+  zathura_image_buffer_pool_t* pool;
+  zathura_image_buffer_t* buffer;
+  zathura_image_buffer_t* buffer_2;
+  zathura_image_buffer_t* buffer_3;
+
+  fail_unless(zathura_image_buffer_pool_new(&pool, 1) == ZATHURA_ERROR_OK);
+
+  /* invalid arguments */
+  fail_unless(zathura_image_buffer_pool_acquire(NULL, &buffer, 1, 1, ZATHURA_IMAGE_BUFFER_FORMAT_RGB24) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_pool_acquire(pool, NULL, 1, 1, ZATHURA_IMAGE_BUFFER_FORMAT_RGB24) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_pool_acquire(pool, &buffer, 0, 1, ZATHURA_IMAGE_BUFFER_FORMAT_RGB24) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* released buffers are reused */
+  unsigned int rowstride   = 0;
+  unsigned int rowstride_2 = 0;
+  fail_unless(zathura_image_buffer_pool_acquire(pool, &buffer, 10, 10, ZATHURA_IMAGE_BUFFER_FORMAT_RGB24) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_set_rowstride(buffer, 30) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_pool_acquire(pool, &buffer_2, 10, 10, ZATHURA_IMAGE_BUFFER_FORMAT_RGB24) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_2 == buffer);
+
+  /* with the rowstride they have been created with */
+  fail_unless(zathura_image_buffer_get_rowstride(buffer_2, &rowstride_2) == ZATHURA_ERROR_OK);
+  fail_unless(rowstride_2 == rowstride);
+
+  /* buffers in use or with other dimensions are not */
+  fail_unless(zathura_image_buffer_pool_acquire(pool, &buffer_3, 10, 10, ZATHURA_IMAGE_BUFFER_FORMAT_RGB24) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_3 != buffer_2);
+  fail_unless(zathura_image_buffer_free(buffer_3) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_pool_acquire(pool, &buffer_3, 10, 10, ZATHURA_IMAGE_BUFFER_FORMAT_GRAY8) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_3 != buffer_2);
+  fail_unless(zathura_image_buffer_free(buffer_3) == ZATHURA_ERROR_OK);
+
+  /* buffers in use survive the pool */
+  fail_unless(zathura_image_buffer_pool_free(pool) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer_2) == ZATHURA_ERROR_OK);
+} END_TEST
+
 Suite*
 create_suite(void)
 {
@@ -156,6 +312,14 @@ create_suite(void)
   tcase_add_test(tcase, test_image_buffer_get_height);
   tcase_add_test(tcase, test_image_buffer_set_rowstride);
   tcase_add_test(tcase, test_image_buffer_get_rowstride);
+  tcase_add_test(tcase, test_image_buffer_new_with_format);
+  tcase_add_test(tcase, test_image_buffer_get_format);
+  tcase_add_test(tcase, test_image_buffer_new_from_data);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("pool");
+  tcase_add_test(tcase, test_image_buffer_pool_new);
+  tcase_add_test(tcase, test_image_buffer_pool_acquire);
   suite_add_tcase(suite, tcase);
 
   return suite;
@@ -11,11 +11,6 @@
 
 #include "tests.h"
 
-/* forward declarations */
-char* guess_type_magic(const char* path);
-char* guess_type_file(const char* path);
-char* guess_type_glib(const char* path);
-
 START_TEST(test_zathura_realpath) {
   char* real_path;
 
@@ -38,61 +33,23 @@ START_TEST(test_zathura_realpath) {
 #endif
 } END_TEST
 
-START_TEST(test_zathura_guess_type) {
+START_TEST(test_zathura_guess_type_data_fallback) {
+  const char data[] = "plain text";
   char* type;
 
   /* basic invalid arguments */
-  fail_unless(zathura_guess_type(NULL, NULL)  == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_guess_type(NULL, &type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_guess_type("",   NULL)  == ZATHURA_ERROR_INVALID_ARGUMENTS);
-  fail_unless(zathura_guess_type("a",  NULL)  == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_guess_type_data_fallback(NULL, 0, NULL)                 == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_guess_type_data_fallback(NULL, sizeof(data), &type)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_guess_type_data_fallback(data, 0, &type)                == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_guess_type_data_fallback(data, sizeof(data) - 1, NULL)  == ZATHURA_ERROR_INVALID_ARGUMENTS);
 
   /* valid arguments */
-  fail_unless(zathura_guess_type("files/empty.pdf", &type) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_guess_type_data_fallback(data, sizeof(data) - 1, &type) == ZATHURA_ERROR_OK);
   fail_unless(type != NULL);
-  fail_unless(strcmp(type, "application/pdf") == 0);
-  free(type);
-} END_TEST
-
-START_TEST(test_zathura_guess_type_glib) {
-  /* basic invalid arguments */
-  fail_unless(guess_type_glib(NULL) == NULL);
-  fail_unless(guess_type_glib("")   == NULL);
-  fail_unless(guess_type_glib("a")  == NULL);
-
-  /* valid arguments */
-  char* content_type = guess_type_glib("files/empty.pdf");
-  fail_unless(content_type != NULL);
-  fail_unless(strcmp(content_type, "application/pdf") == 0);
-  g_free(content_type);
-} END_TEST
-
-START_TEST(test_zathura_guess_type_file) {
-  /* basic invalid arguments */
-  fail_unless(guess_type_file(NULL) == NULL);
-  fail_unless(guess_type_file("")   == NULL);
-
-  /* valid arguments */
-  char* content_type = guess_type_file("files/empty.pdf");
-  fail_unless(content_type != NULL);
-  fail_unless(strcmp(content_type, "application/pdf") == 0);
-  g_free(content_type);
+  fail_unless(strcmp(type, "text/plain") == 0);
+  g_free(type);
 } END_TEST
 
-#ifdef WITH_MAGIC
-START_TEST(test_zathura_guess_type_magic) {
-  /* basic invalid arguments */
-  fail_unless(guess_type_magic(NULL) == NULL);
-  fail_unless(guess_type_magic("")   == NULL);
-
-  /* valid arguments */
-  char* content_type = guess_type_magic("files/empty.pdf");
-  fail_unless(content_type != NULL);
-  fail_unless(strcmp(content_type, "application/pdf") == 0);
-  g_free(content_type);
-} END_TEST
-#endif
-
 Suite*
 create_suite(void)
 {
@@ -104,12 +61,7 @@ create_suite(void)
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("zathura_guess_type");
-  tcase_add_test(tcase, test_zathura_guess_type);
-  tcase_add_test(tcase, test_zathura_guess_type_glib);
-  tcase_add_test(tcase, test_zathura_guess_type_file);
-#ifdef WITH_MAGIC
-  tcase_add_test(tcase, test_zathura_guess_type_magic);
-#endif
+  tcase_add_test(tcase, test_zathura_guess_type_data_fallback);
   suite_add_tcase(suite, tcase);
 
   return suite;
@@ -3,8 +3,12 @@
 #include <check.h>
 #include <fiu.h>
 #include <fiu-control.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include <libzathura/macros.h>
 #include <libzathura/page.h>
+#include <libzathura/annotations.h>
 #include <libzathura/form-fields.h>
 #include <libzathura/plugin-manager.h>
 #include <libzathura/plugin-api.h>
@@ -393,6 +397,8 @@ START_TEST(test_page_get_text) {
 
   /* valid arguments */
   fail_unless(zathura_page_get_text(page, &text) == ZATHURA_ERROR_OK);
+  fail_unless(text != NULL);
+  free(text);
 } END_TEST
 
 START_TEST(test_page_get_selected_text) {
@@ -406,10 +412,101 @@ START_TEST(test_page_get_selected_text) {
 
   /* valid arguments */
   fail_unless(zathura_page_get_selected_text(page, &text, rectangle) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(text, "") == 0);
+  free(text);
+
+  /* characters are selected if their center lies within the rectangle */
+  rectangle = (zathura_rectangle_t) { {0, 0}, {24, 20} };
+  fail_unless(zathura_page_get_selected_text(page, &text, rectangle) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(text, "Pa") == 0);
+  free(text);
+} END_TEST
+
+START_TEST(test_page_get_glyphs) {
+  const zathura_glyph_t* glyphs = NULL;
+  const zathura_glyph_t* other_glyphs = NULL;
+  size_t number_of_glyphs = 0;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_glyphs(NULL, NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyphs(page, NULL, &number_of_glyphs) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyphs(page, &glyphs, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_page_get_glyphs(page, &glyphs, &number_of_glyphs) == ZATHURA_ERROR_OK);
+  fail_unless(number_of_glyphs == 6);
+  fail_unless(glyphs[0].codepoint == 'P');
+  fail_unless(glyphs[5].codepoint == '0');
+  fail_unless(glyphs[5].position.p1.x == 50);
+
+  /* the characters are kept with the page */
+  fail_unless(zathura_page_get_glyphs(page, &other_glyphs, &number_of_glyphs) == ZATHURA_ERROR_OK);
+  fail_unless(other_glyphs == glyphs);
+} END_TEST
+
+START_TEST(test_page_get_glyph_at) {
+  size_t index = 0;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_glyph_at(NULL, (zathura_point_t) {0, 0}, &index) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_at(page, (zathura_point_t) {0, 0}, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_page_get_glyph_at(page, (zathura_point_t) {35, 5}, &index) == ZATHURA_ERROR_OK);
+  fail_unless(index == 3);
+  fail_unless(zathura_page_get_glyph_at(page, (zathura_point_t) {35, 25}, &index) == ZATHURA_ERROR_SEARCH_NO_RESULTS);
+} END_TEST
+
+START_TEST(test_page_get_glyph_text) {
+  zathura_page_t* other_page = NULL;
+  char* text = NULL;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_glyph_text(NULL, 0, 0, &text) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_text(page, 0, 0, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_text(page, 1, 0, &text) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_text(page, 0, 6, &text) == ZATHURA_ERROR_DOCUMENT_INVALID_INDEX);
+
+  /* valid arguments */
+  fail_unless(zathura_page_get_glyph_text(page, 1, 3, &text) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(text, "age") == 0);
+  free(text);
+
+  /* lines are separated by line breaks */
+  fail_unless(zathura_document_get_page(document, 2, &other_page) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_get_glyph_text(other_page, 4, 12, &text) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(text, " 2\n  Match") == 0);
+  free(text);
+} END_TEST
+
+START_TEST(test_page_get_glyph_rectangles) {
+  zathura_page_t* other_page = NULL;
+  zathura_list_t* rectangles = NULL;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_glyph_rectangles(NULL, 0, 0, &rectangles) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_rectangles(page, 0, 0, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_rectangles(page, 1, 0, &rectangles) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_glyph_rectangles(page, 0, 6, &rectangles) == ZATHURA_ERROR_DOCUMENT_INVALID_INDEX);
+
+  /* one rectangle per line */
+  fail_unless(zathura_document_get_page(document, 2, &other_page) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_get_glyph_rectangles(other_page, 4, 12, &rectangles) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(rectangles) == 2);
+
+  zathura_rectangle_t* first = zathura_list_nth_data(rectangles, 0);
+  fail_unless(first->p1.x == 40 && first->p1.y == 0);
+  fail_unless(first->p2.x == 60 && first->p2.y == 20);
+
+  zathura_rectangle_t* second = zathura_list_nth_data(rectangles, 1);
+  fail_unless(second->p1.x == 0 && second->p1.y == 20);
+  fail_unless(second->p2.x == 70 && second->p2.y == 40);
+
+  zathura_list_free_full(rectangles, free);
 } END_TEST
 
 START_TEST(test_page_get_links) {
-  zathura_list_t* links;;
+  zathura_page_objects_t* links;;
 
   /* basic invalid arguments */
   fail_unless(zathura_page_get_links(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
@@ -418,10 +515,155 @@ START_TEST(test_page_get_links) {
 
   /* valid arguments */
   fail_unless(zathura_page_get_links(page, &links) == ZATHURA_ERROR_OK);
+
+  zathura_list_t* mappings;
+  fail_unless(zathura_page_objects_get_mappings(links, &mappings) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(mappings) == 101);
+  fail_unless(zathura_page_objects_unref(links) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_objects_cache) {
+  zathura_page_objects_t* links;
+  zathura_page_objects_t* links2;
+  zathura_list_t* mappings;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_objects_get_mappings(NULL, NULL)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_objects_get_mappings(NULL, &mappings) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_objects_ref(NULL)                     == NULL);
+  fail_unless(zathura_page_objects_unref(NULL)                   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_objects_changed(NULL, ZATHURA_PAGE_OBJECT_LINKS) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the links are fetched once */
+  fail_unless(zathura_page_get_links(page, &links)  == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_get_links(page, &links2) == ZATHURA_ERROR_OK);
+  fail_unless(links == links2);
+  fail_unless(zathura_page_objects_unref(links2) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_page_objects_ref(links) == links);
+  fail_unless(zathura_page_objects_unref(links) == ZATHURA_ERROR_OK);
+
+  /* other types of objects are kept */
+  fail_unless(zathura_page_objects_changed(page, ZATHURA_PAGE_OBJECT_ANNOTATIONS) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_get_links(page, &links2) == ZATHURA_ERROR_OK);
+  fail_unless(links == links2);
+  fail_unless(zathura_page_objects_unref(links2) == ZATHURA_ERROR_OK);
+
+  /* changed links are fetched again, references stay valid */
+  fail_unless(zathura_page_objects_changed(page, ZATHURA_PAGE_OBJECT_LINKS) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_get_links(page, &links2) == ZATHURA_ERROR_OK);
+  fail_unless(links != links2);
+
+  fail_unless(zathura_page_objects_get_mappings(links, &mappings) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(mappings) == 101);
+
+  /* actions of the links live as long as the links */
+  zathura_link_mapping_t* mapping = zathura_list_nth_data(mappings, 0);
+  zathura_action_type_t action_type;
+  fail_unless(zathura_action_get_type(mapping->action, &action_type) == ZATHURA_ERROR_OK);
+  fail_unless(action_type == ZATHURA_ACTION_GOTO);
+
+  fail_unless(zathura_page_objects_unref(links)  == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_objects_unref(links2) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_get_links_at) {
+  zathura_list_t* links;
+  zathura_page_objects_t* objects;
+  zathura_point_t point = { 30, 40 };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_links_at(NULL, point, NULL, NULL)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_links_at(page, point, NULL, &objects)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_links_at(page, point, &links, NULL)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_links_at(NULL, point, &links, &objects) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the link of the grid and the link covering the page */
+  fail_unless(zathura_page_get_links_at(page, point, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(links) == 2);
+
+  zathura_link_mapping_t* first = zathura_list_nth_data(links, 0);
+  zathura_link_mapping_t* last  = zathura_list_nth_data(links, 1);
+  fail_unless(first->position.p1.x == 0 && first->position.p1.y == 0);
+  fail_unless(first->position.p2.x == 60 && first->position.p2.y == 80);
+  fail_unless(last->position.p1.x == 600 && last->position.p1.y == 800);
+  zathura_list_free(links);
+
+  /* the links are kept by the page */
+  zathura_page_objects_t* other_objects;
+  fail_unless(zathura_page_get_links_at(page, point, &links, &other_objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_nth_data(links, 0) == first);
+  fail_unless(other_objects == objects);
+  zathura_list_free(links);
+  fail_unless(zathura_page_objects_unref(other_objects) == ZATHURA_ERROR_OK);
+
+  /* the links stay valid while referenced after the plugin reported a change */
+  fail_unless(zathura_page_objects_changed(page, ZATHURA_PAGE_OBJECT_LINKS) == ZATHURA_ERROR_OK);
+  fail_unless(first->position.p2.x == 60 && first->position.p2.y == 80);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  /* borders belong to all touching links */
+  point = (zathura_point_t) { 60, 80 };
+  fail_unless(zathura_page_get_links_at(page, point, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(links) == 5);
+  zathura_list_free(links);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  point = (zathura_point_t) { 599, 799 };
+  fail_unless(zathura_page_get_links_at(page, point, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(links) == 2);
+  first = zathura_list_nth_data(links, 0);
+  fail_unless(first->position.p1.x == 540 && first->position.p1.y == 720);
+  zathura_list_free(links);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  /* outside of the page */
+  point = (zathura_point_t) { -10, 400 };
+  fail_unless(zathura_page_get_links_at(page, point, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(links == NULL);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_get_links_in_rectangle) {
+  zathura_list_t* links;
+  zathura_page_objects_t* objects;
+  zathura_rectangle_t rectangle = { { 130, 90 }, { 0, 0 } };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_links_in_rectangle(NULL, rectangle, NULL, NULL)       == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_links_in_rectangle(page, rectangle, NULL, &objects)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_links_in_rectangle(page, rectangle, &links, NULL)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_links_in_rectangle(NULL, rectangle, &links, &objects) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* 3x2 links of the grid and the link covering the page */
+  fail_unless(zathura_page_get_links_in_rectangle(page, rectangle, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(links) == 7);
+
+  const float columns[] = { 0, 60, 120, 0, 60, 120 };
+  for (unsigned int i = 0; i < 6; i++) {
+    zathura_link_mapping_t* link = zathura_list_nth_data(links, i);
+    fail_unless(link->position.p1.x == columns[i]);
+    fail_unless(link->position.p1.y == (i < 3 ? 0 : 80));
+  }
+  zathura_list_free(links);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  /* the whole page */
+  rectangle = (zathura_rectangle_t) { { 0, 0 }, { 600, 800 } };
+  fail_unless(zathura_page_get_links_in_rectangle(page, rectangle, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(links) == 101);
+  zathura_list_free(links);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  /* outside of the page */
+  rectangle = (zathura_rectangle_t) { { 700, 900 }, { 800, 1000 } };
+  fail_unless(zathura_page_get_links_in_rectangle(page, rectangle, &links, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(links == NULL);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
 } END_TEST
 
 START_TEST(test_page_get_form_fields) {
-  zathura_list_t* form_fields;
+  zathura_page_objects_t* form_fields;
 
   /* basic invalid arguments */
   fail_unless(zathura_page_get_form_fields(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
@@ -430,6 +672,32 @@ START_TEST(test_page_get_form_fields) {
 
   /* valid arguments */
   fail_unless(zathura_page_get_form_fields(page, &form_fields) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_objects_unref(form_fields) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_get_form_fields_at) {
+  zathura_list_t* form_fields;
+  zathura_page_objects_t* objects;
+  zathura_point_t point = { 30, 40 };
+  zathura_rectangle_t rectangle = { { 0, 0 }, { 600, 800 } };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_form_fields_at(NULL, point, NULL, NULL)                         == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_at(page, point, NULL, &objects)                     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_at(page, point, &form_fields, NULL)                 == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_at(NULL, point, &form_fields, &objects)             == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_in_rectangle(NULL, rectangle, NULL, NULL)             == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_in_rectangle(page, rectangle, NULL, &objects)         == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_in_rectangle(page, rectangle, &form_fields, NULL)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_form_fields_in_rectangle(NULL, rectangle, &form_fields, &objects) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the page has no form fields */
+  fail_unless(zathura_page_get_form_fields_at(page, point, &form_fields, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(form_fields == NULL);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_get_form_fields_in_rectangle(page, rectangle, &form_fields, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(form_fields == NULL);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
 } END_TEST
 
 START_TEST(test_page_get_images) {
@@ -459,7 +727,7 @@ START_TEST(test_page_search_text) {
 } END_TEST
 
 START_TEST(test_page_get_annotations) {
-  zathura_list_t* annotations;
+  zathura_page_objects_t* annotations;
 
   /* basic invalid arguments */
   fail_unless(zathura_page_get_annotations(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
@@ -468,6 +736,112 @@ START_TEST(test_page_get_annotations) {
 
   /* valid arguments */
   fail_unless(zathura_page_get_annotations(page, &annotations) == ZATHURA_ERROR_OK);
+
+  zathura_list_t* mappings;
+  fail_unless(zathura_page_objects_get_mappings(annotations, &mappings) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(mappings) == 2);
+  fail_unless(zathura_page_objects_unref(annotations) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_get_annotations_at) {
+  zathura_list_t* annotations;
+  zathura_page_objects_t* objects;
+  zathura_point_t point = { 30, 40 };
+  zathura_rectangle_t rectangle = { { 0, 0 }, { 600, 800 } };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_get_annotations_at(NULL, point, NULL, NULL)                         == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_at(page, point, NULL, &objects)                     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_at(page, point, &annotations, NULL)                 == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_at(NULL, point, &annotations, &objects)             == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_in_rectangle(NULL, rectangle, NULL, NULL)             == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_in_rectangle(page, rectangle, NULL, &objects)         == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_in_rectangle(page, rectangle, &annotations, NULL)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_get_annotations_in_rectangle(NULL, rectangle, &annotations, &objects) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* no annotation at the point */
+  fail_unless(zathura_page_get_annotations_at(page, point, &annotations, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(annotations == NULL);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  point = (zathura_point_t) { 5, 5 };
+  fail_unless(zathura_page_get_annotations_at(page, point, &annotations, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(annotations) == 1);
+  zathura_list_free(annotations);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+
+  /* hidden annotations are reported as well */
+  fail_unless(zathura_page_get_annotations_in_rectangle(page, rectangle, &annotations, &objects) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(annotations) == 2);
+  zathura_list_free(annotations);
+  fail_unless(zathura_page_objects_unref(objects) == ZATHURA_ERROR_OK);
+} END_TEST
+
+static unsigned char
+buffer_green(zathura_image_buffer_t* buffer, unsigned int x, unsigned int y)
+{
+  unsigned char* data;
+  unsigned int rowstride;
+
+  zathura_image_buffer_get_data(buffer, &data);
+  zathura_image_buffer_get_rowstride(buffer, &rowstride);
+
+  return data[y * rowstride + 3 * x + 1];
+}
+
+static void
+buffer_clear(zathura_image_buffer_t* buffer)
+{
+  unsigned char* data;
+  unsigned int rowstride;
+  unsigned int height;
+
+  zathura_image_buffer_get_data(buffer, &data);
+  zathura_image_buffer_get_rowstride(buffer, &rowstride);
+  zathura_image_buffer_get_height(buffer, &height);
+
+  memset(data, 0xFF, rowstride * height);
+}
+
+START_TEST(test_page_render_annotations) {
+  zathura_image_buffer_t* buffer;
+  fail_unless(zathura_image_buffer_new(&buffer, 40, 40) == ZATHURA_ERROR_OK);
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_render_annotations(NULL, NULL, 1.0, 0, 0)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_annotations(page, NULL, 1.0, 0, 0)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_annotations(NULL, buffer, 1.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_annotations(page, buffer, 0.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the half transparent red square is blended onto the white page */
+  buffer_clear(buffer);
+  fail_unless(zathura_page_render_annotations(page, buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+
+  unsigned char* data;
+  unsigned int rowstride;
+  fail_unless(zathura_image_buffer_get_data(buffer, &data) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  fail_unless(data[5 * rowstride + 3 * 5] == 0xFF);
+  fail_unless(abs(buffer_green(buffer, 5, 5) - 0x80) <= 1);
+
+  /* the hidden square and the rest of the page are left untouched */
+  fail_unless(buffer_green(buffer, 25, 25) == 0xFF);
+  fail_unless(buffer_green(buffer, 15, 15) == 0xFF);
+
+  /* the buffer shows a region of the page */
+  buffer_clear(buffer);
+  fail_unless(zathura_page_render_annotations(page, buffer, 1.0, 5, 5) == ZATHURA_ERROR_OK);
+  fail_unless(abs(buffer_green(buffer, 0, 0) - 0x80) <= 1);
+  fail_unless(abs(buffer_green(buffer, 4, 4) - 0x80) <= 1);
+  fail_unless(buffer_green(buffer, 5, 5) == 0xFF);
+
+  /* annotations are scaled with the page */
+  buffer_clear(buffer);
+  fail_unless(zathura_page_render_annotations(page, buffer, 2.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(abs(buffer_green(buffer, 15, 15) - 0x80) <= 1);
+  fail_unless(buffer_green(buffer, 25, 25) == 0xFF);
+
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
 } END_TEST
 
 START_TEST(test_page_render) {
@@ -480,6 +854,330 @@ START_TEST(test_page_render) {
 
   /* valid arguments */
   fail_unless(zathura_page_render(page, &buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(buffer != NULL);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+} END_TEST
+
+static void
+cb_render_job_progress(zathura_render_job_t* job, zathura_image_buffer_t*
+    UNUSED(buffer), zathura_render_quality_t quality, void* data)
+{
+  unsigned int* reports = data;
+  reports[quality]++;
+
+  /* cancel after the preview */
+  if (reports[ZATHURA_RENDER_QUALITY_FINAL] == 0 && reports[ZATHURA_RENDER_QUALITY_PREVIEW] == 2) {
+    zathura_render_job_cancel(job);
+  }
+}
+
+START_TEST(test_page_render_with_job) {
+  zathura_image_buffer_t* buffer = NULL;
+  zathura_render_job_t* job      = NULL;
+  unsigned int reports[2]        = { 0, 0 };
+
+  fail_unless(zathura_render_job_new(&job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_set_progress_callback(job, cb_render_job_progress, reports) == ZATHURA_ERROR_OK);
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_render_with_job(NULL, NULL, 0, 0, 0, NULL)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_with_job(page, NULL, 1.0, 0, 0, job)     == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_with_job(page, &buffer, -1, 0, 0, job)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* preview and final rendering are reported */
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, job) == ZATHURA_ERROR_OK);
+  fail_unless(buffer != NULL);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_PREVIEW] == 1);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_FINAL] == 1);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  /* cached renderings are reported as final right away */
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, job) == ZATHURA_ERROR_OK);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_PREVIEW] == 1);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_FINAL] == 2);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_render_job_free(job) == ZATHURA_ERROR_OK);
+} END_TEST
+
+static zathura_render_job_t* render_job_to_cancel = NULL;
+
+static zathura_error_t
+page_render_cancelling(zathura_page_t* UNUSED(page), zathura_image_buffer_t**
+    buffer, double UNUSED(scale), int UNUSED(rotation), int UNUSED(flags))
+{
+  zathura_render_job_cancel(render_job_to_cancel);
+
+  return zathura_image_buffer_new(buffer, 10, 10);
+}
+
+START_TEST(test_page_render_with_job_cancel) {
+  zathura_image_buffer_t* buffer = NULL;
+  zathura_render_job_t* job      = NULL;
+  unsigned int reports[2]        = { 1, 0 };
+  zathura_render_cache_statistics_t statistics;
+
+  /* job is cancelled by the progress callback after the preview */
+  fail_unless(zathura_render_job_new(&job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_set_progress_callback(job, cb_render_job_progress, reports) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, job) == ZATHURA_ERROR_CANCELLED);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_PREVIEW] == 2);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_FINAL] == 0);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.number_of_entries == 0);
+
+  /* cancelled jobs do not render at all */
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, job) == ZATHURA_ERROR_CANCELLED);
+  fail_unless(reports[ZATHURA_RENDER_QUALITY_PREVIEW] == 2);
+  fail_unless(zathura_render_job_free(job) == ZATHURA_ERROR_OK);
+
+  /* plugins without support for render jobs */
+  document->plugin->functions.page_render_job = NULL;
+
+  fail_unless(zathura_render_job_new(&job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_render_job_cancel(job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render_with_job(page, &buffer, 1.0, 0, 0, job) == ZATHURA_ERROR_CANCELLED);
+  fail_unless(zathura_render_job_free(job) == ZATHURA_ERROR_OK);
+
+  /* jobs cancelled while rendering are not cached */
+  document->plugin->functions.page_render = page_render_cancelling;
+
+  fail_unless(zathura_render_job_new(&render_job_to_cancel) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render_with_job(page, &buffer, 2.0, 0, 0, render_job_to_cancel) == ZATHURA_ERROR_CANCELLED);
+  fail_unless(buffer == NULL);
+  fail_unless(zathura_render_job_free(render_job_to_cancel) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.number_of_entries == 1);
+} END_TEST
+
+START_TEST(test_page_render_region) {
+  zathura_image_buffer_t* buffer = NULL;
+  unsigned int width  = 0;
+  unsigned int height = 0;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_page_render_region(NULL, NULL, 0, 0, 0, 0, 0, 0, 0)          == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, NULL, 1.0, 0, 0, 0, 0, 10, 10)      == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, &buffer, -1, 0, 0, 0, 0, 10, 10)    == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 0, 0, 0, 10)    == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 0, 0, 10, 0)    == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 600, 0, 10, 10) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 0, 800, 10, 10) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_region(page, &buffer, 1e300, 0, 0, 0, 0, 10, 10) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 10, 20, 100, 50) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_width(buffer, &width) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_height(buffer, &height) == ZATHURA_ERROR_OK);
+  fail_unless(width == 100 && height == 50);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  /* region is clipped to the rotated page */
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 90, 0, 700, 500, 200, 200) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_width(buffer, &width) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_height(buffer, &height) == ZATHURA_ERROR_OK);
+  fail_unless(width == 100 && height == 100);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  /* plugins might only implement rendering regions */
+  document->plugin->functions.page_render = NULL;
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 10, 20, 100, 50) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  document->plugin->functions.page_render_region = NULL;
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 10, 20, 100, 50) == ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED);
+} END_TEST
+
+START_TEST(test_page_render_region_fallback) {
+  zathura_image_buffer_t* buffer = NULL;
+  unsigned char* data = NULL;
+  unsigned int width  = 0;
+  unsigned int height = 0;
+  zathura_render_cache_statistics_t statistics;
+
+  document->plugin->functions.page_render_region = NULL;
+
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 550, 700, 100, 50) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_width(buffer, &width) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_height(buffer, &height) == ZATHURA_ERROR_OK);
+  fail_unless(width == 50 && height == 50);
+  fail_unless(zathura_image_buffer_get_data(buffer, &data) == ZATHURA_ERROR_OK);
+  fail_unless(data != NULL);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  /* following regions are cut from the cached page */
+  fail_unless(zathura_page_render_region(page, &buffer, 1.0, 0, 0, 0, 0, 100, 50) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.hits == 1);
+  fail_unless(statistics.misses == 1);
+} END_TEST
+
+START_TEST(test_page_render_into) {
+  zathura_image_buffer_t* buffer = NULL;
+
+  fail_unless(zathura_image_buffer_new(&buffer, 600, 800) == ZATHURA_ERROR_OK);
+
+  /* invalid arguments */
+  fail_unless(zathura_page_render_into(NULL, buffer, 1.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_into(page, NULL, 1.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_into(page, buffer, 0.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_page_render_into(page, buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+
+  /* the buffer has to have the dimensions of the rendered page */
+  fail_unless(zathura_page_render_into(page, buffer, 2.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_into(page, buffer, 0.5, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_into(page, buffer, 1.0, 90, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_render_into(page, buffer, 1e300, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* plugins might only implement rendering into buffers */
+  document->plugin->functions.page_render = NULL;
+  fail_unless(zathura_page_render_into(page, buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+
+  document->plugin->functions.page_render_into = NULL;
+  fail_unless(zathura_page_render_into(page, buffer, 1.0, 0, 0) == ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_render_into_fallback) {
+  zathura_image_buffer_t* buffer = NULL;
+  unsigned char* data = NULL;
+  unsigned int rowstride = 0;
+
+  document->plugin->functions.page_render_into = NULL;
+
+  /* the page is converted to the format of the buffer */
+  fail_unless(zathura_image_buffer_new_with_format(&buffer, 600, 800, ZATHURA_IMAGE_BUFFER_FORMAT_BGRA32) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_data(buffer, &data) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  memset(data, 0x11, rowstride * 800);
+
+  fail_unless(zathura_page_render_into(page, buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(data[0] == 0x00 && data[1] == 0x00 && data[2] == 0x00 && data[3] == 0xFF);
+  fail_unless(data[rowstride * 799 + 4 * 599 + 3] == 0xFF);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  /* larger buffers are not partially overwritten */
+  fail_unless(zathura_image_buffer_new(&buffer, 700, 800) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render_into(page, buffer, 1.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_render_cache) {
+  zathura_image_buffer_t* buffer   = NULL;
+  zathura_image_buffer_t* buffer_2 = NULL;
+  zathura_render_cache_statistics_t statistics;
+
+  /* first rendering is a miss */
+  fail_unless(zathura_page_render(page, &buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.hits == 0);
+  fail_unless(statistics.misses == 1);
+  fail_unless(statistics.number_of_entries == 1);
+  unsigned int rowstride = 0;
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.size == rowstride * 800);
+
+  /* same arguments return the cached buffer */
+  fail_unless(zathura_page_render(page, &buffer_2, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_2 == buffer);
+  fail_unless(zathura_image_buffer_free(buffer_2) == ZATHURA_ERROR_OK);
+
+  /* rotation is normalized */
+  fail_unless(zathura_page_render(page, &buffer_2, 1.0, 360, 0) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_2 == buffer);
+  fail_unless(zathura_image_buffer_free(buffer_2) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.hits == 2);
+  fail_unless(statistics.misses == 1);
+
+  /* different scale is rendered again */
+  fail_unless(zathura_page_render(page, &buffer_2, 0.5, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(buffer_2 != buffer);
+  fail_unless(zathura_image_buffer_free(buffer_2) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.misses == 2);
+  fail_unless(statistics.number_of_entries == 2);
+
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_page_render_cache_size) {
+  zathura_image_buffer_t* buffer = NULL;
+  zathura_options_t* options     = NULL;
+  zathura_render_cache_statistics_t statistics;
+
+  fail_unless(zathura_document_get_options(document, &options) == ZATHURA_ERROR_OK);
+  fail_unless(options != NULL);
+
+  /* budget fits exactly one rendering */
+  unsigned int rowstride = 0;
+  fail_unless(zathura_image_buffer_new(&buffer, 600, 800) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_get_rowstride(buffer, &rowstride) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  const unsigned int size = rowstride * 800;
+  fail_unless(zathura_options_set_value_uint(options, "render-cache-size", size) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_page_render(page, &buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render(page, &buffer, 1.0, 90, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.number_of_entries == 1);
+  fail_unless(statistics.size == size);
+  fail_unless(statistics.max_size == size);
+
+  /* least recently used rendering has been evicted */
+  fail_unless(zathura_page_render(page, &buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.hits == 0);
+  fail_unless(statistics.misses == 3);
+
+  /* disable cache */
+  fail_unless(zathura_options_set_value_uint(options, "render-cache-size", 0) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.number_of_entries == 0);
+  fail_unless(statistics.size == 0);
+} END_TEST
+
+START_TEST(test_page_render_cache_invalidate) {
+  zathura_image_buffer_t* buffer    = NULL;
+  zathura_annotation_t* annotation  = NULL;
+  zathura_render_cache_statistics_t statistics;
+
+  fail_unless(zathura_page_render(page, &buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_annotation_new(page, &annotation, ZATHURA_ANNOTATION_TEXT) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_annotation_set_opacity(annotation, 0.5) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.number_of_entries == 0);
+
+  fail_unless(zathura_page_render(page, &buffer, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &statistics) == ZATHURA_ERROR_OK);
+  fail_unless(statistics.hits == 0);
+  fail_unless(statistics.misses == 2);
+
+  fail_unless(zathura_annotation_free(annotation) == ZATHURA_ERROR_OK);
 } END_TEST
 
 #ifdef HAVE_CAIRO
@@ -530,22 +1228,32 @@ create_suite(void)
   tcase_add_checked_fixture(tcase, setup_page, teardown_page);
   tcase_add_test(tcase, test_page_get_text);
   tcase_add_test(tcase, test_page_get_selected_text);
+  tcase_add_test(tcase, test_page_get_glyphs);
+  tcase_add_test(tcase, test_page_get_glyph_at);
+  tcase_add_test(tcase, test_page_get_glyph_text);
+  tcase_add_test(tcase, test_page_get_glyph_rectangles);
   tcase_add_test(tcase, test_page_search_text);
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("annotations");
   tcase_add_checked_fixture(tcase, setup_page, teardown_page);
   tcase_add_test(tcase, test_page_get_annotations);
+  tcase_add_test(tcase, test_page_get_annotations_at);
+  tcase_add_test(tcase, test_page_render_annotations);
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("links");
   tcase_add_checked_fixture(tcase, setup_page, teardown_page);
   tcase_add_test(tcase, test_page_get_links);
+  tcase_add_test(tcase, test_page_get_links_at);
+  tcase_add_test(tcase, test_page_get_links_in_rectangle);
+  tcase_add_test(tcase, test_page_objects_cache);
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("forms");
   tcase_add_checked_fixture(tcase, setup_page, teardown_page);
   tcase_add_test(tcase, test_page_get_form_fields);
+  tcase_add_test(tcase, test_page_get_form_fields_at);
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("images");
@@ -556,6 +1264,15 @@ create_suite(void)
   tcase = tcase_create("render");
   tcase_add_checked_fixture(tcase, setup_page, teardown_page);
   tcase_add_test(tcase, test_page_render);
+  tcase_add_test(tcase, test_page_render_with_job);
+  tcase_add_test(tcase, test_page_render_with_job_cancel);
+  tcase_add_test(tcase, test_page_render_region);
+  tcase_add_test(tcase, test_page_render_region_fallback);
+  tcase_add_test(tcase, test_page_render_into);
+  tcase_add_test(tcase, test_page_render_into_fallback);
+  tcase_add_test(tcase, test_page_render_cache);
+  tcase_add_test(tcase, test_page_render_cache_size);
+  tcase_add_test(tcase, test_page_render_cache_invalidate);
 #ifdef HAVE_CAIRO
   tcase_add_test(tcase, test_page_render_cairo);
 #endif
@@ -3,7 +3,12 @@
 #include <check.h>
 #include <fiu.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <fiu-control.h>
+#include <glib.h>
 
 #include <libzathura/plugin-manager.h>
 #include <libzathura/internal.h>
@@ -66,6 +71,87 @@ START_TEST(test_plugin_manager_load_dir) {
   fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
 } END_TEST
 
+START_TEST(test_plugin_manager_set_index_file) {
+  zathura_plugin_manager_t* plugin_manager = NULL;
+  zathura_plugin_t* plugin = NULL;
+  zathura_list_t* list = NULL;
+
+  char* index_path = NULL;
+  const int fd = g_file_open_tmp(NULL, &index_path, NULL);
+  fail_unless(fd != -1);
+  close(fd);
+  unlink(index_path);
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_manager_set_index_file(NULL, index_path) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the index is written while the directory is scanned */
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_set_index_file(plugin_manager, "") == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_set_index_file(plugin_manager, index_path) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_get_plugins(plugin_manager, &list) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(list) == 1);
+  plugin = zathura_list_nth_data(list, 0);
+  fail_unless(plugin->handle != NULL);
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(g_file_test(index_path, G_FILE_TEST_EXISTS) == TRUE);
+
+  /* indexed plugins are registered without loading them */
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_set_index_file(plugin_manager, index_path) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_get_plugins(plugin_manager, &list) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(list) == 1);
+  plugin = zathura_list_nth_data(list, 0);
+  fail_unless(plugin->handle == NULL);
+
+  const char* name = NULL;
+  fail_unless(zathura_plugin_get_name(plugin, &name) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(name, "plugin") == 0);
+
+  zathura_plugin_capability_t capabilities = ZATHURA_PLUGIN_CAPABILITY_NONE;
+  fail_unless(zathura_plugin_get_capabilities(plugin, &capabilities) == ZATHURA_ERROR_OK);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_RENDER) != 0);
+  fail_unless(plugin->handle == NULL);
+
+  /* ... until a plugin for one of their mime types is requested */
+  zathura_plugin_t* plugin_2 = NULL;
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin_2, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(plugin_2 == plugin);
+  fail_unless(plugin->handle != NULL);
+  fail_unless(plugin->functions.document_open != NULL);
+
+  zathura_document_t* document = NULL;
+  fail_unless(zathura_plugin_open_document(plugin, &document, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_free(document) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+
+  /* stale entries are replaced */
+  GKeyFile* index = g_key_file_new();
+  fail_unless(g_key_file_load_from_file(index, index_path, G_KEY_FILE_NONE, NULL) == TRUE);
+  char** groups = g_key_file_get_groups(index, NULL);
+  fail_unless(groups != NULL && groups[0] != NULL);
+  for (char** group = groups; *group != NULL; group++) {
+    g_key_file_set_int64(index, *group, "size", -1);
+  }
+  g_strfreev(groups);
+  fail_unless(g_key_file_save_to_file(index, index_path, NULL) == TRUE);
+  g_key_file_free(index);
+
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_set_index_file(plugin_manager, index_path) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_get_plugins(plugin_manager, &list) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(list) == 1);
+  plugin = zathura_list_nth_data(list, 0);
+  fail_unless(plugin->handle != NULL);
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+
+  unlink(index_path);
+  g_free(index_path);
+} END_TEST
+
 START_TEST(test_plugin_manager_get_plugins) {
   zathura_plugin_manager_t* plugin_manager = NULL;
   zathura_list_t* list;
@@ -105,6 +191,17 @@ START_TEST(test_plugin_manager_get_plugin) {
   fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
   fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
   fail_unless(plugin != NULL);
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/unknown") == ZATHURA_ERROR_UNKNOWN);
+
+  /* mime types are case-insensitive */
+  zathura_plugin_t* plugin_2 = NULL;
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin_2, "LibZathura/Test-Plugin") == ZATHURA_ERROR_OK);
+  fail_unless(plugin_2 == plugin);
+
+  /* wildcards */
+  plugin_2 = NULL;
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin_2, "libzathura-test/any") == ZATHURA_ERROR_OK);
+  fail_unless(plugin_2 == plugin);
 
   /* corrupt data */
   zathura_list_t* list;
@@ -119,6 +216,130 @@ START_TEST(test_plugin_manager_get_plugin) {
   fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
 } END_TEST
 
+START_TEST(test_plugin_manager_add_mime_type_alias) {
+  zathura_plugin_manager_t* plugin_manager = NULL;
+  zathura_plugin_t* plugin = NULL;
+  zathura_plugin_t* plugin_2 = NULL;
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(plugin_manager != NULL);
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_manager_add_mime_type_alias(NULL, "a/b", "c/d")         == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_add_mime_type_alias(plugin_manager, NULL, "c/d") == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_add_mime_type_alias(plugin_manager, "", "c/d")   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_add_mime_type_alias(plugin_manager, "a/b", NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_add_mime_type_alias(plugin_manager, "a/b", "")   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin_2, "application/x-test") == ZATHURA_ERROR_UNKNOWN);
+
+  fail_unless(zathura_plugin_manager_add_mime_type_alias(plugin_manager, "application/x-test", "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin_2, "application/x-test") == ZATHURA_ERROR_OK);
+  fail_unless(plugin_2 == plugin);
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_plugin_manager_guess_type) {
+  zathura_plugin_manager_t* plugin_manager = NULL;
+  char* mime_type = NULL;
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(plugin_manager != NULL);
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_manager_guess_type(NULL, TEST_FILE_PATH, &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, NULL, &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, "", &mime_type)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, "DoesNotExist", &mime_type) == ZATHURA_ERROR_UNKNOWN);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, TEST_FILE_PATH, &mime_type) == ZATHURA_ERROR_OK);
+  fail_unless(mime_type != NULL);
+  fail_unless(strcmp(mime_type, "application/pdf") == 0);
+  free(mime_type);
+
+  /* signatures of formats supported by plugins, the header of a PDF file may
+   * be preceded by other data */
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+
+  char* path = NULL;
+  const int fd = g_file_open_tmp(NULL, &path, NULL);
+  fail_unless(fd != -1);
+  close(fd);
+
+  fail_unless(g_file_set_contents(path, "garbage\n%PDF-1.7\n", -1, NULL) == TRUE);
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, path, &mime_type) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(mime_type, "application/pdf") == 0);
+  free(mime_type);
+
+  /* modified files are detected again */
+  fail_unless(g_file_set_contents(path, "plain text", -1, NULL) == TRUE);
+  fail_unless(zathura_plugin_manager_guess_type(plugin_manager, path, &mime_type) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(mime_type, "application/pdf") != 0);
+  free(mime_type);
+
+  unlink(path);
+  g_free(path);
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_plugin_manager_guess_type_from_data) {
+  zathura_plugin_manager_t* plugin_manager = NULL;
+  char* mime_type = NULL;
+  const char* data = "garbage\n%PDF-1.7\n";
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_manager_guess_type_from_data(NULL, data, strlen(data), &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type_from_data(plugin_manager, NULL, strlen(data), &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type_from_data(plugin_manager, data, 0, &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type_from_data(plugin_manager, data, strlen(data), NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_manager_guess_type_from_data(plugin_manager, data, strlen(data), &mime_type) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(mime_type, "application/pdf") == 0);
+  free(mime_type);
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_plugin_manager_guess_type_from_fd) {
+  zathura_plugin_manager_t* plugin_manager = NULL;
+  char* mime_type = NULL;
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_manager_load_dir(plugin_manager, get_plugin_dir_path()) == ZATHURA_ERROR_OK);
+
+  const int fd = open(TEST_FILE_PATH, O_RDONLY);
+  fail_unless(fd != -1);
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_manager_guess_type_from_fd(NULL, fd, &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type_from_fd(plugin_manager, -1, &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_manager_guess_type_from_fd(plugin_manager, fd, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* pipes cannot be inspected without consuming their data */
+  int pipe_fds[2];
+  fail_unless(pipe(pipe_fds) == 0);
+  fail_unless(zathura_plugin_manager_guess_type_from_fd(plugin_manager, pipe_fds[0], &mime_type) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+
+  /* valid parameter, the file offset is left untouched */
+  fail_unless(zathura_plugin_manager_guess_type_from_fd(plugin_manager, fd, &mime_type) == ZATHURA_ERROR_OK);
+  fail_unless(strcmp(mime_type, "application/pdf") == 0);
+  free(mime_type);
+  fail_unless(lseek(fd, 0, SEEK_CUR) == 0);
+
+  close(fd);
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+} END_TEST
+
 Suite*
 create_suite(void)
 {
@@ -136,11 +357,19 @@ create_suite(void)
 
   tcase = tcase_create("load-dir");
   tcase_add_test(tcase, test_plugin_manager_load_dir);
+  tcase_add_test(tcase, test_plugin_manager_set_index_file);
   suite_add_tcase(suite, tcase);
 
   tcase = tcase_create("get-plugin");
   tcase_add_test(tcase, test_plugin_manager_get_plugins);
   tcase_add_test(tcase, test_plugin_manager_get_plugin);
+  tcase_add_test(tcase, test_plugin_manager_add_mime_type_alias);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("guess-type");
+  tcase_add_test(tcase, test_plugin_manager_guess_type);
+  tcase_add_test(tcase, test_plugin_manager_guess_type_from_data);
+  tcase_add_test(tcase, test_plugin_manager_guess_type_from_fd);
   suite_add_tcase(suite, tcase);
 
   return suite;
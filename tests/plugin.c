@@ -3,6 +3,8 @@
 #include <check.h>
 #include <stdio.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <fiu.h>
 #include <fiu-control.h>
 
@@ -112,6 +114,58 @@ START_TEST(test_plugin_get_version) {
   fail_unless(version.rev == 0);
 } END_TEST
 
+START_TEST(test_plugin_set_flags) {
+  zathura_plugin_flag_t flags;
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_set_flags(NULL, ZATHURA_PLUGIN_FLAG_NONE) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_set_flags(plugin, ZATHURA_PLUGIN_FLAG_REENTRANT_RENDER) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_get_flags(plugin, &flags) == ZATHURA_ERROR_OK);
+  fail_unless(flags == ZATHURA_PLUGIN_FLAG_REENTRANT_RENDER);
+} END_TEST
+
+START_TEST(test_plugin_get_flags) {
+  zathura_plugin_flag_t flags;
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_get_flags(NULL,   NULL)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_get_flags(plugin, NULL)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_get_flags(NULL,   &flags) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_get_flags(plugin, &flags) == ZATHURA_ERROR_OK);
+  fail_unless(flags == ZATHURA_PLUGIN_FLAG_NONE);
+} END_TEST
+
+START_TEST(test_plugin_get_capabilities) {
+  zathura_plugin_capability_t capabilities;
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_get_capabilities(NULL,   NULL)          == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_get_capabilities(plugin, NULL)          == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_get_capabilities(NULL,   &capabilities) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_get_capabilities(plugin, &capabilities) == ZATHURA_ERROR_OK);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_OPEN_DATA) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_TEXT) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_GLYPHS) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_SEARCH) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_RENDER) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_RENDER_REGION) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_PAGE_GEOMETRY) != 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_ANNOTATION_RENDER_INTO) != 0);
+
+  /* features without function are not reported */
+  plugin->functions.page_get_text = NULL;
+  zathura_plugin_update_capabilities(plugin);
+  fail_unless(zathura_plugin_get_capabilities(plugin, &capabilities) == ZATHURA_ERROR_OK);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_TEXT) == 0);
+  fail_unless((capabilities & ZATHURA_PLUGIN_CAPABILITY_RENDER) != 0);
+} END_TEST
+
 START_TEST(test_plugin_set_register_function) {
   zathura_plugin_register_function_t function = (zathura_plugin_register_function_t) 0x1;
 
@@ -198,6 +252,57 @@ START_TEST(test_plugin_open_document) {
   fail_unless(zathura_plugin_open_document(plugin, &document, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED);
 } END_TEST
 
+START_TEST(test_plugin_open_document_from_data) {
+  zathura_document_t* document;
+  char* path = NULL;
+  const char* data = "%PDF-1.7\n";
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_open_document_from_data(NULL,   &document, data, strlen(data), NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_open_document_from_data(plugin, NULL,      data, strlen(data), NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_open_document_from_data(plugin, &document, NULL, strlen(data), NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_open_document_from_data(plugin, &document, data, 0,            NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_open_document_from_data(plugin, &document, "garbage", 7, NULL) == ZATHURA_ERROR_UNKNOWN);
+  fail_unless(document == NULL);
+  fail_unless(zathura_plugin_open_document_from_data(plugin, &document, data, strlen(data), "password") == ZATHURA_ERROR_OK);
+  fail_unless(document != NULL);
+  fail_unless(zathura_document_get_path(document, &path) == ZATHURA_ERROR_OK);
+  fail_unless(path == NULL);
+
+  unsigned int number_of_pages = 0;
+  fail_unless(zathura_document_get_number_of_pages(document, &number_of_pages) == ZATHURA_ERROR_OK);
+  fail_unless(number_of_pages == 10);
+  fail_unless(zathura_document_free(document) == ZATHURA_ERROR_OK);
+
+  /* unset document_open_data function */
+  plugin->functions.document_open_data = NULL;
+  fail_unless(zathura_plugin_open_document_from_data(plugin, &document, data, strlen(data), NULL) == ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED);
+} END_TEST
+
+START_TEST(test_plugin_open_document_from_fd) {
+  zathura_document_t* document;
+
+  const int fd = open(TEST_FILE_PATH, O_RDONLY);
+  fail_unless(fd != -1);
+
+  /* invalid parameter */
+  fail_unless(zathura_plugin_open_document_from_fd(NULL,   &document, fd, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_open_document_from_fd(plugin, NULL,      fd, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_plugin_open_document_from_fd(plugin, &document, -1, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid parameter */
+  fail_unless(zathura_plugin_open_document_from_fd(plugin, &document, fd, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(document != NULL);
+  fail_unless(zathura_document_free(document) == ZATHURA_ERROR_OK);
+
+  /* unset document_open_fd function */
+  plugin->functions.document_open_fd = NULL;
+  fail_unless(zathura_plugin_open_document_from_fd(plugin, &document, fd, NULL) == ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED);
+
+  close(fd);
+} END_TEST
 
 Suite*
 create_suite(void)
@@ -211,10 +316,15 @@ create_suite(void)
   tcase_add_test(tcase, test_plugin_get_name);
   tcase_add_test(tcase, test_plugin_get_path);
   tcase_add_test(tcase, test_plugin_get_version);
+  tcase_add_test(tcase, test_plugin_set_flags);
+  tcase_add_test(tcase, test_plugin_get_flags);
+  tcase_add_test(tcase, test_plugin_get_capabilities);
   tcase_add_test(tcase, test_plugin_set_register_function);
   tcase_add_test(tcase, test_plugin_get_functions);
   tcase_add_test(tcase, test_plugin_add_mime_type);
   tcase_add_test(tcase, test_plugin_open_document);
+  tcase_add_test(tcase, test_plugin_open_document_from_data);
+  tcase_add_test(tcase, test_plugin_open_document_from_fd);
   suite_add_tcase(suite, tcase);
 
   return suite;
@@ -1,5 +1,7 @@
 /* See LICENSE file for license and copyright information */
 
+#define _POSIX_C_SOURCE 200809L
+
 #if HAVE_CAIRO
 #include <cairo.h>
 #endif
@@ -7,31 +9,43 @@
 #include <libzathura/plugin-api.h>
 #include <libzathura/macros.h>
 
+#include <glib.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 /* forward declarations */
 void register_functions(zathura_plugin_functions_t* functions);
 zathura_error_t document_open(zathura_document_t* document);
+zathura_error_t document_open_data(zathura_document_t* document, const void* data, size_t length);
+zathura_error_t document_open_fd(zathura_document_t* document, int fd);
 zathura_error_t document_free(zathura_document_t* document);
 zathura_error_t document_save_as(zathura_document_t* document, const char* path);
 zathura_error_t document_get_outline(zathura_document_t* document, zathura_node_t** outline);
 zathura_error_t document_get_attachments(zathura_document_t* document, zathura_list_t** attachments);
 zathura_error_t document_get_metadata(zathura_document_t* document, zathura_list_t** metadata);
+zathura_error_t document_get_page_geometry(zathura_document_t* document, zathura_page_geometry_t* geometry);
 zathura_error_t page_init(zathura_page_t* page);
 zathura_error_t page_clear(zathura_page_t* page);
 zathura_error_t page_search_text(zathura_page_t* page, const char* text, zathura_search_flag_t flags, zathura_list_t** results);
 zathura_error_t page_get_text(zathura_page_t* page, char** text);
 zathura_error_t page_get_selected_text(zathura_page_t* page, char** text, zathura_rectangle_t rectangle);
+zathura_error_t page_get_glyphs(zathura_page_t* page, zathura_glyph_t** glyphs, size_t* number_of_glyphs);
 zathura_error_t page_get_links(zathura_page_t* page, zathura_list_t** links);
 zathura_error_t page_get_form_fields(zathura_page_t* page, zathura_list_t** form_fields);
 zathura_error_t page_get_images(zathura_page_t* page, zathura_list_t** images);
 zathura_error_t page_get_annotations(zathura_page_t* page, zathura_list_t** annotations);
 zathura_error_t page_render(zathura_page_t* page, zathura_image_buffer_t** buffer, double scale, int rotation, int flags);
+zathura_error_t page_render_job(zathura_page_t* page, zathura_image_buffer_t** buffer, double scale, int rotation, int flags, zathura_render_job_t* job);
+zathura_error_t page_render_into(zathura_page_t* page, zathura_image_buffer_t* buffer, double scale, int rotation, int flags);
+zathura_error_t page_render_region(zathura_page_t* page, zathura_image_buffer_t** buffer, double scale, int rotation, int flags, unsigned int x, unsigned int y, unsigned int width, unsigned int height);
 #ifdef HAVE_CAIRO
 zathura_error_t page_render_cairo(zathura_page_t* page, cairo_t* cairo, double scale, int rotation, int flags);
 #endif
 zathura_error_t form_field_save(zathura_form_field_t* form_field);
 zathura_error_t annotation_render(zathura_annotation_t* annotation, zathura_image_buffer_t** buffer, double scale);
+zathura_error_t annotation_render_into(zathura_annotation_t* annotation, zathura_image_buffer_t* buffer, double scale, int x, int y);
 #ifdef HAVE_CAIRO
 zathura_error_t annotation_render_cairo(zathura_annotation_t* annotation, cairo_t* cairo, double scale);
 #endif
@@ -45,6 +59,8 @@ ZATHURA_PLUGIN_REGISTER(
   register_functions,
   ZATHURA_PLUGIN_MIMETYPES({
     "libzathura/test-plugin",
+    "libzathura-test/*",
+    "application/pdf",
   })
 )
 
@@ -53,22 +69,29 @@ void
 register_functions(zathura_plugin_functions_t* functions)
 {
   functions->document_open = document_open;
+  functions->document_open_data = document_open_data;
+  functions->document_open_fd = document_open_fd;
   functions->document_free = document_free;
   functions->document_save_as = document_save_as;
   functions->document_get_outline = document_get_outline;
   functions->document_get_attachments = document_get_attachments;
   functions->document_get_metadata = document_get_metadata;
+  functions->document_get_page_geometry = document_get_page_geometry;
 
   functions->page_init = page_init;
   functions->page_clear = page_clear;
   functions->page_search_text = page_search_text;
   functions->page_get_text = page_get_text;
   functions->page_get_selected_text = page_get_selected_text;
+  functions->page_get_glyphs = page_get_glyphs;
   functions->page_get_links = page_get_links;
   functions->page_get_form_fields = page_get_form_fields;
   functions->page_get_images = page_get_images;
   functions->page_get_annotations = page_get_annotations;
   functions->page_render = page_render;
+  functions->page_render_job = page_render_job;
+  functions->page_render_into = page_render_into;
+  functions->page_render_region = page_render_region;
 #ifdef HAVE_CAIRO
   functions->page_render_cairo = page_render_cairo;
 #endif
@@ -76,6 +99,7 @@ register_functions(zathura_plugin_functions_t* functions)
   functions->form_field_save = form_field_save;
 
   functions->annotation_render = annotation_render;
+  functions->annotation_render_into = annotation_render_into;
 #ifdef HAVE_CAIRO
   functions->annotation_render_cairo = annotation_render_cairo;
 #endif
@@ -113,6 +137,36 @@ document_open(zathura_document_t* document)
   return ZATHURA_ERROR_OK;
 }
 
+zathura_error_t
+document_open_data(zathura_document_t* document, const void* data, size_t
+    length)
+{
+  if (document == NULL || data == NULL) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  if (length < 5 || memcmp(data, "%PDF-", 5) != 0) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  return document_open(document);
+}
+
+zathura_error_t
+document_open_fd(zathura_document_t* document, int fd)
+{
+  if (document == NULL || fd < 0) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
+  char header[5];
+  if (pread(fd, header, sizeof(header), 0) != sizeof(header)) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  return document_open_data(document, header, sizeof(header));
+}
+
 zathura_error_t
 document_free(zathura_document_t* UNUSED(document))
 {
@@ -176,15 +230,77 @@ document_get_metadata(zathura_document_t* UNUSED(document), zathura_list_t**
 }
 
 zathura_error_t
-page_search_text(zathura_page_t* UNUSED(page), const char* UNUSED(text),
-    zathura_search_flag_t UNUSED(flags), zathura_list_t** UNUSED(results))
+document_get_page_geometry(zathura_document_t* UNUSED(document),
+    zathura_page_geometry_t* geometry)
+{
+  for (unsigned int i = 0; i < geometry->number_of_pages; i++) {
+    geometry->width[i]  = 600;
+    geometry->height[i] = 800;
+    geometry->crop_box[i] = (zathura_rectangle_t) { {0, 0}, {600, 800} };
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
+zathura_error_t
+page_search_text(zathura_page_t* page, const char* text,
+    zathura_search_flag_t UNUSED(flags), zathura_list_t** results)
 {
+  *results = NULL;
+
+  /* "match" is found index % 3 times on a page, "hidden" is found once on
+   * every page but is not part of the page text */
+  unsigned int index = 0;
+  if (zathura_page_get_index(page, &index) != ZATHURA_ERROR_OK) {
+    return ZATHURA_ERROR_OK;
+  }
+
+  unsigned int number_of_results = 0;
+  if (strcmp(text, "match") == 0) {
+    number_of_results = index % 3;
+  } else if (strcmp(text, "hidden") == 0) {
+    number_of_results = 1;
+  }
+
+  for (unsigned int i = 0; i < number_of_results; i++) {
+    zathura_rectangle_t* rectangle = calloc(1, sizeof(*rectangle));
+    if (rectangle == NULL) {
+      zathura_list_free_full(*results, free);
+      *results = NULL;
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+
+    *rectangle = (zathura_rectangle_t) { {index, i}, {index + 1, i + 1} };
+    *results = zathura_list_append(*results, rectangle);
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
-page_get_text(zathura_page_t* UNUSED(page), char** UNUSED(text))
+page_get_text(zathura_page_t* page, char** text)
 {
+  unsigned int index = 0;
+  if (zathura_page_get_index(page, &index) != ZATHURA_ERROR_OK) {
+    return ZATHURA_ERROR_UNKNOWN;
+  }
+
+  /* "Page <index>" followed by as many "Match" as page_search_text finds,
+   * the last page has some text for matching in the library */
+  *text = calloc(64, sizeof(char));
+  if (*text == NULL) {
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  int length = snprintf(*text, 64, "Page %u", index);
+  for (unsigned int i = 0; i < index % 3; i++) {
+    length += snprintf(*text + length, 64 - length, "\n  Match");
+  }
+
+  if (index == 9) {
+    snprintf(*text + length, 64 - length, "\nCafé au lait\nStraße, naïve STRASSE");
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -196,8 +312,83 @@ page_get_selected_text(zathura_page_t* UNUSED(page), char** UNUSED(text), zathur
 }
 
 zathura_error_t
-page_get_links(zathura_page_t* UNUSED(page), zathura_list_t** UNUSED(links))
+page_get_glyphs(zathura_page_t* page, zathura_glyph_t** glyphs, size_t*
+    number_of_glyphs)
+{
+  char* text = NULL;
+  zathura_error_t error = page_get_text(page, &text);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  *glyphs = calloc(strlen(text), sizeof(zathura_glyph_t));
+  if (*glyphs == NULL) {
+    free(text);
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  /* Characters are 10x20 large and every line break starts a new line */
+  unsigned int line = 0;
+  unsigned int column = 0;
+  *number_of_glyphs = 0;
+
+  for (const char* c = text; *c != '\0'; c = g_utf8_next_char(c)) {
+    if (*c == '\n') {
+      line++;
+      column = 0;
+      continue;
+    }
+
+    (*glyphs)[(*number_of_glyphs)++] = (zathura_glyph_t) {
+      g_utf8_get_char(c),
+      { { column * 10, line * 20 }, { (column + 1) * 10, (line + 1) * 20 } },
+      0, line, 0
+    };
+    column++;
+  }
+
+  free(text);
+
+  return ZATHURA_ERROR_OK;
+}
+
+static zathura_link_mapping_t*
+link_mapping_new(float x1, float y1, float x2, float y2)
+{
+  zathura_link_mapping_t* mapping = calloc(1, sizeof(zathura_link_mapping_t));
+  if (mapping == NULL) {
+    return NULL;
+  }
+
+  if (zathura_action_new(&(mapping->action), ZATHURA_ACTION_GOTO) != ZATHURA_ERROR_OK) {
+    free(mapping);
+    return NULL;
+  }
+
+  mapping->position = (zathura_rectangle_t) { { x1, y1 }, { x2, y2 } };
+
+  return mapping;
+}
+
+zathura_error_t
+page_get_links(zathura_page_t* UNUSED(page), zathura_list_t** links)
 {
+  /* A grid of 10x10 links of 60x80 followed by one link covering the page */
+  zathura_list_t* list = NULL;
+  for (unsigned int i = 0; i <= 100; i++) {
+    zathura_link_mapping_t* mapping = (i < 100) ?
+      link_mapping_new((i % 10) * 60, (i / 10) * 80, (i % 10) * 60 + 60, (i / 10) * 80 + 80) :
+      link_mapping_new(600, 800, 0, 0);
+    if (mapping == NULL) {
+      zathura_list_free(list);
+      return ZATHURA_ERROR_OUT_OF_MEMORY;
+    }
+
+    list = zathura_list_prepend(list, mapping);
+  }
+
+  *links = zathura_list_reverse(list);
+
   return ZATHURA_ERROR_OK;
 }
 
@@ -214,20 +405,118 @@ page_get_images(zathura_page_t* UNUSED(page), zathura_list_t** UNUSED(images))
   return ZATHURA_ERROR_OK;
 }
 
+static zathura_annotation_mapping_t*
+annotation_mapping_new(zathura_page_t* page, zathura_rectangle_t position,
+    zathura_annotation_flag_t flags, float opacity)
+{
+  zathura_annotation_mapping_t* mapping = calloc(1, sizeof(zathura_annotation_mapping_t));
+  if (mapping == NULL) {
+    return NULL;
+  }
+
+  if (zathura_annotation_new(page, &(mapping->annotation), ZATHURA_ANNOTATION_SQUARE) != ZATHURA_ERROR_OK) {
+    free(mapping);
+    return NULL;
+  }
+
+  zathura_annotation_set_position(mapping->annotation, position);
+  zathura_annotation_set_flags(mapping->annotation, flags);
+  zathura_annotation_set_opacity(mapping->annotation, opacity);
+  mapping->position = position;
+
+  return mapping;
+}
+
 zathura_error_t
-page_get_annotations(zathura_page_t* UNUSED(page), zathura_list_t**
-    UNUSED(annotations))
+page_get_annotations(zathura_page_t* page, zathura_list_t** annotations)
 {
+  /* A half transparent square followed by a hidden one */
+  zathura_annotation_mapping_t* square = annotation_mapping_new(page,
+      (zathura_rectangle_t) { { 0, 0 }, { 10, 10 } }, ZATHURA_ANNOTATION_FLAG_UNDEFINED, 0.5);
+  zathura_annotation_mapping_t* hidden = annotation_mapping_new(page,
+      (zathura_rectangle_t) { { 20, 20 }, { 30, 30 } }, ZATHURA_ANNOTATION_FLAG_HIDDEN, 1.0);
+
+  if (square == NULL || hidden == NULL) {
+    if (square != NULL) {
+      zathura_annotation_free(square->annotation);
+      free(square);
+    }
+    if (hidden != NULL) {
+      zathura_annotation_free(hidden->annotation);
+      free(hidden);
+    }
+    return ZATHURA_ERROR_OUT_OF_MEMORY;
+  }
+
+  *annotations = zathura_list_append(NULL, square);
+  *annotations = zathura_list_append(*annotations, hidden);
+
   return ZATHURA_ERROR_OK;
 }
 
 zathura_error_t
-page_render(zathura_page_t* UNUSED(page), zathura_image_buffer_t** UNUSED(buffer),
-    double UNUSED(scale), int UNUSED(rotation), int UNUSED(flags))
+page_render(zathura_page_t* page, zathura_image_buffer_t** buffer,
+    double scale, int UNUSED(rotation), int UNUSED(flags))
+{
+  unsigned int width  = 0;
+  unsigned int height = 0;
+
+  zathura_page_get_width(page, &width);
+  zathura_page_get_height(page, &height);
+
+  return zathura_image_buffer_new(buffer, width * scale, height * scale);
+}
+
+zathura_error_t
+page_render_job(zathura_page_t* page, zathura_image_buffer_t** buffer,
+    double scale, int rotation, int flags, zathura_render_job_t* job)
+{
+  /* report a coarse preview first */
+  zathura_image_buffer_t* preview = NULL;
+  zathura_error_t error = page_render(page, &preview, scale / 4, rotation, flags);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  error = zathura_render_job_report_progress(job, preview, ZATHURA_RENDER_QUALITY_PREVIEW);
+  zathura_image_buffer_free(preview);
+  if (error != ZATHURA_ERROR_OK) {
+    return error;
+  }
+
+  return page_render(page, buffer, scale, rotation, flags);
+}
+
+zathura_error_t
+page_render_into(zathura_page_t* page, zathura_image_buffer_t* buffer,
+    double scale, int UNUSED(rotation), int UNUSED(flags))
 {
+  unsigned int width         = 0;
+  unsigned int height        = 0;
+  unsigned int buffer_width  = 0;
+  unsigned int buffer_height = 0;
+
+  zathura_page_get_width(page, &width);
+  zathura_page_get_height(page, &height);
+  zathura_image_buffer_get_width(buffer, &buffer_width);
+  zathura_image_buffer_get_height(buffer, &buffer_height);
+
+  if (buffer_width < width * scale || buffer_height < height * scale) {
+    return ZATHURA_ERROR_INVALID_ARGUMENTS;
+  }
+
   return ZATHURA_ERROR_OK;
 }
 
+zathura_error_t
+page_render_region(zathura_page_t* UNUSED(page), zathura_image_buffer_t**
+    buffer, double UNUSED(scale), int UNUSED(rotation), int UNUSED(flags),
+    unsigned int UNUSED(x), unsigned int UNUSED(y), unsigned int width,
+    unsigned int height)
+{
+  return zathura_image_buffer_new(buffer, width, height);
+}
+
 #ifdef HAVE_CAIRO
 zathura_error_t
 page_render_cairo(zathura_page_t* UNUSED(page), cairo_t* UNUSED(cairo), double
@@ -250,6 +539,41 @@ annotation_render(zathura_annotation_t* UNUSED(annotation), zathura_image_buffer
   return ZATHURA_ERROR_OK;
 }
 
+zathura_error_t
+annotation_render_into(zathura_annotation_t* annotation, zathura_image_buffer_t*
+    buffer, double scale, int x, int y)
+{
+  zathura_rectangle_t position;
+  unsigned char* data;
+  unsigned int width;
+  unsigned int height;
+  unsigned int rowstride;
+
+  zathura_annotation_get_position(annotation, &position);
+  zathura_image_buffer_get_data(buffer, &data);
+  zathura_image_buffer_get_width(buffer, &width);
+  zathura_image_buffer_get_height(buffer, &height);
+  zathura_image_buffer_get_rowstride(buffer, &rowstride);
+
+  /* Fill the clipped area of the annotation with opaque red */
+  const int left   = MAX(x, 0);
+  const int top    = MAX(y, 0);
+  const int right  = MIN(x + (int) ((position.p2.x - position.p1.x) * scale), (int) width);
+  const int bottom = MIN(y + (int) ((position.p2.y - position.p1.y) * scale), (int) height);
+
+  for (int row = top; row < bottom; row++) {
+    for (int column = left; column < right; column++) {
+      unsigned char* pixel = data + row * rowstride + 4 * column;
+      pixel[0] = 0x00;
+      pixel[1] = 0x00;
+      pixel[2] = 0xFF;
+      pixel[3] = 0xFF;
+    }
+  }
+
+  return ZATHURA_ERROR_OK;
+}
+
 #ifdef HAVE_CAIRO
 zathura_error_t
 annotation_render_cairo(zathura_annotation_t* UNUSED(annotation), cairo_t* UNUSED(cairo), double
@@ -0,0 +1,184 @@
+/* See LICENSE file for license and copyright information */
+
+#include <check.h>
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdbool.h>
+
+#include <libzathura/prefetcher.h>
+#include <libzathura/plugin-manager.h>
+#include <libzathura/plugin-api.h>
+
+#include "tests.h"
+#include "utils.h"
+
+zathura_document_t* document;
+zathura_plugin_manager_t* plugin_manager;
+zathura_prefetcher_t* prefetcher;
+
+static void setup(void) {
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(plugin_manager != NULL);
+  fail_unless(zathura_plugin_manager_load(plugin_manager, get_plugin_path()) == ZATHURA_ERROR_OK);
+
+  zathura_plugin_t* plugin = NULL;
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(plugin != NULL);
+
+  fail_unless(zathura_plugin_open_document(plugin, &document, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(document != NULL);
+
+  fail_unless(zathura_prefetcher_new(&prefetcher, document, 2) == ZATHURA_ERROR_OK);
+  fail_unless(prefetcher != NULL);
+}
+
+static void teardown(void) {
+  fail_unless(zathura_prefetcher_free(prefetcher) == ZATHURA_ERROR_OK);
+  prefetcher = NULL;
+
+  fail_unless(zathura_document_free(document) == ZATHURA_ERROR_OK);
+  document = NULL;
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+  plugin_manager = NULL;
+}
+
+static bool
+page_is_cached(unsigned int index, double scale)
+{
+  zathura_render_cache_statistics_t before;
+  zathura_render_cache_statistics_t after;
+  zathura_page_t* page = NULL;
+  zathura_image_buffer_t* buffer = NULL;
+
+  fail_unless(zathura_document_get_render_cache_statistics(document, &before) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_page(document, index, &page) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_render(page, &buffer, scale, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_get_render_cache_statistics(document, &after) == ZATHURA_ERROR_OK);
+
+  return after.hits > before.hits;
+}
+
+START_TEST(test_prefetcher_new) {
+  zathura_prefetcher_t* prefetcher;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_prefetcher_new(NULL, document, 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_prefetcher_new(&prefetcher, NULL, 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_prefetcher_new(&prefetcher, document, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_prefetcher_new(&prefetcher, document, 1) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_free(prefetcher) == ZATHURA_ERROR_OK);
+
+  /* fault injection */
+#ifdef WITH_LIBFIU
+  fiu_enable("libc/mm/calloc", 1, NULL, 0);
+  fail_unless(zathura_prefetcher_new(&prefetcher, document, 1) == ZATHURA_ERROR_OUT_OF_MEMORY);
+  fiu_disable("libc/mm/calloc");
+#endif
+} END_TEST
+
+START_TEST(test_prefetcher_free) {
+  /* basic invalid arguments */
+  fail_unless(zathura_prefetcher_free(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+} END_TEST
+
+START_TEST(test_prefetcher_set_distance) {
+  /* basic invalid arguments */
+  fail_unless(zathura_prefetcher_set_distance(NULL, 1) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_prefetcher_set_distance(prefetcher, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 4, 4, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+  fail_unless(page_is_cached(5, 1.0) == false);
+} END_TEST
+
+START_TEST(test_prefetcher_set_viewport) {
+  /* basic invalid arguments */
+  fail_unless(zathura_prefetcher_set_viewport(NULL, 0, 0, 1.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 1, 0, 1.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 0, 0, 0.0, 0, 0) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 0, 10, 1.0, 0, 0) == ZATHURA_ERROR_DOCUMENT_INVALID_INDEX);
+
+  /* neighbours are rendered, visible pages are left to the caller */
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 4, 4, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+  fail_unless(page_is_cached(2, 1.0) == true);
+  fail_unless(page_is_cached(3, 1.0) == true);
+  fail_unless(page_is_cached(5, 1.0) == true);
+  fail_unless(page_is_cached(6, 1.0) == true);
+  fail_unless(page_is_cached(7, 1.0) == false);
+  fail_unless(page_is_cached(1, 1.0) == false);
+
+  /* pages are rendered with the scale of the viewport */
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 8, 9, 2.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+  fail_unless(page_is_cached(7, 2.0) == true);
+  fail_unless(page_is_cached(6, 2.0) == true);
+} END_TEST
+
+START_TEST(test_prefetcher_set_viewport_layout) {
+  fail_unless(zathura_document_set_page_layout(document, ZATHURA_PAGE_LAYOUT_TWO_PAGE_LEFT) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_set_distance(prefetcher, 1) == ZATHURA_ERROR_OK);
+
+  /* a pair of pages is prefetched in each direction */
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 4, 5, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+  fail_unless(page_is_cached(2, 1.0) == true);
+  fail_unless(page_is_cached(3, 1.0) == true);
+  fail_unless(page_is_cached(6, 1.0) == true);
+  fail_unless(page_is_cached(7, 1.0) == true);
+} END_TEST
+
+START_TEST(test_prefetcher_set_viewport_presentation) {
+  fail_unless(zathura_document_set_page_mode(document, ZATHURA_PAGE_MODE_FULL_SCREEN) == ZATHURA_ERROR_OK);
+
+  /* only the previous slide is kept behind the current one */
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 4, 4, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+  fail_unless(page_is_cached(3, 1.0) == true);
+  fail_unless(page_is_cached(5, 1.0) == true);
+  fail_unless(page_is_cached(6, 1.0) == true);
+  fail_unless(page_is_cached(2, 1.0) == false);
+} END_TEST
+
+START_TEST(test_prefetcher_wait) {
+  /* basic invalid arguments */
+  fail_unless(zathura_prefetcher_wait(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+
+  /* moving the viewport drops pending pages */
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 0, 0, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_set_viewport(prefetcher, 9, 9, 1.0, 0, 0) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_prefetcher_wait(prefetcher) == ZATHURA_ERROR_OK);
+  fail_unless(page_is_cached(8, 1.0) == true);
+} END_TEST
+
+Suite*
+create_suite(void)
+{
+  TCase* tcase = NULL;
+  Suite* suite = suite_create("prefetcher");
+
+  tcase = tcase_create("basic");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_prefetcher_new);
+  tcase_add_test(tcase, test_prefetcher_free);
+  tcase_add_test(tcase, test_prefetcher_set_distance);
+  tcase_add_test(tcase, test_prefetcher_wait);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("viewport");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_prefetcher_set_viewport);
+  tcase_add_test(tcase, test_prefetcher_set_viewport_layout);
+  tcase_add_test(tcase, test_prefetcher_set_viewport_presentation);
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
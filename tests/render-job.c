@@ -0,0 +1,128 @@
+/* See LICENSE file for license and copyright information */
+
+#include <check.h>
+#include <fiu.h>
+#include <fiu-control.h>
+
+#include <libzathura/render-job.h>
+#include <libzathura/plugin-api.h>
+#include <libzathura/macros.h>
+
+#include "tests.h"
+
+zathura_render_job_t* job;
+
+static void setup(void) {
+  fail_unless(zathura_render_job_new(&job) == ZATHURA_ERROR_OK);
+  fail_unless(job != NULL);
+}
+
+static void teardown(void) {
+  fail_unless(zathura_render_job_free(job) == ZATHURA_ERROR_OK);
+  job = NULL;
+}
+
+static void
+cb_progress(zathura_render_job_t* UNUSED(job), zathura_image_buffer_t*
+    UNUSED(buffer), zathura_render_quality_t quality, void* data)
+{
+  zathura_render_quality_t* reported_quality = data;
+  *reported_quality = quality;
+}
+
+START_TEST(test_render_job_new) {
+  zathura_render_job_t* job;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_render_job_new(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_render_job_new(&job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_free(job) == ZATHURA_ERROR_OK);
+
+  /* fault injection */
+#ifdef WITH_LIBFIU
+  fiu_enable("libc/mm/calloc", 1, NULL, 0);
+  fail_unless(zathura_render_job_new(&job) == ZATHURA_ERROR_OUT_OF_MEMORY);
+  fiu_disable("libc/mm/calloc");
+#endif
+} END_TEST
+
+START_TEST(test_render_job_free) {
+  /* basic invalid arguments */
+  fail_unless(zathura_render_job_free(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+} END_TEST
+
+START_TEST(test_render_job_set_progress_callback) {
+  /* basic invalid arguments */
+  fail_unless(zathura_render_job_set_progress_callback(NULL, cb_progress, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_render_job_set_progress_callback(job, cb_progress, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_set_progress_callback(job, NULL, NULL) == ZATHURA_ERROR_OK);
+} END_TEST
+
+START_TEST(test_render_job_cancel) {
+  bool cancelled = true;
+
+  /* basic invalid arguments */
+  fail_unless(zathura_render_job_cancel(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_render_job_is_cancelled(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_render_job_is_cancelled(job, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_render_job_is_cancelled(NULL, &cancelled) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_render_job_is_cancelled(job, &cancelled) == ZATHURA_ERROR_OK);
+  fail_unless(cancelled == false);
+
+  fail_unless(zathura_render_job_cancel(job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_is_cancelled(job, &cancelled) == ZATHURA_ERROR_OK);
+  fail_unless(cancelled == true);
+} END_TEST
+
+START_TEST(test_render_job_report_progress) {
+  zathura_image_buffer_t* buffer;
+  zathura_render_quality_t quality = ZATHURA_RENDER_QUALITY_FINAL;
+
+  fail_unless(zathura_image_buffer_new(&buffer, 10, 10) == ZATHURA_ERROR_OK);
+
+  /* basic invalid arguments */
+  fail_unless(zathura_render_job_report_progress(NULL, NULL, ZATHURA_RENDER_QUALITY_PREVIEW)   == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_render_job_report_progress(job, NULL, ZATHURA_RENDER_QUALITY_PREVIEW)    == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_render_job_report_progress(NULL, buffer, ZATHURA_RENDER_QUALITY_PREVIEW) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_render_job_report_progress(job, buffer, ZATHURA_RENDER_QUALITY_PREVIEW) == ZATHURA_ERROR_OK);
+
+  fail_unless(zathura_render_job_set_progress_callback(job, cb_progress, &quality) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_report_progress(job, buffer, ZATHURA_RENDER_QUALITY_PREVIEW) == ZATHURA_ERROR_OK);
+  fail_unless(quality == ZATHURA_RENDER_QUALITY_PREVIEW);
+
+  /* cancelled job */
+  fail_unless(zathura_render_job_cancel(job) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_render_job_report_progress(job, buffer, ZATHURA_RENDER_QUALITY_FINAL) == ZATHURA_ERROR_CANCELLED);
+  fail_unless(quality == ZATHURA_RENDER_QUALITY_PREVIEW);
+
+  fail_unless(zathura_image_buffer_free(buffer) == ZATHURA_ERROR_OK);
+} END_TEST
+
+Suite*
+create_suite(void)
+{
+  TCase* tcase = NULL;
+  Suite* suite = suite_create("render-job");
+
+  tcase = tcase_create("basic");
+  tcase_add_test(tcase, test_render_job_new);
+  tcase_add_test(tcase, test_render_job_free);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("job");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_render_job_set_progress_callback);
+  tcase_add_test(tcase, test_render_job_cancel);
+  tcase_add_test(tcase, test_render_job_report_progress);
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
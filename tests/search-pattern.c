@@ -0,0 +1,251 @@
+/* See LICENSE file for license and copyright information */
+
+#include <check.h>
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <libzathura/search-pattern.h>
+#include <libzathura/plugin-manager.h>
+#include <libzathura/plugin-api.h>
+
+#include "tests.h"
+#include "utils.h"
+
+zathura_document_t* document;
+zathura_plugin_manager_t* plugin_manager;
+zathura_page_t* page;
+
+/*
+ * The last page of the test document reads
+ *
+ *   Page 9                  glyphs  0 to  5
+ *   Café au lait            glyphs  6 to 17
+ *   Straße, naïve STRASSE   glyphs 18 to 38
+ */
+static void setup(void) {
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(plugin_manager != NULL);
+  fail_unless(zathura_plugin_manager_load(plugin_manager, get_plugin_path()) == ZATHURA_ERROR_OK);
+
+  zathura_plugin_t* plugin = NULL;
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(plugin != NULL);
+
+  fail_unless(zathura_plugin_open_document(plugin, &document, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(document != NULL);
+
+  fail_unless(zathura_document_get_page(document, 9, &page) == ZATHURA_ERROR_OK);
+  fail_unless(page != NULL);
+}
+
+static void teardown(void) {
+  fail_unless(zathura_document_free(document) == ZATHURA_ERROR_OK);
+  document = NULL;
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+  plugin_manager = NULL;
+}
+
+/* Searches the page and returns the matches */
+static zathura_list_t*
+search(const char* const* terms, size_t number_of_terms, zathura_search_flag_t flags)
+{
+  zathura_search_pattern_t* pattern = NULL;
+  zathura_list_t* matches = NULL;
+
+  fail_unless(zathura_search_pattern_new(&pattern, terms, number_of_terms, flags) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_search_pattern(page, pattern, &matches) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_search_pattern_free(pattern) == ZATHURA_ERROR_OK);
+
+  return matches;
+}
+
+static bool
+match_equals(zathura_list_t* matches, unsigned int n, size_t term, size_t first_glyph, size_t last_glyph)
+{
+  zathura_search_match_t* match = zathura_list_nth_data(matches, n);
+
+  return match != NULL && match->term == term && match->first_glyph == first_glyph &&
+    match->last_glyph == last_glyph;
+}
+
+START_TEST(test_search_pattern_new) {
+  zathura_search_pattern_t* pattern = NULL;
+  const char* terms[] = { "page", "" };
+  const char* regex[] = { "(" };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_search_pattern_new(NULL, terms, 1, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_search_pattern_new(&pattern, NULL, 1, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_search_pattern_new(&pattern, terms, 0, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_search_pattern_new(&pattern, terms, 2, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_search_pattern_new(&pattern, regex, 1, ZATHURA_SEARCH_REGEX) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* valid arguments */
+  fail_unless(zathura_search_pattern_new(&pattern, terms, 1, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_OK);
+  fail_unless(pattern != NULL);
+  fail_unless(zathura_search_pattern_free(pattern) == ZATHURA_ERROR_OK);
+
+  /* fault injection */
+#ifdef WITH_LIBFIU
+  fiu_enable("libc/mm/calloc", 1, NULL, 0);
+  fail_unless(zathura_search_pattern_new(&pattern, terms, 1, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_OUT_OF_MEMORY);
+  fiu_disable("libc/mm/calloc");
+#endif
+} END_TEST
+
+START_TEST(test_search_pattern_free) {
+  /* basic invalid arguments */
+  fail_unless(zathura_search_pattern_free(NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+} END_TEST
+
+START_TEST(test_page_search_pattern) {
+  zathura_search_pattern_t* pattern = NULL;
+  zathura_list_t* matches = NULL;
+  const char* terms[] = { "page", "lait", "strasse", "xyz" };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_search_pattern_new(&pattern, terms, 4, ZATHURA_SEARCH_DEFAULT) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_page_search_pattern(NULL, pattern, &matches) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_search_pattern(page, NULL, &matches) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_page_search_pattern(page, pattern, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_search_pattern_free(pattern) == ZATHURA_ERROR_OK);
+
+  /* all terms are found in one pass, case is folded */
+  matches = search(terms, 4, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 4);
+  fail_unless(match_equals(matches, 0, 0, 0, 3));
+  fail_unless(match_equals(matches, 1, 1, 14, 17));
+  fail_unless(match_equals(matches, 2, 2, 18, 23));
+  fail_unless(match_equals(matches, 3, 2, 32, 38));
+  zathura_list_free_full(matches, free);
+
+  /* terms may span lines */
+  const char* spanning[] = { "lait stra" };
+  matches = search(spanning, 1, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 1);
+  fail_unless(match_equals(matches, 0, 0, 14, 21));
+  zathura_list_free_full(matches, free);
+
+  /* duplicate terms are reported once */
+  const char* duplicates[] = { "page", "page" };
+  matches = search(duplicates, 2, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 1);
+  fail_unless(match_equals(matches, 0, 0, 0, 3));
+  zathura_list_free_full(matches, free);
+} END_TEST
+
+START_TEST(test_page_search_pattern_overlapping) {
+  const char* terms[] = { "strasse", "asse", "ss" };
+
+  /* terms ending within other terms are found as well */
+  zathura_list_t* matches = search(terms, 3, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 6);
+  fail_unless(match_equals(matches, 0, 2, 22, 22));
+  fail_unless(match_equals(matches, 1, 0, 18, 23));
+  fail_unless(match_equals(matches, 2, 1, 21, 23));
+  fail_unless(match_equals(matches, 3, 2, 36, 37));
+  zathura_list_free_full(matches, free);
+} END_TEST
+
+START_TEST(test_page_search_pattern_flags) {
+  zathura_list_t* matches = NULL;
+
+  /* case sensitive */
+  const char* upper[] = { "STRASSE" };
+  matches = search(upper, 1, ZATHURA_SEARCH_CASE_SENSITIVE);
+  fail_unless(zathura_list_length(matches) == 1);
+  fail_unless(match_equals(matches, 0, 0, 32, 38));
+  zathura_list_free_full(matches, free);
+
+  /* whole words */
+  const char* prefix[] = { "stra" };
+  matches = search(prefix, 1, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 2);
+  zathura_list_free_full(matches, free);
+  matches = search(prefix, 1, ZATHURA_SEARCH_WHOLE_WORDS_ONLY);
+  fail_unless(zathura_list_length(matches) == 0);
+
+  /* diacritics */
+  const char* plain[] = { "cafe", "naive" };
+  matches = search(plain, 2, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 0);
+  matches = search(plain, 2, ZATHURA_SEARCH_IGNORE_DIACRITICS);
+  fail_unless(zathura_list_length(matches) == 2);
+  fail_unless(match_equals(matches, 0, 0, 6, 9));
+  fail_unless(match_equals(matches, 1, 1, 26, 30));
+  zathura_list_free_full(matches, free);
+
+  const char* accented[] = { "CAFÉ" };
+  matches = search(accented, 1, ZATHURA_SEARCH_DEFAULT);
+  fail_unless(zathura_list_length(matches) == 1);
+  zathura_list_free_full(matches, free);
+} END_TEST
+
+START_TEST(test_page_search_pattern_regex) {
+  zathura_list_t* matches = NULL;
+
+  const char* terms[] = { "na.ve", "^PAGE \\d" };
+  matches = search(terms, 2, ZATHURA_SEARCH_REGEX);
+  fail_unless(zathura_list_length(matches) == 2);
+  fail_unless(match_equals(matches, 0, 1, 0, 5));
+  fail_unless(match_equals(matches, 1, 0, 26, 30));
+  zathura_list_free_full(matches, free);
+
+  /* case sensitive */
+  matches = search(terms, 2, ZATHURA_SEARCH_REGEX | ZATHURA_SEARCH_CASE_SENSITIVE);
+  fail_unless(zathura_list_length(matches) == 1);
+  zathura_list_free_full(matches, free);
+
+  /* diacritics */
+  const char* accented[] = { "caf[e]", "naïve" };
+  matches = search(accented, 2, ZATHURA_SEARCH_REGEX | ZATHURA_SEARCH_IGNORE_DIACRITICS);
+  fail_unless(zathura_list_length(matches) == 2);
+  zathura_list_free_full(matches, free);
+} END_TEST
+
+START_TEST(test_page_search_text_library) {
+  zathura_list_t* results = NULL;
+
+  /* flags the plugin does not know are matched by the library */
+  fail_unless(zathura_page_search_text(page, "naive", ZATHURA_SEARCH_IGNORE_DIACRITICS, &results) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(results) == 1);
+
+  zathura_rectangle_t* rectangle = zathura_list_nth_data(results, 0);
+  fail_unless(rectangle->p1.x == 80 && rectangle->p1.y == 40);
+  fail_unless(rectangle->p2.x == 130 && rectangle->p2.y == 60);
+  zathura_list_free_full(results, free);
+
+  /* matches spanning lines are highlighted line by line */
+  fail_unless(zathura_page_search_text(page, "lait\\s+stra", ZATHURA_SEARCH_REGEX, &results) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_list_length(results) == 2);
+  zathura_list_free_full(results, free);
+
+  fail_unless(zathura_page_search_text(page, "(", ZATHURA_SEARCH_REGEX, &results) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+} END_TEST
+
+Suite*
+create_suite(void)
+{
+  TCase* tcase = NULL;
+  Suite* suite = suite_create("search-pattern");
+
+  tcase = tcase_create("basic");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_search_pattern_new);
+  tcase_add_test(tcase, test_search_pattern_free);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("matching");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_page_search_pattern);
+  tcase_add_test(tcase, test_page_search_pattern_overlapping);
+  tcase_add_test(tcase, test_page_search_pattern_flags);
+  tcase_add_test(tcase, test_page_search_pattern_regex);
+  tcase_add_test(tcase, test_page_search_text_library);
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
@@ -0,0 +1,272 @@
+/* See LICENSE file for license and copyright information */
+
+#define _XOPEN_SOURCE 500
+
+#include <check.h>
+#include <fiu.h>
+#include <fiu-control.h>
+#include <glib.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <libzathura/search.h>
+#include <libzathura/macros.h>
+#include <libzathura/plugin-manager.h>
+#include <libzathura/plugin-api.h>
+#include <libzathura/internal.h>
+
+#include "tests.h"
+#include "utils.h"
+
+zathura_document_t* document;
+zathura_plugin_manager_t* plugin_manager;
+
+typedef struct search_record_s {
+  unsigned int pages[10]; /**< Reported pages in order */
+  unsigned int number_of_pages; /**< Number of reported pages */
+  unsigned int number_of_results; /**< Number of reported results */
+  unsigned int stop_after; /**< Stop after this many pages, 0 to continue */
+} search_record_t;
+
+static void setup(void) {
+  fail_unless(zathura_plugin_manager_new(&plugin_manager) == ZATHURA_ERROR_OK);
+  fail_unless(plugin_manager != NULL);
+  fail_unless(zathura_plugin_manager_load(plugin_manager, get_plugin_path()) == ZATHURA_ERROR_OK);
+
+  zathura_plugin_t* plugin = NULL;
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(plugin != NULL);
+
+  fail_unless(zathura_plugin_open_document(plugin, &document, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(document != NULL);
+}
+
+static void teardown(void) {
+  fail_unless(zathura_document_free(document) == ZATHURA_ERROR_OK);
+  document = NULL;
+
+  fail_unless(zathura_plugin_manager_free(plugin_manager) == ZATHURA_ERROR_OK);
+  plugin_manager = NULL;
+}
+
+static bool
+cb_search(zathura_document_t* UNUSED(document), unsigned int page_index,
+    zathura_list_t* results, void* data)
+{
+  search_record_t* record = data;
+
+  fail_unless(results != NULL);
+  fail_unless(record->number_of_pages < 10);
+
+  record->pages[record->number_of_pages++] = page_index;
+  record->number_of_results += zathura_list_length(results);
+  zathura_list_free_full(results, free);
+
+  return record->stop_after == 0 || record->number_of_pages < record->stop_after;
+}
+
+START_TEST(test_document_search_text) {
+  search_record_t record = { 0 };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_document_search_text(NULL, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_search_text(document, NULL, ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_search_text(document, "", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, NULL, &record) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 10, 0, cb_search, &record) == ZATHURA_ERROR_DOCUMENT_INVALID_INDEX);
+
+  /* pages without results are skipped */
+  fail_unless(zathura_document_search_text(document, "abc", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 0);
+
+  /* results are reported in page order */
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 6);
+  fail_unless(record.number_of_results == 9);
+
+  const unsigned int expected_pages[] = { 1, 2, 4, 5, 7, 8 };
+  for (unsigned int i = 0; i < 6; i++) {
+    fail_unless(record.pages[i] == expected_pages[i]);
+  }
+} END_TEST
+
+START_TEST(test_document_search_text_first_page) {
+  search_record_t record = { 0 };
+
+  /* the search wraps around at the end of the document */
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 5, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 6);
+
+  const unsigned int expected_pages[] = { 5, 7, 8, 1, 2, 4 };
+  for (unsigned int i = 0; i < 6; i++) {
+    fail_unless(record.pages[i] == expected_pages[i]);
+  }
+} END_TEST
+
+START_TEST(test_document_search_text_max_results) {
+  search_record_t record = { 0 };
+
+  /* the results of the last page are cut off */
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 2, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 2);
+  fail_unless(record.number_of_results == 2);
+  fail_unless(record.pages[0] == 1);
+  fail_unless(record.pages[1] == 2);
+
+  /* find next */
+  memset(&record, 0, sizeof(record));
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 3, 1, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 1);
+  fail_unless(record.number_of_results == 1);
+  fail_unless(record.pages[0] == 4);
+} END_TEST
+
+START_TEST(test_document_search_text_stop) {
+  search_record_t record = { .stop_after = 2 };
+
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 2);
+  fail_unless(record.number_of_results == 3);
+} END_TEST
+
+START_TEST(test_document_build_text_index) {
+  search_record_t record = { 0 };
+
+  /* basic invalid arguments */
+  fail_unless(zathura_document_build_text_index(NULL, NULL) == ZATHURA_ERROR_INVALID_ARGUMENTS);
+
+  /* the plugin reports "hidden" on every page */
+  fail_unless(zathura_document_search_text(document, "hidden", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 10);
+
+  /* valid arguments */
+  fail_unless(zathura_document_build_text_index(document, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_build_text_index(document, NULL) == ZATHURA_ERROR_OK);
+
+  /* pages whose text lacks the search item are not searched */
+  memset(&record, 0, sizeof(record));
+  fail_unless(zathura_document_search_text(document, "hidden", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 0);
+
+  memset(&record, 0, sizeof(record));
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 6);
+  fail_unless(record.number_of_results == 9);
+} END_TEST
+
+START_TEST(test_document_build_text_index_cache) {
+  char* cache_directory = g_dir_make_tmp(NULL, NULL);
+  fail_unless(cache_directory != NULL);
+
+  fail_unless(zathura_document_build_text_index(document, cache_directory) == ZATHURA_ERROR_OK);
+
+  /* a single cache file has been written */
+  GDir* dir = g_dir_open(cache_directory, 0, NULL);
+  fail_unless(dir != NULL);
+  const char* name = g_dir_read_name(dir);
+  fail_unless(name != NULL);
+  fail_unless(g_str_has_suffix(name, ".textindex") == TRUE);
+  char* cache_file = g_build_filename(cache_directory, name, NULL);
+  fail_unless(g_dir_read_name(dir) == NULL);
+  g_dir_close(dir);
+
+  /* another instance of the document uses the cache file */
+  zathura_plugin_t* plugin = NULL;
+  zathura_document_t* other_document = NULL;
+  search_record_t record = { 0 };
+
+  fail_unless(zathura_plugin_manager_get_plugin(plugin_manager, &plugin, "libzathura/test-plugin") == ZATHURA_ERROR_OK);
+  fail_unless(zathura_plugin_open_document(plugin, &other_document, TEST_FILE_PATH, NULL) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_build_text_index(other_document, cache_directory) == ZATHURA_ERROR_OK);
+  fail_unless(zathura_document_search_text(other_document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 6);
+  fail_unless(zathura_document_free(other_document) == ZATHURA_ERROR_OK);
+
+  unlink(cache_file);
+  rmdir(cache_directory);
+  g_free(cache_file);
+  g_free(cache_directory);
+} END_TEST
+
+static zathura_error_t
+page_get_text_invalid(zathura_page_t* page, char** text)
+{
+  unsigned int index = 0;
+  zathura_page_get_index(page, &index);
+
+  *text = strdup((index == 0) ? "\xff\xfe" : "Page");
+
+  return (*text != NULL) ? ZATHURA_ERROR_OK : ZATHURA_ERROR_OUT_OF_MEMORY;
+}
+
+START_TEST(test_document_build_text_index_invalid_text) {
+  search_record_t record = { 0 };
+
+  document->plugin->functions.page_get_text = page_get_text_invalid;
+  fail_unless(zathura_document_build_text_index(document, NULL) == ZATHURA_ERROR_OK);
+
+  /* the page whose text is not valid UTF-8 is still searched */
+  fail_unless(zathura_document_search_text(document, "hidden", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 1);
+  fail_unless(record.pages[0] == 0);
+} END_TEST
+
+START_TEST(test_document_search_text_regex) {
+  search_record_t record = { 0 };
+
+  /* the plugin cannot match regular expressions, the library does */
+  fail_unless(zathura_document_search_text(document, "page [2-4]$", ZATHURA_SEARCH_REGEX, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 1);
+  fail_unless(record.pages[0] == 3);
+
+  memset(&record, 0, sizeof(record));
+  fail_unless(zathura_document_search_text(document, "page [2-4]", ZATHURA_SEARCH_REGEX, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 3);
+} END_TEST
+
+START_TEST(test_document_search_text_glyphs) {
+  search_record_t record = { 0 };
+
+  /* plugins without a search function are searched through their characters */
+  document->plugin->functions.page_search_text = NULL;
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 6);
+  fail_unless(record.number_of_results == 9);
+
+  /* only the plugin reports "hidden" */
+  memset(&record, 0, sizeof(record));
+  fail_unless(zathura_document_search_text(document, "hidden", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_OK);
+  fail_unless(record.number_of_pages == 0);
+
+  /* plugins that can do neither */
+  document->plugin->functions.page_get_glyphs = NULL;
+  fail_unless(zathura_document_search_text(document, "match", ZATHURA_SEARCH_DEFAULT, 0, 0, cb_search, &record) == ZATHURA_ERROR_PLUGIN_NOT_IMPLEMENTED);
+} END_TEST
+
+Suite*
+create_suite(void)
+{
+  TCase* tcase = NULL;
+  Suite* suite = suite_create("search");
+
+  tcase = tcase_create("basic");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_document_search_text);
+  tcase_add_test(tcase, test_document_search_text_first_page);
+  tcase_add_test(tcase, test_document_search_text_max_results);
+  tcase_add_test(tcase, test_document_search_text_stop);
+  tcase_add_test(tcase, test_document_search_text_regex);
+  tcase_add_test(tcase, test_document_search_text_glyphs);
+  suite_add_tcase(suite, tcase);
+
+  tcase = tcase_create("text-index");
+  tcase_add_checked_fixture(tcase, setup, teardown);
+  tcase_add_test(tcase, test_document_build_text_index);
+  tcase_add_test(tcase, test_document_build_text_index_cache);
+  tcase_add_test(tcase, test_document_build_text_index_invalid_text);
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}